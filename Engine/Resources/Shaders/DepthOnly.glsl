@@ -0,0 +1,22 @@
+#stage vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+
+uniform mat4 u_Transform;
+uniform mat4 u_ViewProjectionMatrix;
+
+// The shading pass tests against this depth with Equal, so the position has to match it exactly
+invariant gl_Position;
+
+void main()
+{
+    gl_Position = u_ViewProjectionMatrix * u_Transform * vec4(a_Position, 1.0);
+}
+
+#stage fragment
+#version 450 core
+
+void main()
+{
+}
\ No newline at end of file
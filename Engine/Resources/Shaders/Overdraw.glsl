@@ -0,0 +1,26 @@
+#stage vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+
+uniform mat4 u_Transform;
+uniform mat4 u_ViewProjectionMatrix;
+
+invariant gl_Position;
+
+void main()
+{
+    gl_Position = u_ViewProjectionMatrix * u_Transform * vec4(a_Position, 1.0);
+}
+
+#stage fragment
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+
+void main()
+{
+    // Blended additively, every shaded fragment adds one step.
+    // Red saturates after 8 fragments, green after 16 and blue after 32.
+    o_Color = vec4(1.0 / 8.0, 1.0 / 16.0, 1.0 / 32.0, 1.0);
+}
\ No newline at end of file
@@ -24,6 +24,9 @@ uniform mat4 u_Transform;
 uniform mat4 u_ViewProjectionMatrix;
 uniform mat4 u_ViewMatrix;
 
+// Has to match the depth prepass exactly
+invariant gl_Position;
+
 void main()
 {
     Output.WorldPosition = vec3(u_Transform * vec4(a_Position, 1.0));
@@ -82,6 +85,54 @@ uniform float u_AmbientMultiplier;
 
 uniform uint u_HasNormalMap;
 
+struct Light
+{
+    vec3 Position;
+    float Range;
+    vec3 Color;
+    float SpotScale;
+    vec3 Direction;
+    float SpotOffset;
+};
+
+// Have to match LightClusterGrid
+const uint ClusterTileCountX = 16;
+const uint ClusterTileCountY = 9;
+const uint ClusterSliceCount = 24;
+
+layout(std430, binding = 0) readonly buffer LightBuffer
+{
+    Light u_Lights[];
+};
+
+// Offset into the light index list and light count of every cluster
+layout(std430, binding = 1) readonly buffer ClusterBuffer
+{
+    uvec2 u_Clusters[];
+};
+
+layout(std430, binding = 2) readonly buffer LightIndexBuffer
+{
+    uint u_LightIndices[];
+};
+
+uniform vec2 u_ClusterTileSize;
+uniform float u_ClusterSliceScale;
+uniform float u_ClusterSliceBias;
+
+uniform uint u_LightHeatmap;
+
+// Has to match CascadedShadowMap
+const uint ShadowCascadeCount = 4;
+
+uniform sampler2DArrayShadow u_ShadowMap;
+uniform mat4 u_ShadowMatrices[ShadowCascadeCount];
+// View depth at which every cascade ends, and its texel size in world units
+uniform vec4 u_CascadeSplits;
+uniform vec4 u_CascadeTexelSizes;
+uniform uint u_ShadowsEnabled;
+uniform uint u_ShadowCascadeView;
+
 struct
 {
     vec3 AlbedoColor;
@@ -134,9 +185,8 @@ vec3 FresnelSchlick(vec3 F0, float cosTheta, float roughness)
     return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(1.0 - cosTheta, 5.0);
 }
 
-vec3 DirectionalLight(vec3 direction, vec3 color)
+vec3 EvaluateLight(vec3 Li, vec3 radiance)
 {
-    vec3 Li = -direction;
     vec3 Lh = normalize(Li + m_Params.ViewDirection);
 
     float cosLi = max(dot(m_Params.Normal, Li), 0.0);
@@ -152,7 +202,94 @@ vec3 DirectionalLight(vec3 direction, vec3 color)
     vec3 specularBRDF = (F * D * G) / max(Epsilon, 4.0 * cosLi * m_Params.NdotV);
     specularBRDF = clamp(specularBRDF, vec3(0.0), vec3(10.0));
 
-    return (diffuseBRDF + specularBRDF) * color * cosLi;
+    return (diffuseBRDF + specularBRDF) * radiance * cosLi;
+}
+
+vec3 DirectionalLight(vec3 direction, vec3 color)
+{
+    return EvaluateLight(-direction, color);
+}
+
+uint GetShadowCascade()
+{
+    for (uint i = 0; i < ShadowCascadeCount - 1; i++)
+    {
+        if (Input.ViewPosition.z < u_CascadeSplits[i])
+            return i;
+    }
+    return ShadowCascadeCount - 1;
+}
+
+// Fraction of the directional light reaching the fragment, filtered over 3x3 texels
+float DirectionalShadow(uint cascade, vec3 direction)
+{
+    if (u_ShadowsEnabled == 0 || Input.ViewPosition.z > u_CascadeSplits[ShadowCascadeCount - 1])
+        return 1.0;
+
+    // Offsets the position along the normal, more on surfaces facing away from the light
+    vec3 normal = normalize(Input.Normal);
+    float cosLi = clamp(dot(normal, -direction), 0.0, 1.0);
+    vec3 position = Input.WorldPosition + normal * u_CascadeTexelSizes[cascade] * 1.5 * (1.0 - cosLi * 0.5);
+
+    vec4 shadowPosition = u_ShadowMatrices[cascade] * vec4(position, 1.0);
+    vec2 uv = shadowPosition.xy * 0.5 + 0.5;
+    // Depth is reversed, so larger is closer to the light
+    float depth = shadowPosition.z + 0.0001;
+
+    vec2 texelSize = 1.0 / vec2(textureSize(u_ShadowMap, 0).xy);
+
+    float shadow = 0.0;
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+            shadow += texture(u_ShadowMap, vec4(uv + vec2(x, y) * texelSize, float(cascade), depth));
+    }
+    return shadow / 9.0;
+}
+
+uvec2 GetCluster()
+{
+    float slice = log(max(Input.ViewPosition.z, Epsilon)) * u_ClusterSliceScale + u_ClusterSliceBias;
+    uint sliceIndex = uint(clamp(slice, 0.0, float(ClusterSliceCount - 1)));
+
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / u_ClusterTileSize), uvec2(ClusterTileCountX - 1, ClusterTileCountY - 1));
+    return u_Clusters[(sliceIndex * ClusterTileCountY + tile.y) * ClusterTileCountX + tile.x];
+}
+
+// Point and spot lights of the cluster of the fragment
+vec3 ClusteredLights(uvec2 cluster)
+{
+    vec3 color = vec3(0.0);
+    for (uint i = 0; i < cluster.y; i++)
+    {
+        Light light = u_Lights[u_LightIndices[cluster.x + i]];
+
+        vec3 toLight = light.Position - Input.WorldPosition;
+        float distanceSquared = dot(toLight, toLight);
+        float rangeSquared = light.Range * light.Range;
+        if (distanceSquared >= rangeSquared)
+            continue;
+
+        vec3 Li = toLight * inversesqrt(max(distanceSquared, Epsilon));
+
+        // Inverse square falloff, windowed so it reaches zero at the range
+        float ratio = distanceSquared / rangeSquared;
+        float window = clamp(1.0 - ratio * ratio, 0.0, 1.0);
+        float attenuation = window * window / max(distanceSquared, 0.01);
+
+        // Point lights have a spot scale of zero and an offset of one
+        float spot = clamp(dot(light.Direction, -Li) * light.SpotScale + light.SpotOffset, 0.0, 1.0);
+        attenuation *= spot * spot;
+
+        color += EvaluateLight(Li, light.Color * attenuation);
+    }
+    return color;
+}
+
+vec3 HeatmapColor(float value)
+{
+    value = clamp(value, 0.0, 1.0);
+    return clamp(vec3(value * 2.0 - 0.5, 1.5 - abs(value * 2.0 - 1.0) * 2.0, 1.0 - value * 2.0), 0.0, 1.0);
 }
 
 const vec3 SkyColor = vec3(0.0);
@@ -178,8 +315,19 @@ void main()
 
     m_Params.F0 = mix(Fdielectric, m_Params.AlbedoColor, m_Params.Metalness);
 
+    uvec2 cluster = GetCluster();
+    if (u_LightHeatmap == 1)
+    {
+        // Black without lights, blue to red for up to 32 lights
+        o_Color = vec4(cluster.y == 0u ? vec3(0.0) : HeatmapColor(float(cluster.y) / 32.0), 1.0);
+        return;
+    }
+
+    uint cascade = GetShadowCascade();
+
     vec3 color = vec3(0.0);
-    color += DirectionalLight(u_LightDirection, u_LightColor);
+    color += DirectionalLight(u_LightDirection, u_LightColor) * DirectionalShadow(cascade, u_LightDirection);
+    color += ClusteredLights(cluster);
     color += AmbientLighting() * u_AmbientMultiplier;
     
 	{
@@ -192,6 +340,12 @@ void main()
 		color = mix(SkyColor * u_AmbientMultiplier, color, v);
 	}
 
+    if (u_ShadowCascadeView == 1 && u_ShadowsEnabled == 1)
+    {
+        const vec3 cascadeColors[ShadowCascadeCount] = vec3[](vec3(1.0, 0.3, 0.3), vec3(0.3, 1.0, 0.3), vec3(0.3, 0.3, 1.0), vec3(1.0, 1.0, 0.3));
+        color *= cascadeColors[cascade];
+    }
+
     color = pow(color, vec3(1.0 / 2.2));
 
     o_Color = vec4(color, 1.0);
@@ -26,14 +26,14 @@ namespace Flux {
 		virtual std::filesystem::path GetFilesystemPath(const std::filesystem::path& relativePath) const override;
 		virtual std::filesystem::path GetRelativePath(const std::filesystem::path& filesystemPath) const override;
 
-		virtual std::unordered_map<AssetID, Ref<Asset>>& GetAssetMap() override { return m_AssetMap; }
-		virtual const std::unordered_map<AssetID, Ref<Asset>>& GetAssetMap() const override { return m_AssetMap; }
+		virtual GuidMap<Ref<Asset>>& GetAssetMap() override { return m_AssetMap; }
+		virtual const GuidMap<Ref<Asset>>& GetAssetMap() const override { return m_AssetMap; }
 
-		virtual std::unordered_map<AssetID, Ref<Asset>>& GetMemoryAssetMap() override { return m_MemoryAssetMap; }
-		virtual const std::unordered_map<AssetID, Ref<Asset>>& GetMemoryAssetMap() const override { return m_MemoryAssetMap; }
+		virtual GuidMap<Ref<Asset>>& GetMemoryAssetMap() override { return m_MemoryAssetMap; }
+		virtual const GuidMap<Ref<Asset>>& GetMemoryAssetMap() const override { return m_MemoryAssetMap; }
 
-		virtual std::unordered_map<AssetID, AssetMetadata>& GetMetadataMap() override { return m_MetadataMap; }
-		virtual const std::unordered_map<AssetID, AssetMetadata>& GetMetadataMap() const override { return m_MetadataMap; }
+		virtual GuidMap<AssetMetadata>& GetMetadataMap() override { return m_MetadataMap; }
+		virtual const GuidMap<AssetMetadata>& GetMetadataMap() const override { return m_MetadataMap; }
 
 		void Refresh();
 
@@ -45,7 +45,7 @@ namespace Flux {
 		{
 			assetPath = GetAvailableAssetPath(assetPath);
 
-			auto& assetID = CreateMetadata(GetMetadataPath(assetPath));
+			AssetID assetID = CreateMetadata(GetMetadataPath(assetPath));
 			Ref<Asset> asset = Ref<T>::Create(std::forward<TArgs>(args)...);
 			asset->SetAssetID(assetID);
 
@@ -101,9 +101,9 @@ namespace Flux {
 		std::filesystem::path m_ProjectDirectory;
 		std::filesystem::path m_AssetDirectory;
 
-		std::unordered_map<AssetID, AssetMetadata> m_MetadataMap;
-		std::unordered_map<AssetID, Ref<Asset>> m_AssetMap;
-		std::unordered_map<AssetID, Ref<Asset>> m_MemoryAssetMap;
+		GuidMap<AssetMetadata> m_MetadataMap;
+		GuidMap<Ref<Asset>> m_AssetMap;
+		GuidMap<Ref<Asset>> m_MemoryAssetMap;
 	};
 
 }
\ No newline at end of file
@@ -49,8 +49,12 @@ namespace Flux {
 		m_Position = Vector3::Lerp(m_Position, m_TargetPosition, positionLerpFactor);
 		m_Rotation = Vector3::Lerp(m_Rotation, m_TargetRotation, rotationLerpFactor);
 
+		m_IsMoving = m_IsUsing;
 		if (Vector3::EpsilonNotEqual(m_Position, previousPosition) || Vector3::EpsilonNotEqual(m_Rotation, previousRotation))
+		{
 			RecalculateViewMatrix();
+			m_IsMoving = true;
+		}
 	}
 
 	void EditorCamera::SetViewportSize(uint32 width, uint32 height)
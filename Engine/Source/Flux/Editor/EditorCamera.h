@@ -17,6 +17,8 @@ namespace Flux {
 		bool IsActive() const { return m_IsActive; }
 
 		bool IsUsing() const { return m_IsUsing; }
+		// True while the camera is used or still moving towards its target
+		bool IsMoving() const { return m_IsMoving; }
 
 		const Vector3& GetPosition() const { return m_Position; }
 		const Vector3& GetRotation() const { return m_Rotation; }
@@ -49,6 +51,7 @@ namespace Flux {
 
 		bool m_IsActive = false;
 		bool m_IsUsing = false;
+		bool m_IsMoving = false;
 
 		float m_VerticalFOV = 60.0f;
 		float m_NearClip = 0.01f;
@@ -9,8 +9,16 @@
 #include "SceneViewWindow.h"
 #include "GameViewWindow.h"
 #include "ProjectBrowserWindow.h"
+#include "ProfilerWindow.h"
+#include "RenderCommandsWindow.h"
+#include "MemoryWindow.h"
 
 #include "Flux/Runtime/Renderer/Renderer.h"
+#include "Flux/Runtime/Core/JobSystem.h"
+#include "Flux/Runtime/Scene/SceneBenchmark.h"
+#include "Flux/Runtime/Renderer/RendererBenchmark.h"
+#include "Flux/Runtime/Core/Logging/LogBenchmark.h"
+#include "Flux/Runtime/Core/InputRecorder.h"
 
 namespace Flux {
 
@@ -35,6 +43,9 @@ namespace Flux {
 		EditorWindowManager::AddWindow<SceneViewWindow>("Scene");
 		EditorWindowManager::AddWindow<GameViewWindow>("Game");
 		EditorWindowManager::AddWindow<ProjectBrowserWindow>("Project");
+		EditorWindowManager::AddWindow<ProfilerWindow>("Profiler");
+		EditorWindowManager::AddWindow<RenderCommandsWindow>("Render Commands");
+		EditorWindowManager::AddWindow<MemoryWindow>("Memory");
 
 		OpenProject();
 	}
@@ -126,6 +137,8 @@ namespace Flux {
 		ImGui::Text("Delta Time: %.2fms", m_DeltaTime * 1000.0f);
 		// ImGui::DragFloat("Fixed Delta Time", &m_FixedDeltaTime, 0.001f, 0.001f, 0.1f);
 		ImGui::Text("Fixed Delta Time: %.2f", m_FixedDeltaTime);
+		ImGui::Text("Fixed Update: %.2fms", m_FixedUpdateTime);
+		ImGui::Text("Dropped ticks: %llu", m_DroppedTickCount);
 
 		ImGui::Separator();
 		ImGui::Text("Command queues: %d", Renderer::GetQueueCount());
@@ -141,15 +154,132 @@ namespace Flux {
 			ImGui::Text("Render Thread wait: %.2fms", m_RenderThreadWaitTime);
 		}
 
+		ImGui::Separator();
+		ImGui::Text("Idle: %.2fms", m_IdleTime);
+		ImGui::Text("Frame rate limit wait: %.2fms", m_FrameRateLimitWaitTime);
+
+		if (Ref<SceneViewWindow> sceneViewWindow = EditorWindowManager::GetWindow<SceneViewWindow>())
+		{
+			Ref<RenderPipeline> renderPipeline = sceneViewWindow->GetRenderPipeline();
+			Ref<RenderGraph> renderGraph = renderPipeline->GetRenderGraph();
+			const auto& stats = renderGraph->GetStats();
+
+			ImGui::Separator();
+			auto& renderSettings = renderPipeline->GetRenderSettings();
+			ImGui::Checkbox("Depth Prepass", &renderSettings.DepthPrepass);
+			ImGui::Checkbox("Front-to-back Sorting", &renderSettings.FrontToBackSorting);
+			ImGui::Checkbox("Overdraw View", &renderSettings.OverdrawView);
+
+			ImGui::Text("Render graph: %d passes (%d culled), %d compiles", stats.PassCount, stats.CulledPassCount, stats.CompileCount);
+			ImGui::Text("Transient textures: %d in %d textures", stats.TransientTextureCount, stats.PhysicalTextureCount);
+
+			if (ImGui::Button("Dump Render Graph"))
+			{
+				if (renderGraph->DumpToFile("RenderGraph.txt"))
+					FLUX_INFO("Render graph written to RenderGraph.txt");
+			}
+
+			const auto& lightStats = renderPipeline->GetLightClusterStats();
+
+			ImGui::Separator();
+			ImGui::Checkbox("Light Heatmap", &renderSettings.LightHeatmapView);
+			ImGui::Text("Lights: %d in %d clusters (max %d per cluster)", lightStats.LightCount, lightStats.ActiveClusterCount, lightStats.MaxLightsPerCluster);
+			ImGui::Text("Light indices: %d", lightStats.LightIndexCount);
+			ImGui::Text("Light binning: %.2fms", lightStats.BinningTime);
+
+			const auto& shadowStats = renderPipeline->GetShadowStats();
+
+			ImGui::Separator();
+			ImGui::Checkbox("Shadows", &renderSettings.Shadows);
+			ImGui::Checkbox("Cache Static Shadows", &renderSettings.CacheStaticShadows);
+			ImGui::Checkbox("Shadow Cascade View", &renderSettings.ShadowCascadeView);
+			ImGui::DragFloat("Shadow Distance", &renderSettings.ShadowDistance, 1.0f, 10.0f, 1000.0f);
+			for (uint32 i = 0; i < CascadedShadowMap::s_CascadeCount; i++)
+			{
+				const auto& cascadeStats = shadowStats.Cascades[i];
+				ImGui::Text("Cascade %d: %d static, %d dynamic casters%s", i, cascadeStats.StaticCasterCount, cascadeStats.DynamicCasterCount, cascadeStats.Cached ? " (cached)" : "");
+			}
+			ImGui::Text("Static shadow renders: %d this frame, %llu total", shadowStats.StaticRenderCount, shadowStats.TotalStaticRenderCount);
+
+			const auto& lodStats = renderPipeline->GetMeshLODStats();
+
+			ImGui::Separator();
+			ImGui::Checkbox("Mesh LODs", &renderSettings.MeshLODs);
+			ImGui::DragFloat("LOD Bias", &renderSettings.LODBias, 0.01f, 0.1f, 4.0f);
+			ImGui::DragFloat("LOD Hysteresis", &renderSettings.LODHysteresis, 0.01f, 0.0f, 0.5f);
+			ImGui::Text("Triangles: %llu (%llu at full detail)", lodStats.TriangleCount, lodStats.FullDetailTriangleCount);
+			for (uint32 i = 0; i < MeshLODStats::s_MaxLODCount; i++)
+			{
+				if (lodStats.DrawCounts[i] > 0)
+					ImGui::Text("LOD %d: %d draws", i, lodStats.DrawCounts[i]);
+			}
+		}
+
+		ImGui::Separator();
+		if (ImGui::Button("Run Resource Churn Benchmark"))
+			RendererBenchmark::RunResourceChurn();
+
+		if (ImGui::Button("Run Log Benchmark"))
+			LogBenchmark::Run();
+
+		ImGui::SameLine();
+		if (ImGui::Button("Run Log Benchmark (Drop)"))
+			LogBenchmark::Run(8, 10000, LogOverflowPolicy::Drop);
+
+		ImGui::Separator();
+		if (InputRecorder::IsRecording())
+		{
+			if (ImGui::Button("Stop Input Recording"))
+				InputRecorder::StopRecording();
+		}
+		else if (InputRecorder::IsReplaying())
+		{
+			ImGui::Text("Replaying input: frame %d/%d", InputRecorder::GetReplayFrameIndex(), InputRecorder::GetReplayFrameCount());
+		}
+		else
+		{
+			if (ImGui::Button("Start Input Recording"))
+				InputRecorder::StartRecording("Recordings/Input.finput");
+
+			ImGui::SameLine();
+			if (ImGui::Button("Replay Input Recording"))
+				InputRecorder::StartReplay("Recordings/Input.finput");
+		}
+
+		if (auto& replayResult = InputRecorder::GetReplayResult())
+			ImGui::Text("Last replay: %.2fms average, %.2fms 99th percentile", replayResult->AverageFrameTime, replayResult->P99FrameTime);
+
+		if (m_EditorScene)
+		{
+			ImGui::Separator();
+			ImGui::Text("Scene systems (%d workers)", JobSystem::GetWorkerCount());
+
+			for (auto& system : m_EditorScene->GetSystemScheduler().GetSystems())
+			{
+				const char* phaseString = Utils::SceneSystemPhaseToString(system.Info.Phase);
+				ImGui::Text("[%s:%d] %s: %.3fms", phaseString, system.BatchIndex, system.Info.Name.c_str(), system.LastExecutionTime);
+			}
+
+			if (ImGui::Button("Run Transform Benchmark"))
+				SceneBenchmark::RunTransformUpdate();
+
+			if (ImGui::Button("Run Serialization Benchmark"))
+				SceneBenchmark::RunSerialization();
+		}
+
 #ifdef FLUX_MATH_DEBUG_ENABLED
 		ImGui::Separator();
 
-		auto& mathFunctionCalls = MathDebug::GetFunctionCalls();
+		if (ImGui::Button("Reset Math Calls"))
+			MathDebug::Reset();
 
-		for (auto& [functionName, numCalls] : mathFunctionCalls)
+		for (auto& stats : MathDebug::GetFunctionStats())
 		{
-			std::string textString = fmt::format("{0}: {1} calls", functionName, numCalls);
+			FrameString textString = Utils::FrameFormat("{0}: {1} calls ({2} total)", stats.Name, stats.LastFrameCalls, stats.TotalCalls);
 			ImGui::TextUnformatted(textString.c_str());
+			ImGui::PushID(stats.Name.data());
+			ImGui::PlotHistogram("##History", stats.History.data(), static_cast<int32>(stats.History.size()), stats.HistoryOffset, nullptr, 0.0f, FLT_MAX, { 0.0f, 30.0f });
+			ImGui::PopID();
 		}
 #endif
 
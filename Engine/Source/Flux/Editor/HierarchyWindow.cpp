@@ -65,6 +65,14 @@ namespace Flux {
 		if (!m_Scene)
 			return;
 
+		uint64 relationshipVersion = m_Scene->GetChangeTracker().GetVersion(ComponentType::Relationship);
+		if (m_ChildrenCacheScene != m_Scene.Get() || m_ChildrenCacheVersion != relationshipVersion)
+		{
+			m_ChildrenCache.clear();
+			m_ChildrenCacheScene = m_Scene.Get();
+			m_ChildrenCacheVersion = relationshipVersion;
+		}
+
 		ImVec2 minRegion = ImGui::GetWindowContentRegionMin();
 		ImVec2 maxRegion = ImGui::GetWindowContentRegionMax();
 		ImVec2 windowPos = ImGui::GetWindowPos();
@@ -142,8 +150,8 @@ namespace Flux {
 
 	void HierarchyWindow::DrawEntityNode(Entity entity)
 	{
-		std::string entityIDString = fmt::format("Entity_{0}_{1}", (uint32)entity, (uintptr)entity.GetScene());
-		std::string dragHandleIDString = fmt::format("{0}_DragHandle", entityIDString);
+		FrameString entityIDString = Utils::FrameFormat("Entity_{0}_{1}", (uint32)entity, (uintptr)entity.GetScene());
+		FrameString dragHandleIDString = Utils::FrameFormat("{0}_DragHandle", entityIDString);
 
 		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { 0.0f, 1.5f });
 
@@ -191,7 +199,7 @@ namespace Flux {
 				flags |= ImGuiTreeNodeFlags_Leaf;
 		}
 
-		std::string entityName = entity.GetComponent<NameComponent>().GetName();
+		const std::string& entityName = entity.GetComponent<NameComponent>().GetName();
 		bool open = ImGui::TreeNodeEx(entityName.c_str(), flags);
 
 		if (entity != m_Scene->GetRootEntity())
@@ -223,12 +231,24 @@ namespace Flux {
 
 		if (open)
 		{
-			std::vector<Entity> children = entity.GetChildren();
-			for (Entity childEntity : children)
+			// Reparenting while drawing only invalidates the cache for the next frame
+			for (Entity childEntity : GetCachedChildren(entity))
 				DrawEntityNode(childEntity);
 
 			ImGui::TreePop();
 		}
 	}
 
+	const std::vector<Entity>& HierarchyWindow::GetCachedChildren(Entity entity)
+	{
+		auto it = m_ChildrenCache.find(entity);
+		if (it == m_ChildrenCache.end())
+		{
+			// The cache outlives the frame memory of GetChildren
+			FrameVector<Entity> children = entity.GetChildren();
+			it = m_ChildrenCache.emplace(entity, std::vector<Entity>(children.begin(), children.end())).first;
+		}
+		return it->second;
+	}
+
 }
\ No newline at end of file
@@ -15,8 +15,15 @@ namespace Flux {
 		Entity GetSelectedEntity() const { return m_SelectedEntity; }
 	private:
 		void DrawEntityNode(Entity entity);
+
+		const std::vector<Entity>& GetCachedChildren(Entity entity);
 	private:
 		Entity m_SelectedEntity;
+
+		// Children of the drawn nodes, rebuilt when a relationship component of the scene changes
+		std::unordered_map<entt::entity, std::vector<Entity>> m_ChildrenCache;
+		Scene* m_ChildrenCacheScene = nullptr;
+		uint64 m_ChildrenCacheVersion = 0;
 	};
 
 }
\ No newline at end of file
@@ -174,13 +174,47 @@ namespace Flux {
 		{
 			UI::BeginPropertyGrid();
 
+			bool isStatic = component.IsStatic();
+			if (UI::Property("Static", isStatic))
+				component.SetStatic(isStatic);
+
 			UI::EndPropertyGrid();
 		});
 
 		DrawComponent<LightComponent>("Light", selectedEntity, [&](LightComponent& component)
 		{
 			UI::BeginPropertyGrid();
-			
+
+			int32 lightType = static_cast<int32>(component.GetLightType());
+			if (UI::Property("Type (Directional, Point, Spot)", lightType, 0.05f, 0, 2))
+				component.SetLightType(static_cast<LightComponent::LightType>(lightType));
+
+			Vector3 color = component.GetColor();
+			if (UI::Property("Color", color, 0.01f, 0.0f, 1.0f))
+				component.SetColor(color);
+
+			float intensity = component.GetIntensity();
+			if (UI::Property("Intensity", intensity, 0.1f, 0.0f, std::numeric_limits<float>::max()))
+				component.SetIntensity(intensity);
+
+			if (component.GetLightType() != LightComponent::LightType::Directional)
+			{
+				float range = component.GetRange();
+				if (UI::Property("Range", range, 0.1f, 0.01f, std::numeric_limits<float>::max()))
+					component.SetRange(range);
+			}
+
+			if (component.GetLightType() == LightComponent::LightType::Spot)
+			{
+				float innerConeAngle = component.GetInnerConeAngle();
+				if (UI::Property("Inner Cone Angle", innerConeAngle, 0.1f, 0.0f, component.GetOuterConeAngle()))
+					component.SetInnerConeAngle(innerConeAngle);
+
+				float outerConeAngle = component.GetOuterConeAngle();
+				if (UI::Property("Outer Cone Angle", outerConeAngle, 0.1f, 0.1f, 89.0f))
+					component.SetOuterConeAngle(outerConeAngle);
+			}
+
 			UI::EndPropertyGrid();
 		});
 	}
@@ -0,0 +1,95 @@
+#include "FluxPCH.h"
+#include "MemoryWindow.h"
+
+#include "Flux/Runtime/Renderer/Renderer.h"
+
+#include <imgui.h>
+
+namespace Flux {
+
+	namespace Utils {
+
+		static void MemoryStatsRow(const char* name, const MemoryTagStats& stats)
+		{
+			ImGui::TextUnformatted(name);
+			ImGui::NextColumn();
+			ImGui::Text("%.2f KB", stats.LiveBytes / 1024.0f);
+			ImGui::NextColumn();
+			ImGui::Text("%.2f KB", stats.PeakBytes / 1024.0f);
+			ImGui::NextColumn();
+			ImGui::Text("%llu", stats.LiveAllocations);
+			ImGui::NextColumn();
+			ImGui::Text("%llu", stats.FrameAllocations);
+			ImGui::NextColumn();
+			ImGui::Text("%.2f KB", stats.FrameBytes / 1024.0f);
+			ImGui::NextColumn();
+		}
+
+	}
+
+	MemoryWindow::MemoryWindow()
+	{
+	}
+
+	MemoryWindow::~MemoryWindow()
+	{
+	}
+
+	void MemoryWindow::OnImGuiRender()
+	{
+		bool captureCallstacks = Memory::IsCallstackCaptureEnabled();
+		if (ImGui::Checkbox("Capture callstacks", &captureCallstacks))
+			Memory::SetCallstackCaptureEnabled(captureCallstacks);
+
+		ImGui::SameLine();
+		if (ImGui::Button("Report Leaks"))
+			Memory::ReportLeaks();
+
+		ImGui::Separator();
+
+		FrameMemoryStats frameMemoryStats = FrameMemory::GetStats();
+		ImGui::Text("Heap allocations: %llu per frame", Memory::GetFrameHeapAllocations());
+		ImGui::Text("Frame memory: %.2f / %.2f KB", frameMemoryStats.UsedBytes / 1024.0f, frameMemoryStats.Capacity / 1024.0f);
+		if (frameMemoryStats.OverflowBytes > 0)
+		{
+			ImGui::SameLine();
+			ImGui::Text("(%.2f KB overflow)", frameMemoryStats.OverflowBytes / 1024.0f);
+		}
+
+		StagingRingStats stagingStats = Renderer::GetStagingStats();
+		ImGui::Text("Staging ring: %.2f / %.2f KB per frame", stagingStats.FrameBytes / 1024.0f, stagingStats.Capacity / 1024.0f);
+		if (stagingStats.FrameHeapFallbacks > 0)
+		{
+			ImGui::SameLine();
+			ImGui::Text("(%u heap fallbacks)", stagingStats.FrameHeapFallbacks);
+		}
+		ImGui::Separator();
+
+		ImGui::Columns(6);
+		ImGui::TextUnformatted("Tag");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Live");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Peak");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Allocations");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Allocations/Frame");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Bytes/Frame");
+		ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (uint8 i = 0; i < static_cast<uint8>(MemoryTag::Count); i++)
+		{
+			MemoryTag tag = static_cast<MemoryTag>(i);
+			Utils::MemoryStatsRow(Utils::MemoryTagToString(tag), Memory::GetStats(tag));
+		}
+
+		ImGui::Separator();
+		Utils::MemoryStatsRow("Total", Memory::GetTotalStats());
+
+		ImGui::Columns(1);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "EditorWindow.h"
+
+namespace Flux {
+
+	class MemoryWindow : public EditorWindow
+	{
+	public:
+		MemoryWindow();
+		virtual ~MemoryWindow();
+
+		virtual void OnImGuiRender() override;
+	};
+
+}
\ No newline at end of file
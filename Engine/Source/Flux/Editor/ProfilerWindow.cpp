@@ -0,0 +1,169 @@
+#include "FluxPCH.h"
+#include "ProfilerWindow.h"
+
+#include <imgui.h>
+
+namespace Flux {
+
+	namespace Utils {
+
+		static ImU32 ProfilerScopeNameToColor(const char* name)
+		{
+			size_t hash = std::hash<std::string_view>()(name);
+			float hue = static_cast<float>(hash % 360) / 360.0f;
+			return ImColor::HSV(hue, 0.45f, 0.65f);
+		}
+
+		// Milliseconds between the start of the frame and the timestamp, negative for earlier timestamps
+		static float ProfilerFrameOffset(const ProfilerFrame& frame, uint64 cycles)
+		{
+			if (cycles >= frame.Start)
+				return Profiler::CyclesToMilliseconds(cycles - frame.Start);
+			return -Profiler::CyclesToMilliseconds(frame.Start - cycles);
+		}
+
+	}
+
+	ProfilerWindow::ProfilerWindow()
+	{
+	}
+
+	ProfilerWindow::~ProfilerWindow()
+	{
+	}
+
+	void ProfilerWindow::OnImGuiRender()
+	{
+		bool paused = Profiler::IsPaused();
+		if (ImGui::Checkbox("Pause", &paused))
+			Profiler::SetPaused(paused);
+
+		ImGui::SameLine();
+		if (ImGui::Button("Export Trace"))
+			Profiler::ExportChromeTrace("FluxTrace.json");
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(120.0f);
+		ImGui::SliderFloat("Zoom", &m_Zoom, 1.0f, 20.0f, "%.1fx");
+
+		uint64 droppedEvents = Profiler::GetDroppedEventCount();
+		if (droppedEvents > 0)
+		{
+			ImGui::SameLine();
+			ImGui::Text("%llu events dropped", droppedEvents);
+		}
+
+		// The last frame is still being recorded
+		auto& frames = Profiler::GetFrames();
+		if (frames.size() < 2)
+			return;
+
+		if (!paused)
+			m_SelectedFrameIndex = frames[frames.size() - 2].Index;
+
+		DrawFrameTimes(frames);
+
+		const ProfilerFrame* selectedFrame = &frames[frames.size() - 2];
+		for (size_t i = 0; i < frames.size() - 1; i++)
+		{
+			if (frames[i].Index == m_SelectedFrameIndex)
+				selectedFrame = &frames[i];
+		}
+
+		float frameTime = Profiler::CyclesToMilliseconds(selectedFrame->End - selectedFrame->Start);
+		ImGui::Text("Frame %llu: %.3fms", selectedFrame->Index, frameTime);
+		ImGui::Separator();
+
+		ImGui::BeginChild("FlameGraph", { 0.0f, 0.0f }, false, ImGuiWindowFlags_HorizontalScrollbar);
+		DrawFlameGraph(*selectedFrame);
+		ImGui::EndChild();
+	}
+
+	void ProfilerWindow::DrawFrameTimes(const std::deque<ProfilerFrame>& frames)
+	{
+		const size_t frameCount = frames.size() - 1;
+
+		std::vector<float> frameTimes(frameCount);
+		for (size_t i = 0; i < frameCount; i++)
+			frameTimes[i] = Profiler::CyclesToMilliseconds(frames[i].End - frames[i].Start);
+
+		ImGui::PlotHistogram("##FrameTimes", frameTimes.data(), static_cast<int32>(frameCount), 0, nullptr, 0.0f, 33.3f, { ImGui::GetContentRegionAvail().x, 60.0f });
+
+		// Clicking a frame pauses the profiler to inspect it
+		if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
+		{
+			ImVec2 min = ImGui::GetItemRectMin();
+			ImVec2 max = ImGui::GetItemRectMax();
+
+			float t = (ImGui::GetMousePos().x - min.x) / (max.x - min.x);
+			size_t frameIndex = Math::Min(static_cast<size_t>(t * frameCount), frameCount - 1);
+
+			m_SelectedFrameIndex = frames[frameIndex].Index;
+			Profiler::SetPaused(true);
+		}
+	}
+
+	void ProfilerWindow::DrawFlameGraph(const ProfilerFrame& frame)
+	{
+		constexpr float rowHeight = 18.0f;
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		const float frameTime = Profiler::CyclesToMilliseconds(frame.End - frame.Start);
+		const float width = ImGui::GetContentRegionAvail().x * m_Zoom;
+		if (frameTime <= 0.0f || width <= 0.0f)
+			return;
+
+		auto& threads = Profiler::GetThreads();
+		for (uint32 threadIndex = 0; threadIndex < static_cast<uint32>(threads.size()); threadIndex++)
+		{
+			uint32 maxDepth = 0;
+			bool hasEvents = false;
+			for (auto& event : frame.Events)
+			{
+				if (event.ThreadIndex == threadIndex)
+				{
+					maxDepth = Math::Max(maxDepth, event.Depth);
+					hasEvents = true;
+				}
+			}
+
+			if (!hasEvents)
+				continue;
+
+			ImGui::TextUnformatted(threads[threadIndex].Name.c_str());
+
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+
+			for (auto& event : frame.Events)
+			{
+				if (event.ThreadIndex != threadIndex)
+					continue;
+
+				float start = Math::Clamp(Utils::ProfilerFrameOffset(frame, event.Start), 0.0f, frameTime);
+				float end = Math::Clamp(Utils::ProfilerFrameOffset(frame, event.End), 0.0f, frameTime);
+
+				ImVec2 min = { origin.x + start / frameTime * width, origin.y + event.Depth * rowHeight };
+				ImVec2 max = { origin.x + end / frameTime * width, min.y + rowHeight - 1.0f };
+				if (max.x - min.x < 1.0f)
+					max.x = min.x + 1.0f;
+
+				drawList->AddRectFilled(min, max, Utils::ProfilerScopeNameToColor(event.Name));
+
+				if (max.x - min.x > 20.0f)
+				{
+					drawList->PushClipRect(min, max, true);
+					drawList->AddText({ min.x + 4.0f, min.y + 2.0f }, IM_COL32_WHITE, event.Name);
+					drawList->PopClipRect();
+				}
+
+				if (ImGui::IsWindowHovered() && ImGui::IsMouseHoveringRect(min, max))
+					ImGui::SetTooltip("%s: %.3fms", event.Name, Profiler::CyclesToMilliseconds(event.End - event.Start));
+			}
+
+			ImGui::Dummy({ width, (maxDepth + 1) * rowHeight });
+			ImGui::Spacing();
+		}
+	}
+
+}
\ No newline at end of file
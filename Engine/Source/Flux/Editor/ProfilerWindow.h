@@ -0,0 +1,23 @@
+#pragma once
+
+#include "EditorWindow.h"
+
+namespace Flux {
+
+	class ProfilerWindow : public EditorWindow
+	{
+	public:
+		ProfilerWindow();
+		virtual ~ProfilerWindow();
+
+		virtual void OnImGuiRender() override;
+	private:
+		void DrawFrameTimes(const std::deque<ProfilerFrame>& frames);
+		void DrawFlameGraph(const ProfilerFrame& frame);
+	private:
+		// Follows the latest frame while the profiler is running
+		uint64 m_SelectedFrameIndex = 0;
+		float m_Zoom = 1.0f;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "FluxPCH.h"
+#include "RenderCommandsWindow.h"
+
+#include "Flux/Runtime/Renderer/Renderer.h"
+
+#include <imgui.h>
+
+namespace Flux {
+
+	RenderCommandsWindow::RenderCommandsWindow()
+	{
+	}
+
+	RenderCommandsWindow::~RenderCommandsWindow()
+	{
+	}
+
+	void RenderCommandsWindow::OnImGuiRender()
+	{
+#ifndef FLUX_BUILD_SHIPPING
+		bool timingEnabled = Renderer::IsCommandTimingEnabled();
+		if (ImGui::Checkbox("Time commands", &timingEnabled))
+			Renderer::SetCommandTimingEnabled(timingEnabled);
+
+		ImGui::SameLine();
+		if (ImGui::Button("Dump CSV"))
+			Renderer::DumpRenderCommandStats("RenderCommands.csv");
+
+		if (!timingEnabled)
+		{
+			ImGui::TextUnformatted("Command stats are only collected while commands are timed");
+			return;
+		}
+
+		std::vector<CommandQueueStats> commandStats = Renderer::GetRenderCommandStats();
+
+		uint32 totalCount = 0;
+		uint64 totalBytes = 0;
+		float totalTime = 0.0f;
+		for (auto& stats : commandStats)
+		{
+			totalCount += stats.Count;
+			totalBytes += stats.Bytes;
+			totalTime += stats.Time;
+		}
+
+		ImGui::Text("%d commands, %.2f KB, %.3fms", totalCount, totalBytes / 1024.0f, totalTime);
+		ImGui::Separator();
+
+		ImGui::Columns(4);
+		ImGui::TextUnformatted("Function");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Count");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Bytes");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Time");
+		ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (auto& stats : commandStats)
+		{
+			ImGui::TextUnformatted(stats.Name);
+			ImGui::NextColumn();
+			ImGui::Text("%d", stats.Count);
+			ImGui::NextColumn();
+			ImGui::Text("%llu", stats.Bytes);
+			ImGui::NextColumn();
+			ImGui::Text("%.3fms", stats.Time);
+			ImGui::NextColumn();
+		}
+
+		ImGui::Columns(1);
+#else
+		ImGui::TextUnformatted("Render command stats are not available in shipping builds");
+#endif
+	}
+
+}
\ No newline at end of file
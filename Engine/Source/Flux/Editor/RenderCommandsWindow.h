@@ -0,0 +1,16 @@
+#pragma once
+
+#include "EditorWindow.h"
+
+namespace Flux {
+
+	class RenderCommandsWindow : public EditorWindow
+	{
+	public:
+		RenderCommandsWindow();
+		virtual ~RenderCommandsWindow();
+
+		virtual void OnImGuiRender() override;
+	};
+
+}
\ No newline at end of file
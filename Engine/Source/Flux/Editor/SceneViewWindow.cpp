@@ -36,6 +36,8 @@ namespace Flux {
 
 			m_EditorCamera.SetActive(m_IsViewportFocused && m_IsViewportHovered);
 			m_EditorCamera.OnUpdate(deltaTime);
+			if (m_EditorCamera.IsMoving())
+				Engine::Get().RequestRedraw();
 
 			m_EditorCamera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
 			m_RenderPipeline->SetViewportSize(m_ViewportWidth, m_ViewportHeight);
@@ -20,6 +20,8 @@ namespace Flux {
 
 		EditorCamera& GetEditorCamera() { return m_EditorCamera; }
 		const EditorCamera& GetEditorCamera() const { return m_EditorCamera; }
+
+		Ref<RenderPipeline> GetRenderPipeline() const { return m_RenderPipeline; }
 	private:
 		void DrawGizmos();
 
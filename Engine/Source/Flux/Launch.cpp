@@ -5,6 +5,12 @@
 #define FLUX_EDITOR
 // #define FLUX_RUNTIME
 
+// Writes Logs/Latest.flog instead of Logs/Latest.log, decode it with fluxlogdump
+// #define FLUX_BINARY_LOG
+
+// Replays an input recording without showing the window and closes once it's done, the frame times end up next to the recording
+// #define FLUX_INPUT_REPLAY "Recordings/Input.finput"
+
 #ifdef FLUX_EDITOR
 	#include "Editor/EditorEngine.h"
 #endif
@@ -32,6 +38,17 @@ namespace Flux {
 		// Disable V-Sync
 		createInfo.VSync = false;
 
+		// The editor only redraws when something changes and is capped otherwise
+		createInfo.RenderOnDemand = true;
+		createInfo.FrameRateLimit = 144.0f;
+		createInfo.BackgroundFrameRateLimit = 30.0f;
+
+#ifdef FLUX_INPUT_REPLAY
+		createInfo.InputReplayPath = FLUX_INPUT_REPLAY;
+		createInfo.Headless = true;
+		createInfo.ShowSplashScreen = false;
+#endif
+
 		return new EditorEngine(createInfo);
 #endif
 
@@ -54,7 +71,13 @@ namespace Flux {
 	{
 		while (g_EngineRunning)
 		{
-			Logger::Init();
+			LoggerCreateInfo loggerCreateInfo;
+#ifdef FLUX_BINARY_LOG
+			loggerCreateInfo.TextLog = false;
+			loggerCreateInfo.BinaryLog = true;
+#endif
+
+			Logger::Init(loggerCreateInfo);
 			Platform::Init();
 
 			FLUX_INFO("Initializing...");
@@ -68,6 +91,8 @@ namespace Flux {
 				delete engine;
 			}
 
+			Memory::ReportLeaks();
+
 			FLUX_INFO("Shutting down...");
 
 			Platform::Shutdown();
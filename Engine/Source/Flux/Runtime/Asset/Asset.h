@@ -14,6 +14,8 @@ namespace Flux {
 	class Asset : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Assets;
+
 		virtual ~Asset() {}
 
 		void SetAssetID(const AssetID& assetID) { m_AssetID = assetID; }
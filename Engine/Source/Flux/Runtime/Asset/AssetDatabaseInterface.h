@@ -28,14 +28,14 @@ namespace Flux {
 		virtual std::filesystem::path GetFilesystemPath(const std::filesystem::path& relativePath) const = 0;
 		virtual std::filesystem::path GetRelativePath(const std::filesystem::path& filesystemPath) const = 0;
 
-		virtual std::unordered_map<AssetID, Ref<Asset>>& GetAssetMap() = 0;
-		virtual const std::unordered_map<AssetID, Ref<Asset>>& GetAssetMap() const = 0;
+		virtual GuidMap<Ref<Asset>>& GetAssetMap() = 0;
+		virtual const GuidMap<Ref<Asset>>& GetAssetMap() const = 0;
 
-		virtual std::unordered_map<AssetID, Ref<Asset>>& GetMemoryAssetMap() = 0;
-		virtual const std::unordered_map<AssetID, Ref<Asset>>& GetMemoryAssetMap() const = 0;
+		virtual GuidMap<Ref<Asset>>& GetMemoryAssetMap() = 0;
+		virtual const GuidMap<Ref<Asset>>& GetMemoryAssetMap() const = 0;
 
-		virtual std::unordered_map<AssetID, AssetMetadata>& GetMetadataMap() = 0;
-		virtual const std::unordered_map<AssetID, AssetMetadata>& GetMetadataMap() const = 0;
+		virtual GuidMap<AssetMetadata>& GetMetadataMap() = 0;
+		virtual const GuidMap<AssetMetadata>& GetMetadataMap() const = 0;
 
 		template<typename T = Asset>
 		Ref<T> GetAssetFromID(const AssetID& assetID)
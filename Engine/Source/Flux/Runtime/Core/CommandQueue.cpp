@@ -6,8 +6,13 @@ namespace Flux {
 	CommandQueue::CommandQueue(const std::string& debugName, uint64 initialSize)
 		: m_DebugName(debugName)
 	{
-		m_Buffer.Allocate(initialSize);
+		m_Buffer.Allocate(initialSize, MemoryTag::Commands);
 		m_BufferPointer = m_Buffer.GetData<uint8>();
+
+#ifndef FLUX_BUILD_SHIPPING
+		m_FlushStats.resize(s_FlushStatsCapacity);
+		m_UsedFlushStats.reserve(s_FlushStatsCapacity);
+#endif
 	}
 
 	CommandQueue::~CommandQueue()
@@ -15,21 +20,78 @@ namespace Flux {
 		m_Buffer.Release();
 	}
 
-	void CommandQueue::Flush()
+	void CommandQueue::Flush(CommandQueue* parentQueue)
 	{
 		uint8* data = m_Buffer.GetData<uint8>();
+
+#ifndef FLUX_BUILD_SHIPPING
+		CommandQueue* statsQueue = parentQueue ? parentQueue : this;
+		const bool timingEnabled = statsQueue->m_TimingEnabled;
+#endif
+
 		while (data != m_BufferPointer)
 		{
 			CommandFn func = *(CommandFn*)data;
 			data += sizeof(CommandFn);
 
+#ifndef FLUX_BUILD_SHIPPING
+			const char* debugName = *(const char**)data;
+			data += sizeof(const char*);
+#endif
+
 			uint32 size = *(uint32*)data;
 			data += sizeof(uint32);
 
+#ifndef FLUX_BUILD_SHIPPING
+			CommandQueueStats* stats = timingEnabled ? statsQueue->FindFlushStats(debugName) : nullptr;
+			if (stats)
+			{
+				stats->Count++;
+				stats->Bytes += size;
+
+				uint64 nestedStart = statsQueue->m_TimedCommandTime;
+				uint64 start = Platform::GetNanoTime();
+				func(data);
+				uint64 end = Platform::GetNanoTime();
+
+				uint64 time = (end - start) - (statsQueue->m_TimedCommandTime - nestedStart);
+				statsQueue->m_TimedCommandTime += time;
+				stats->Time += float(time) * 0.001f * 0.001f;
+			}
+			else
+			{
+				func(data);
+			}
+#else
 			func(data);
+#endif
 			data += size;
 		}
 
+#ifndef FLUX_BUILD_SHIPPING
+		// Only written by the flushing thread, the stats of the last timed flush are cleared once after timing is disabled.
+		// Nested flushes leave their stats in the parent's table until the parent is done.
+		if (!parentQueue && (timingEnabled || !m_LastFlushStats.empty()))
+		{
+			std::lock_guard<std::mutex> lock(m_StatsMutex);
+
+			m_LastFlushStats.clear();
+			for (uint32 index : m_UsedFlushStats)
+			{
+				m_LastFlushStats.push_back(m_FlushStats[index]);
+				m_FlushStats[index] = {};
+			}
+			m_UsedFlushStats.clear();
+
+			std::sort(m_LastFlushStats.begin(), m_LastFlushStats.end(), [](const CommandQueueStats& a, const CommandQueueStats& b)
+			{
+				if (a.Time != b.Time)
+					return a.Time > b.Time;
+				return a.Bytes > b.Bytes;
+			});
+		}
+#endif
+
 		if (m_ShouldShrink)
 		{
 			const uint32 currentSize = static_cast<uint32>(m_BufferPointer - m_Buffer.GetData<uint8>());
@@ -40,10 +102,53 @@ namespace Flux {
 		m_BufferPointer = m_Buffer.GetData<uint8>();
 	}
 
-	void* CommandQueue::Allocate(CommandFn func, uint32 size)
+#ifndef FLUX_BUILD_SHIPPING
+	std::vector<CommandQueueStats> CommandQueue::GetLastFlushStats()
+	{
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		return m_LastFlushStats;
+	}
+
+	CommandQueueStats* CommandQueue::FindFlushStats(const char* debugName)
 	{
+		constexpr uint32 mask = s_FlushStatsCapacity - 1;
+		static_assert((s_FlushStatsCapacity & mask) == 0);
+
+		// Debug names are string literals, so their addresses identify the call sites
+		uint64 hash = reinterpret_cast<uintptr>(debugName) * 0x9E3779B97F4A7C15ull;
+		uint32 index = static_cast<uint32>(hash >> 32) & mask;
+
+		for (uint32 probe = 0; probe < s_FlushStatsCapacity; probe++)
+		{
+			CommandQueueStats& stats = m_FlushStats[index];
+			if (stats.Name == debugName)
+				return &stats;
+
+			if (!stats.Name)
+			{
+				stats.Name = debugName;
+				m_UsedFlushStats.push_back(index);
+				return &stats;
+			}
+
+			index = (index + 1) & mask;
+		}
+
+		// More call sites than slots, the rest isn't counted
+		return nullptr;
+	}
+#endif
+
+	void* CommandQueue::Allocate(CommandFn func, uint32 size, const char* debugName)
+	{
+#ifndef FLUX_BUILD_SHIPPING
+		constexpr uint32 headerSize = sizeof(CommandFn) + sizeof(const char*) + sizeof(uint32);
+#else
+		constexpr uint32 headerSize = sizeof(CommandFn) + sizeof(uint32);
+#endif
+
 		const uint32 currentOffset = static_cast<uint32>(m_BufferPointer - m_Buffer.GetData<uint8>());
-		const uint32 newSize = currentOffset + sizeof(CommandFn) + sizeof(uint32) + size;
+		const uint32 newSize = currentOffset + headerSize + size;
 		if (newSize > m_Buffer.Size)
 		{
 			uint32 newCapacity = m_Buffer.Size * 2;
@@ -56,6 +161,11 @@ namespace Flux {
 		*(CommandFn*)m_BufferPointer = func;
 		m_BufferPointer += sizeof(CommandFn);
 
+#ifndef FLUX_BUILD_SHIPPING
+		*(const char**)m_BufferPointer = debugName;
+		m_BufferPointer += sizeof(const char*);
+#endif
+
 		*(uint32*)m_BufferPointer = size;
 		m_BufferPointer += sizeof(uint32);
 
@@ -66,7 +176,7 @@ namespace Flux {
 
 	void CommandQueue::Resize(uint32 currentOffset, uint32 newCapacity)
 	{
-		FLUX_WARNING("{0} -  Resize({1}, {2})", m_DebugName, currentOffset, newCapacity);
+		FLUX_WARNING_CATEGORY("Command Queue", "{0} - Resize({1}, {2})", m_DebugName, currentOffset, newCapacity);
 
 		m_Buffer.Reallocate(newCapacity);
 		m_BufferPointer = m_Buffer.GetData<uint8>(currentOffset);
@@ -4,6 +4,17 @@
 
 namespace Flux {
 
+#ifndef FLUX_BUILD_SHIPPING
+	// Commands of one call site that were executed during a flush, only collected while command timing is enabled
+	struct CommandQueueStats
+	{
+		const char* Name = nullptr;
+		uint32 Count = 0;
+		uint64 Bytes = 0;
+		float Time = 0.0f;
+	};
+#endif
+
 	class CommandQueue
 	{
 	private:
@@ -12,16 +23,30 @@ namespace Flux {
 		CommandQueue(const std::string& debugName, uint64 initialSize);
 		~CommandQueue();
 
+		// debugName identifies the call site in the command stats, it has to be a string literal
 		template<typename TFunc>
-		void Push(TFunc&& func)
+		void Push(TFunc&& func, const char* debugName = "Unknown")
 		{
-			auto buffer = Allocate(Execute<TFunc>, sizeof(TFunc));
+			auto buffer = Allocate(Execute<TFunc>, sizeof(TFunc), debugName);
 			new (buffer) TFunc(std::forward<TFunc>(func));
 		}
 
-		void Flush();
+		// parentQueue is the queue whose command flushes this one, the stats are then added to the parent's
+		void Flush(CommandQueue* parentQueue = nullptr);
+
+#ifndef FLUX_BUILD_SHIPPING
+		void SetTimingEnabled(bool enabled) { m_TimingEnabled = enabled; }
+		bool IsTimingEnabled() const { return m_TimingEnabled; }
+
+		// Stats of the last completed flush, sorted by time and size
+		std::vector<CommandQueueStats> GetLastFlushStats();
+#endif
 	private:
-		void* Allocate(CommandFn func, uint32 size);
+		void* Allocate(CommandFn func, uint32 size, const char* debugName);
+
+#ifndef FLUX_BUILD_SHIPPING
+		CommandQueueStats* FindFlushStats(const char* debugName);
+#endif
 		void Resize(uint32 currentOffset, uint32 newCapacity);
 
 		template<typename TFunc>
@@ -36,6 +61,21 @@ namespace Flux {
 		uint8* m_BufferPointer;
 		std::string m_DebugName;
 		bool m_ShouldShrink = false;
+
+#ifndef FLUX_BUILD_SHIPPING
+		std::atomic<bool> m_TimingEnabled = false;
+
+		// Open addressing table keyed by the debug name pointer, only the used slots are reset after a flush
+		static constexpr uint32 s_FlushStatsCapacity = 512;
+		std::vector<CommandQueueStats> m_FlushStats;
+		std::vector<uint32> m_UsedFlushStats;
+		std::vector<CommandQueueStats> m_LastFlushStats;
+		std::mutex m_StatsMutex;
+
+		// Nanoseconds of all timed commands executed so far, including the ones of nested flushes.
+		// Excludes the time of nested commands from the command that flushed them.
+		uint64 m_TimedCommandTime = 0;
+#endif
 	};
 
 }
@@ -1,15 +1,20 @@
 #pragma once
 
 #include "BaseTypes.h"
+#include "Memory.h"
 #include "RefCounting.h"
 #include "Logging/LogMacros.h"
 #include "Logging/LogFormatters.h"
 #include "AssertionMacros.h"
 #include "Platform.h"
+#include "Profiler.h"
 #include "Input.h"
 #include "Buffer.h"
 #include "Guid.h"
+#include "GuidMap.h"
 #include "Math/Math.h"
+#include "FrameAllocator.h"
+#include "ObjectPool.h"
 
 #define FLUX_BIND_CALLBACK(func, ...) \
 [__VA_ARGS__](auto&&... args) -> decltype(auto) \
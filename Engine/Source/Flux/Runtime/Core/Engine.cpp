@@ -1,5 +1,7 @@
 #include "FluxPCH.h"
 #include "Engine.h"
+#include "JobSystem.h"
+#include "InputRecorder.h"
 
 #include "Flux/Runtime/Renderer/Renderer.h"
 
@@ -7,34 +9,39 @@ namespace Flux {
 
 	namespace Utils {
 
-		static void ExecuteQueue(std::queue<std::function<void()>>& queue, std::mutex& mutex)
+		static uint32 ExecuteQueue(std::queue<std::function<void()>>& queue, std::mutex& mutex)
 		{
 			std::lock_guard<std::mutex> lock(mutex);
+			uint32 count = 0;
 			while (!queue.empty())
 			{
 				auto& callback = queue.front();
 				callback();
 				queue.pop();
+				count++;
 			}
+			return count;
 		}
 	}
 
 	extern bool g_EngineRunning;
 
 	Engine::Engine(const EngineCreateInfo& createInfo)
-		: m_CreateInfo(createInfo), m_VSync(createInfo.VSync)
+		: m_CreateInfo(createInfo), m_VSync(createInfo.VSync), m_FixedDeltaTime(createInfo.FixedDeltaTime)
 	{
 		FLUX_VERIFY(!s_Instance);
 		s_Instance = this;
 
 		m_EventThreadID = Platform::GetCurrentThreadID();
 
+		Profiler::Init();
+
 		Platform::SetConsoleTitle("Flux Engine");
 		Platform::SetThreadName(Platform::GetCurrentThread(), "Event Thread");
+		Profiler::SetThreadName(m_EventThreadID, "Event Thread");
 		Platform::SetThreadPriority(Platform::GetCurrentThread(), ThreadPriority::Lowest);
 
-		m_EventQueue = Ref<EventQueue>::Create();
-		m_EventQueue->SetEventCallback([this](Event& event)
+		m_EventCallback = [this](Event& event)
 		{
 			FLUX_CHECK_IS_IN_MAIN_THREAD();
 
@@ -50,6 +57,11 @@ namespace Flux {
 			{
 				m_Minimized = event.IsMinimized();
 			});
+			handler.Bind<WindowFocusEvent>([this](WindowFocusEvent& event)
+			{
+				if (event.GetWindow() == m_MainWindow)
+					m_Focused = event.IsFocused();
+			});
 			handler.Bind<WindowResizeEvent>([this](WindowResizeEvent& event)
 			{
 				if (event.GetWidth() == 0 || event.GetHeight() == 0)
@@ -63,14 +75,20 @@ namespace Flux {
 				// Resize viewport
 				if (m_SwapchainFramebuffer)
 					m_SwapchainFramebuffer->Resize(event.GetWidth(), event.GetHeight());
-				if (m_ImGuiFramebuffer)
-					m_ImGuiFramebuffer->Resize(event.GetWidth(), event.GetHeight());
 			});
 
 			OnEvent(event);
 
 			if (m_ImGuiRenderer)
 				m_ImGuiRenderer->OnEvent(event);
+		};
+
+		m_EventQueue = Ref<EventQueue>::Create();
+		m_EventQueue->SetEventCallback([this](Event& event)
+		{
+			// Live input is ignored while an input recording is replayed
+			if (InputRecorder::OnEvent(event))
+				m_EventCallback(event);
 		});
 
 		if (false && createInfo.ShowSplashScreen)
@@ -96,6 +114,8 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_EVENT_THREAD();
 
+		Profiler::Shutdown();
+
 		s_Instance = nullptr;
 
 		g_EngineRunning = m_RestartOnClose;
@@ -180,6 +200,9 @@ namespace Flux {
 
 		m_Running = false;
 		m_RestartOnClose = restart;
+
+		// The event thread may be waiting for a message
+		Platform::PostEmptyEvent();
 	}
 
 	void Engine::SubmitToEventThread(std::function<void()> function, bool wait)
@@ -193,8 +216,21 @@ namespace Flux {
 
 	void Engine::SubmitToMainThread(std::function<void()> function)
 	{
-		std::lock_guard<std::mutex> lock(m_MainThreadMutex);
-		m_MainThreadQueue.push(std::move(function));
+		{
+			std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+			m_MainThreadQueue.push(std::move(function));
+		}
+
+		// The main thread may be waiting for events
+		if (m_EventQueue)
+			m_EventQueue->Wake();
+	}
+
+	void Engine::RequestRedraw(uint32 frameCount)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_RedrawFrameCount = Math::Max(m_RedrawFrameCount, frameCount);
 	}
 
 	void Engine::MainLoop()
@@ -202,7 +238,10 @@ namespace Flux {
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
 		Renderer::Init(m_RenderThread ? 2 : 1);
+		FrameMemory::Init(Renderer::GetQueueCount());
 		Input::Init();
+		InputRecorder::Init();
+		JobSystem::Init();
 
 		const TextureFormat swapchainTextureFormat = TextureFormat::RGBA32;
 
@@ -210,14 +249,7 @@ namespace Flux {
 		{
 			// Initialize ImGui
 			m_ImGuiRenderer = Ref<ImGuiRenderer>::Create();
-
-			FramebufferCreateInfo framebufferCreateInfo;
-			framebufferCreateInfo.Attachments = { swapchainTextureFormat };
-			framebufferCreateInfo.ClearColorBuffer = m_CreateInfo.ClearImGuiPass;
-			framebufferCreateInfo.ClearDepthBuffer = m_CreateInfo.ClearImGuiPass;
-			framebufferCreateInfo.DepthClearValue = 1.0f;
-			framebufferCreateInfo.SwapchainTarget = true;
-			m_ImGuiFramebuffer = Framebuffer::Create(framebufferCreateInfo);
+			m_ImGuiRenderGraph = Ref<RenderGraph>::Create("ImGui");
 		}
 
 		FramebufferCreateInfo framebufferCreateInfo;
@@ -233,24 +265,35 @@ namespace Flux {
 		{
 			if (m_SplashScreenWindow)
 				m_SplashScreenWindow->SetVisible(false);
-			if (m_MainWindow)
+			if (m_MainWindow && !m_CreateInfo.Headless)
 				m_MainWindow->SetVisible(true); 
 		});
 
+		bool replayingFromCreateInfo = false;
+		if (!m_CreateInfo.InputReplayPath.empty())
+		{
+			replayingFromCreateInfo = InputRecorder::StartReplay(m_CreateInfo.InputReplayPath);
+			if (!replayingFromCreateInfo)
+				Close();
+		}
+
 		m_LastTime = Platform::GetTime();
 
 		while (m_Running)
 		{
+			FLUX_PROFILE_FRAME();
+
+			uint64 frameStartTime = Platform::GetNanoTime();
+
 			m_CurrentTime = Platform::GetTime();
 			m_DeltaTime = Math::Min(m_CurrentTime - m_LastTime, m_MaxDeltaTime);
 			m_LastTime = m_CurrentTime;
 
+			// Every run of a replay simulates the same frames
+			if (InputRecorder::IsReplaying())
+				m_DeltaTime = InputRecorder::GetReplayDeltaTime();
+
 			m_Accumulator += m_DeltaTime;
-			while (m_Accumulator > m_FixedDeltaTime)
-			{
-				m_TickCounter++;
-				m_Accumulator -= m_FixedDeltaTime;
-			}
 
 			m_FrameCounter++;
 			m_EventCounter += m_EventQueue->GetEventCount();
@@ -265,36 +308,57 @@ namespace Flux {
 				m_LastFrameTime = m_CurrentTime;
 			}
 
-			Utils::ExecuteQueue(m_MainThreadQueue, m_MainThreadMutex);
+			if (Utils::ExecuteQueue(m_MainThreadQueue, m_MainThreadMutex) > 0)
+				RequestRedraw();
 
 			Renderer::BeginFrame();
+			FrameMemory::BeginFrame(Renderer::GetCurrentQueueIndex());
 
 			Input::OnUpdate();
 
+			InputRecorder::BeginFrame(m_DeltaTime, m_MainWindow, m_EventCallback);
+
+			if (m_EventQueue->GetEventCount() > 0)
+				RequestRedraw();
 			m_EventQueue->DispatchEvents();
 
+			if (replayingFromCreateInfo && !InputRecorder::IsReplaying())
+			{
+				replayingFromCreateInfo = false;
+				Close();
+			}
+
 			if (!m_Minimized)
 			{
-				OnUpdate();
+				FixedUpdate();
+
+				{
+					FLUX_PROFILE_SCOPE("Engine::OnUpdate");
+					OnUpdate();
+				}
 
 				if (m_ImGuiRenderer)
 				{
-					m_ImGuiRenderer->NewFrame();
-					OnImGuiRender();
+					{
+						FLUX_PROFILE_SCOPE("Engine::OnImGuiRender");
+						m_ImGuiRenderer->NewFrame();
+						OnImGuiRender();
+					}
 				
-					m_ImGuiFramebuffer->Bind();
-					m_ImGuiRenderer->Render();
-					m_ImGuiFramebuffer->Unbind();
+					RenderImGui();
 				}
 			}
 			else
 			{
-				Platform::Sleep(0.2f);
+				// The simulation is paused while minimized
+				m_Accumulator = 0.0f;
 			}
 
 			// Wait for the previous frame to finish
 			if (m_RenderThread && Renderer::GetQueueCount() > 1)
 			{
+				FLUX_PROFILE_SCOPE("Engine::WaitForRenderThread");
+
 				uint64 start = Platform::GetNanoTime();
 				m_RenderThread->Wait();
 				uint64 end = Platform::GetNanoTime();
@@ -327,6 +391,8 @@ namespace Flux {
 
 			if (m_RenderThread && Renderer::GetQueueCount() == 1)
 			{
+				FLUX_PROFILE_SCOPE("Engine::WaitForRenderThread");
+
 				uint64 start = Platform::GetNanoTime();
 				m_RenderThread->Wait();
 				uint64 end = Platform::GetNanoTime();
@@ -335,6 +401,13 @@ namespace Flux {
 			}
 
 			Renderer::EndFrame();
+			Memory::EndFrame();
+
+#ifdef FLUX_MATH_DEBUG_ENABLED
+			MathDebug::EndFrame();
+#endif
+
+			PaceFrame(frameStartTime);
 		}
 
 		OnShutdown();
@@ -345,10 +418,10 @@ namespace Flux {
 			m_SwapchainFramebuffer = nullptr;
 		}
 
-		if (m_ImGuiFramebuffer)
+		if (m_ImGuiRenderGraph)
 		{
-			FLUX_VERIFY(m_ImGuiFramebuffer->GetReferenceCount() == 1);
-			m_ImGuiFramebuffer = nullptr;
+			FLUX_VERIFY(m_ImGuiRenderGraph->GetReferenceCount() == 1);
+			m_ImGuiRenderGraph = nullptr;
 		}
 
 		if (m_ImGuiRenderer)
@@ -372,8 +445,123 @@ namespace Flux {
 			Renderer::FlushReleaseQueue();
 		}
 
+		JobSystem::Shutdown();
+		InputRecorder::Shutdown();
 		Input::Shutdown();
 		Renderer::Shutdown();
+		FrameMemory::Shutdown();
+	}
+
+	void Engine::FixedUpdate()
+	{
+		FLUX_PROFILE_FUNC();
+
+		uint64 start = Platform::GetNanoTime();
+
+		uint32 stepCount = 0;
+		while (m_Accumulator >= m_FixedDeltaTime)
+		{
+			if (stepCount == m_CreateInfo.MaxFixedStepsPerFrame)
+			{
+				// The simulation can't keep up, running the missing steps would only make the next frame longer
+				uint32 droppedStepCount = static_cast<uint32>(m_Accumulator / m_FixedDeltaTime);
+				m_Accumulator -= droppedStepCount * m_FixedDeltaTime;
+				m_DroppedTickCount += droppedStepCount;
+				break;
+			}
+
+			OnFixedUpdate();
+
+			m_Accumulator -= m_FixedDeltaTime;
+			m_TickCounter++;
+			stepCount++;
+		}
+
+		m_FixedUpdateAlpha = Math::Clamp(m_Accumulator / m_FixedDeltaTime, 0.0f, 1.0f);
+
+		uint64 end = Platform::GetNanoTime();
+		m_FixedUpdateTime = float(end - start) * 0.001f * 0.001f;
+	}
+
+	void Engine::RenderImGui()
+	{
+		FLUX_PROFILE_FUNC();
+
+		m_ImGuiRenderGraph->Reset();
+
+		uint32 width = m_MainWindow->GetWidth();
+		uint32 height = m_MainWindow->GetHeight();
+
+		RenderGraphResource backbuffer = m_ImGuiRenderGraph->ImportBackbuffer("Backbuffer", { TextureFormat::RGBA32, width, height });
+		RenderGraphResource backbufferDepth = m_ImGuiRenderGraph->ImportBackbuffer("Backbuffer Depth", { TextureFormat::Depth24Stencil8, width, height });
+
+		m_ImGuiRenderGraph->AddPass("ImGui", [&](RenderGraphBuilder& builder)
+		{
+			// Otherwise ImGui is drawn on top of the frame of the runtime
+			RenderGraphWriteInfo writeInfo;
+			writeInfo.Clear = m_CreateInfo.ClearImGuiPass;
+			writeInfo.DepthClearValue = 1.0f;
+
+			builder.Write(backbuffer, writeInfo);
+			builder.Write(backbufferDepth, writeInfo);
+		},
+		[this](const RenderGraphPassContext&)
+		{
+			m_ImGuiRenderer->Render();
+		});
+
+		m_ImGuiRenderGraph->Execute();
+	}
+
+	void Engine::PaceFrame(uint64 frameStartTime)
+	{
+		FLUX_PROFILE_FUNC();
+
+		m_IdleTime = 0.0f;
+		m_FrameRateLimitWaitTime = 0.0f;
+
+		if (!m_Running)
+			return;
+
+		if (m_Minimized)
+		{
+			// Nothing is rendered, waking up on events keeps restoring the window responsive
+			uint64 start = Platform::GetNanoTime();
+			m_EventQueue->WaitForEvents(0.2f);
+			uint64 end = Platform::GetNanoTime();
+
+			m_IdleTime = float(end - start) * 0.001f * 0.001f;
+			return;
+		}
+
+		// Replays simulate every frame as fast as possible
+		if (InputRecorder::IsReplaying())
+			return;
+
+		if (m_CreateInfo.RenderOnDemand)
+		{
+			if (m_RedrawFrameCount == 0)
+			{
+				uint64 start = Platform::GetNanoTime();
+				m_EventQueue->WaitForEvents(s_MaxIdleTime);
+				uint64 end = Platform::GetNanoTime();
+
+				m_IdleTime = float(end - start) * 0.001f * 0.001f;
+				return;
+			}
+
+			m_RedrawFrameCount--;
+		}
+
+		float frameRateLimit = m_Focused ? m_CreateInfo.FrameRateLimit : m_CreateInfo.BackgroundFrameRateLimit;
+		if (frameRateLimit > 0.0f)
+		{
+			uint64 start = Platform::GetNanoTime();
+			Platform::SleepUntil(frameStartTime + static_cast<uint64>(1000.0 * 1000.0 * 1000.0 / frameRateLimit));
+			uint64 end = Platform::GetNanoTime();
+
+			m_FrameRateLimitWaitTime = float(end - start) * 0.001f * 0.001f;
+		}
 	}
 
 	BuildConfiguration Engine::GetBuildConfiguration()
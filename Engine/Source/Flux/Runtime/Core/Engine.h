@@ -9,6 +9,7 @@
 #include "Flux/Runtime/Renderer/GraphicsAPI.h"
 #include "Flux/Runtime/Renderer/GraphicsContext.h"
 #include "Flux/Runtime/Renderer/Framebuffer.h"
+#include "Flux/Runtime/Renderer/RenderGraph.h"
 
 #include "Flux/Runtime/ImGui/ImGuiRenderer.h"
 
@@ -25,6 +26,24 @@ namespace Flux {
 		bool MaximizeOnStart = false;
 		bool Multithreaded = true;
 		bool VSync = true;
+
+		// Frames per second while the main window is focused and while it isn't, 0 for no limit
+		float FrameRateLimit = 0.0f;
+		float BackgroundFrameRateLimit = 0.0f;
+		// Only renders frames while events arrive or redraws are requested (see Engine::RequestRedraw),
+		// the main thread sleeps until the next event otherwise
+		bool RenderOnDemand = false;
+
+		// Rate OnFixedUpdate runs at, independent of the frame rate
+		float FixedDeltaTime = 1.0f / 50.0f;
+		// Frames that fall further behind drop the remaining simulation time instead of
+		// running more steps, so a slow step can't make every following frame slower
+		uint32 MaxFixedStepsPerFrame = 5;
+
+		// Replays this input recording with a fixed delta time and closes once it's done (see InputRecorder)
+		std::filesystem::path InputReplayPath;
+		// The main window is never shown
+		bool Headless = false;
 	};
 
 	class Engine
@@ -38,6 +57,9 @@ namespace Flux {
 		void SubmitToEventThread(std::function<void()> function, bool wait);
 		void SubmitToMainThread(std::function<void()> function);
 
+		// Keeps rendering for a few more frames when rendering on demand, e.g. while something animates
+		void RequestRedraw(uint32 frameCount = s_RedrawFrameCount);
+
 		template<bool TWait = false>
 		void SubmitToEventThread(std::function<void()> function)
 		{
@@ -49,6 +71,10 @@ namespace Flux {
 
 		float GetTime() const { return m_CurrentTime; }
 		float GetDeltaTime() const { return m_DeltaTime; }
+		float GetFixedDeltaTime() const { return m_FixedDeltaTime; }
+
+		// How far the frame is between the last two fixed update steps, in [0, 1)
+		float GetFixedUpdateAlpha() const { return m_FixedUpdateAlpha; }
 
 		Ref<Window> GetMainWindow() const { return m_MainWindow; }
 		Ref<ImGuiRenderer> GetImGuiRenderer() const { return m_ImGuiRenderer; }
@@ -65,6 +91,7 @@ namespace Flux {
 	protected:
 		virtual void OnInit() {}
 		virtual void OnShutdown() {}
+		virtual void OnFixedUpdate() {}
 		virtual void OnUpdate() {}
 		virtual void OnImGuiRender() {}
 		virtual void OnEvent(Event& event) {}
@@ -73,7 +100,15 @@ namespace Flux {
 		void DestroyRendererContext();
 
 		void MainLoop();
+		void FixedUpdate();
+		void RenderImGui();
+		void PaceFrame(uint64 frameStartTime);
 	protected:
+		// Frames rendered after the last event, ImGui needs a few of them to settle
+		static constexpr uint32 s_RedrawFrameCount = 3;
+		// Longest time the main thread sleeps when rendering on demand
+		static constexpr float s_MaxIdleTime = 0.5f;
+
 		inline static Engine* s_Instance = nullptr;
 
 		EngineCreateInfo m_CreateInfo;
@@ -82,10 +117,11 @@ namespace Flux {
 		Ref<Window> m_MainWindow;
 
 		Ref<EventQueue> m_EventQueue;
+		EventCallback m_EventCallback;
 
 		Ref<GraphicsContext> m_Context;
 		Ref<Framebuffer> m_SwapchainFramebuffer;
-		Ref<Framebuffer> m_ImGuiFramebuffer;
+		Ref<RenderGraph> m_ImGuiRenderGraph;
 		Ref<ImGuiRenderer> m_ImGuiRenderer;
 
 		GraphicsAPI m_GraphicsAPI = GraphicsAPI::OpenGL;
@@ -106,6 +142,7 @@ namespace Flux {
 
 		std::atomic<bool> m_Running = true;
 		bool m_Minimized = false;
+		bool m_Focused = true;
 		bool m_RestartOnClose = false;
 
 		bool m_VSync = true;
@@ -114,6 +151,7 @@ namespace Flux {
 		float m_MaxDeltaTime = 1.0f / 30.0f;
 		float m_CurrentTime = 0.0f;
 		float m_Accumulator = 0.0f;
+		float m_FixedUpdateAlpha = 0.0f;
 		float m_LastTime = 0.0f;
 
 		float m_LastFrameTime = 0.0f;
@@ -124,7 +162,16 @@ namespace Flux {
 		uint32 m_TicksPerSecond = 0;
 		uint32 m_EventsPerSecond = 0;
 
+		// Fixed update steps skipped because a frame fell too far behind
+		uint64 m_DroppedTickCount = 0;
+		float m_FixedUpdateTime = 0.0f;
+
 		float m_RenderThreadWaitTime = 0.0f;
+
+		uint32 m_RedrawFrameCount = s_RedrawFrameCount;
+		// Time spent waiting for events and for the frame rate limit in the last frame
+		float m_IdleTime = 0.0f;
+		float m_FrameRateLimitWaitTime = 0.0f;
 	};
 
 #ifndef FLUX_BUILD_SHIPPING
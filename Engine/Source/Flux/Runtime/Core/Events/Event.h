@@ -11,6 +11,8 @@ namespace Flux {
 	class Event
 	{
 	public:
+		virtual ~Event() = default;
+
 		virtual EventType GetType() const = 0;
 
 		void SetHandled(bool handled) { m_Handled = handled; }
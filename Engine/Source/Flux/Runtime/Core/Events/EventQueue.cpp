@@ -1,43 +1,198 @@
 #include "FluxPCH.h"
 #include "EventQueue.h"
 
+#include "KeyEvent.h"
+#include "MouseEvent.h"
+#include "WindowEvent.h"
+
 namespace Flux {
 
+	static_assert(std::max({
+		sizeof(WindowCloseEvent), sizeof(WindowResizeEvent), sizeof(WindowMaximizeEvent), sizeof(WindowMinimizeEvent), sizeof(WindowFocusEvent), sizeof(WindowMenuEvent),
+		sizeof(KeyPressedEvent), sizeof(KeyReleasedEvent), sizeof(KeyTypedEvent),
+		sizeof(MouseButtonPressedEvent), sizeof(MouseButtonReleasedEvent), sizeof(MouseMovedEvent), sizeof(MouseScrolledEvent)
+	}) <= EventQueue::s_MaxEventSize, "EventQueue::s_MaxEventSize is smaller than the largest event");
+
+	static_assert((EventQueue::s_Capacity & (EventQueue::s_Capacity - 1)) == 0);
+
 	EventQueue::EventQueue()
 	{
+		for (uint32 i = 0; i < s_Capacity; i++)
+			m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
 	}
 
 	EventQueue::~EventQueue()
 	{
+		uint64 position = m_ReadPosition.load(std::memory_order_relaxed);
+		while (Slot* slot = GetReadySlot(position))
+		{
+			slot->GetEvent()->~Event();
+			position++;
+		}
 	}
 
 	void EventQueue::DispatchEvents()
 	{
-		std::lock_guard<std::mutex> lock(m_Mutex);
-		while (!m_EventQueue.empty())
+		uint64 droppedEventCount = m_DroppedEventCount.load(std::memory_order_relaxed);
+		if (droppedEventCount != m_ReportedDroppedEventCount)
+		{
+			FLUX_WARNING_CATEGORY("Event", "Event queue was full, dropped {0} events", droppedEventCount - m_ReportedDroppedEventCount);
+			m_ReportedDroppedEventCount = droppedEventCount;
+		}
+
+		uint64 position = m_ReadPosition.load(std::memory_order_relaxed);
+
+		while (Slot* slot = BeginRead(position))
 		{
-			auto& event = m_EventQueue.front();
-			m_EventCallback(*event.get());
-			m_EventQueue.pop();
+			Event* event = slot->GetEvent();
+
+			if (m_EventCallback)
+				m_EventCallback(*event);
+
+			event->~Event();
+
+			// Hands the slot back to the producers one lap later
+			slot->Sequence.store(position + s_Capacity, std::memory_order_release);
+			m_ReadPosition.store(++position, std::memory_order_relaxed);
 		}
 	}
 
-	void EventQueue::AddEvent(Shared<Event> event)
+	bool EventQueue::WaitForEvents(float timeout)
 	{
-		std::lock_guard<std::mutex> lock(m_Mutex);
-		m_EventQueue.push(event);
+		uint64 position = m_ReadPosition.load(std::memory_order_relaxed);
+
+		std::unique_lock<std::mutex> lock(m_WaitMutex);
+
+		// Pairs with the fence in NotifyConsumer, either the producer sees the flag or the slot is seen here
+		m_ConsumerWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		m_WaitCondVar.wait_for(lock, std::chrono::duration<float>(timeout), [this, position]()
+		{
+			return m_WakeRequested || GetReadySlot(position);
+		});
+
+		m_ConsumerWaiting.store(false, std::memory_order_relaxed);
+		m_WakeRequested = false;
+
+		return GetReadySlot(position) != nullptr;
+	}
+
+	void EventQueue::Wake()
+	{
+		std::lock_guard<std::mutex> lock(m_WaitMutex);
+		m_WakeRequested = true;
+		m_WaitCondVar.notify_one();
 	}
 
 	void EventQueue::SetEventCallback(const EventCallback& callback)
 	{
-		std::lock_guard<std::mutex> lock(m_Mutex);
 		m_EventCallback = callback;
 	}
 
-	uint32 EventQueue::GetEventCount()
+	uint32 EventQueue::GetEventCount() const
 	{
-		std::lock_guard<std::mutex> lock(m_Mutex);
-		return (uint32)m_EventQueue.size();
+		uint64 writePosition = m_WritePosition.load(std::memory_order_relaxed);
+		uint64 readPosition = m_ReadPosition.load(std::memory_order_relaxed);
+		return writePosition > readPosition ? static_cast<uint32>(writePosition - readPosition) : 0;
+	}
+
+	EventQueue::Slot* EventQueue::BeginWrite(const Event& event, uint64& position)
+	{
+		if (event.GetType() == EventType::MouseMoved)
+		{
+			if (Slot* slot = BeginCoalesce(event, position))
+				return slot;
+		}
+
+		position = m_WritePosition.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Slot& slot = m_Slots[position & (s_Capacity - 1)];
+			int64 difference = static_cast<int64>(slot.Sequence.load(std::memory_order_acquire) - position);
+
+			if (difference == 0)
+			{
+				if (m_WritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					return &slot;
+			}
+			else if (difference < 0)
+			{
+				// Full, the consumer hasn't dispatched the event of the previous lap yet.
+				// Never wait here, the consumer may itself be waiting on the producing thread.
+				m_DroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			else
+			{
+				position = m_WritePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void EventQueue::EndWrite(Slot& slot, uint64 position)
+	{
+		slot.Sequence.store(position + 1, std::memory_order_release);
+
+		if (slot.Type == EventType::MouseMoved)
+			m_LastMovePosition.store(position, std::memory_order_relaxed);
+
+		NotifyConsumer();
+	}
+
+	EventQueue::Slot* EventQueue::BeginCoalesce(const Event& event, uint64& position)
+	{
+		// Mouse positions are absolute, so the previous move can be replaced if nothing was added after it
+		position = m_LastMovePosition.load(std::memory_order_relaxed);
+		if (position == UINT64_MAX || m_WritePosition.load(std::memory_order_relaxed) != position + 1)
+			return nullptr;
+
+		// Takes the slot away from the consumer, fails if it's already being dispatched
+		Slot& slot = m_Slots[position & (s_Capacity - 1)];
+		uint64 sequence = position + 1;
+		if (!slot.Sequence.compare_exchange_strong(sequence, position, std::memory_order_acquire, std::memory_order_relaxed))
+			return nullptr;
+
+		auto& previousEvent = *reinterpret_cast<MouseMovedEvent*>(slot.Storage);
+		auto& nextEvent = static_cast<const MouseMovedEvent&>(event);
+		if (m_WritePosition.load(std::memory_order_relaxed) != position + 1 || previousEvent.GetWindow() != nextEvent.GetWindow())
+		{
+			slot.Sequence.store(position + 1, std::memory_order_release);
+			return nullptr;
+		}
+
+		previousEvent.~MouseMovedEvent();
+		m_CoalescedEventCount.fetch_add(1, std::memory_order_relaxed);
+		return &slot;
+	}
+
+	EventQueue::Slot* EventQueue::BeginRead(uint64 position)
+	{
+		// Takes the slot away from producers that want to overwrite the event in it
+		Slot& slot = m_Slots[position & (s_Capacity - 1)];
+		uint64 sequence = position + 1;
+		if (!slot.Sequence.compare_exchange_strong(sequence, position, std::memory_order_acquire, std::memory_order_relaxed))
+			return nullptr;
+		return &slot;
+	}
+
+	EventQueue::Slot* EventQueue::GetReadySlot(uint64 position)
+	{
+		Slot& slot = m_Slots[position & (s_Capacity - 1)];
+		if (slot.Sequence.load(std::memory_order_acquire) != position + 1)
+			return nullptr;
+		return &slot;
+	}
+
+	void EventQueue::NotifyConsumer()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!m_ConsumerWaiting.load(std::memory_order_relaxed))
+			return;
+
+		// Taking the lock makes sure the consumer is either still checking for events or already waiting
+		std::lock_guard<std::mutex> lock(m_WaitMutex);
+		m_WaitCondVar.notify_one();
 	}
 
 }
\ No newline at end of file
@@ -6,30 +6,99 @@ namespace Flux {
 
 	using EventCallback = std::function<void(Event&)>;
 
+	// Bounded multi producer, single consumer queue. Events are constructed in place in fixed size slots,
+	// so adding an event never allocates or blocks. A mouse move overwrites the previous one of the same window
+	// as long as it's the last event and hasn't been dispatched yet.
 	class EventQueue : public ReferenceCounted
 	{
 	public:
 		EventQueue();
 		virtual ~EventQueue();
 
+		// Consumer
 		void DispatchEvents();
+		// Blocks until an event is added, Wake is called or the timeout in seconds expires.
+		// Returns true if there are events to dispatch.
+		bool WaitForEvents(float timeout);
 
+		// Wakes up the consumer if it's waiting for events, from any thread
+		void Wake();
+
+		// Producers, the event is dropped and counted if the queue is full
 		template<typename T, typename... TArgs>
 		void AddEvent(TArgs&&... args)
 		{
 			static_assert(std::is_base_of<Event, T>::value);
-			AddEvent(CreateShared<T>(std::forward<TArgs>(args)...));
+			static_assert(sizeof(T) <= s_MaxEventSize && alignof(T) <= s_EventAlignment, "Event doesn't fit into an event queue slot");
+
+			T event(std::forward<TArgs>(args)...);
+
+			uint64 position;
+			Slot* slot = BeginWrite(event, position);
+			if (!slot)
+				return;
+
+			new(slot->Storage) T(std::move(event));
+			slot->Type = T::GetStaticType();
+			EndWrite(*slot, position);
 		}
 
+		// Must be set before any event is added
 		void SetEventCallback(const EventCallback& callback);
 
-		uint32 GetEventCount();
+		uint32 GetEventCount() const;
+		uint64 GetCoalescedEventCount() const { return m_CoalescedEventCount.load(std::memory_order_relaxed); }
+		uint64 GetDroppedEventCount() const { return m_DroppedEventCount.load(std::memory_order_relaxed); }
+
+		// Large enough for the largest event, checked in EventQueue.cpp
+		static constexpr uint32 s_MaxEventSize = 40;
+		static constexpr uint32 s_EventAlignment = 8;
+		static constexpr uint32 s_Capacity = 1024;
 	private:
-		void AddEvent(Shared<Event> event);
+		static constexpr uint32 s_CacheLineSize = 64;
+
+		struct Slot
+		{
+			// Equals the position once the slot is free, position + 1 once the event is written.
+			// Set back to the position while the consumer reads or a producer overwrites the event.
+			std::atomic<uint64> Sequence = 0;
+			EventType Type = EventType::None;
+			alignas(s_EventAlignment) uint8 Storage[s_MaxEventSize];
+
+			Event* GetEvent() { return reinterpret_cast<Event*>(Storage); }
+		};
+
+		Slot* BeginWrite(const Event& event, uint64& position);
+		void EndWrite(Slot& slot, uint64 position);
+		Slot* BeginCoalesce(const Event& event, uint64& position);
+
+		Slot* BeginRead(uint64 position);
+		Slot* GetReadySlot(uint64 position);
+
+		void NotifyConsumer();
 	private:
-		std::queue<Shared<Event>> m_EventQueue;
+		Slot m_Slots[s_Capacity];
+
+		// Padded onto separate cache lines instead of aligned, as reference counted objects are only 16 byte aligned
+		uint8 m_WritePadding[s_CacheLineSize];
+		std::atomic<uint64> m_WritePosition = 0;
+		uint8 m_ReadPadding[s_CacheLineSize - sizeof(std::atomic<uint64>)];
+		std::atomic<uint64> m_ReadPosition = 0;
+		uint8 m_EndPadding[s_CacheLineSize - sizeof(std::atomic<uint64>)];
+
 		EventCallback m_EventCallback;
-		std::mutex m_Mutex;
+
+		// Position of the last mouse move that was added, may already be dispatched
+		std::atomic<uint64> m_LastMovePosition = UINT64_MAX;
+		std::atomic<uint64> m_CoalescedEventCount = 0;
+		std::atomic<uint64> m_DroppedEventCount = 0;
+		uint64 m_ReportedDroppedEventCount = 0;
+
+		// Only touched by producers while the consumer is waiting
+		std::atomic<bool> m_ConsumerWaiting = false;
+		std::mutex m_WaitMutex;
+		std::condition_variable m_WaitCondVar;
+		bool m_WakeRequested = false;
 	};
 
 }
\ No newline at end of file
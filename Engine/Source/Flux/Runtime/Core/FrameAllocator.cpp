@@ -0,0 +1,168 @@
+#include "FluxPCH.h"
+#include "FrameAllocator.h"
+
+#include "Engine.h"
+
+namespace Flux {
+
+	FrameArena::FrameArena(uint64 capacity, MemoryTag tag)
+		: m_Capacity(capacity), m_InitialCapacity(capacity), m_Tag(tag)
+	{
+		m_Data = static_cast<uint8*>(Memory::Allocate(m_Capacity, m_Tag));
+	}
+
+	FrameArena::~FrameArena()
+	{
+		Reset();
+
+		Memory::Free(m_Data);
+		m_Data = nullptr;
+	}
+
+	void* FrameArena::Allocate(uint64 size, uint64 alignment)
+	{
+		FLUX_ASSERT(alignment <= s_Alignment, "Frame allocations can't be aligned to more than {0} bytes!", s_Alignment);
+
+		const uint64 alignedSize = (size + s_Alignment - 1) & ~(s_Alignment - 1);
+
+		// The offset keeps growing past the capacity, every later allocation overflows as well
+		uint64 offset = m_Offset.fetch_add(alignedSize, std::memory_order_relaxed);
+		if (offset + alignedSize <= m_Capacity)
+			return m_Data + offset;
+
+		std::lock_guard<std::mutex> lock(m_OverflowMutex);
+
+		OverflowBlock* block = static_cast<OverflowBlock*>(Memory::Allocate(sizeof(OverflowBlock) + alignedSize, m_Tag));
+		block->Next = m_OverflowBlocks;
+		m_OverflowBlocks = block;
+		m_OverflowSize += alignedSize;
+
+		return block + 1;
+	}
+
+	void FrameArena::Reset()
+	{
+		std::lock_guard<std::mutex> lock(m_OverflowMutex);
+
+		while (m_OverflowBlocks)
+		{
+			OverflowBlock* next = m_OverflowBlocks->Next;
+			Memory::Free(m_OverflowBlocks);
+			m_OverflowBlocks = next;
+		}
+
+		// Grow so that the next frame of the same size fits without overflowing
+		if (m_OverflowSize > 0)
+		{
+			uint64 capacity = m_Capacity;
+			while (capacity < m_Capacity + m_OverflowSize)
+				capacity *= 2;
+
+			FLUX_INFO_CATEGORY("Frame Memory", "Growing frame arena from {0} bytes to {1} bytes", m_Capacity, capacity);
+
+			Memory::Free(m_Data);
+			m_Data = static_cast<uint8*>(Memory::Allocate(capacity, m_Tag));
+			m_Capacity = capacity;
+
+			m_QuietResetCount = 0;
+			m_QuietPeakSize = 0;
+		}
+		else if (m_Capacity > m_InitialCapacity)
+		{
+			// Shrink back once the frames have used a quarter of the arena at most for a while,
+			// so a single large frame doesn't keep its memory for the rest of the process
+			uint64 usedSize = GetUsedSize();
+			if (usedSize <= m_Capacity / 4)
+			{
+				m_QuietPeakSize = Math::Max(m_QuietPeakSize, usedSize);
+				if (++m_QuietResetCount >= s_ShrinkResetCount)
+				{
+					uint64 capacity = m_Capacity;
+					while (capacity / 2 >= m_InitialCapacity && capacity / 2 >= m_QuietPeakSize * 2)
+						capacity /= 2;
+
+					FLUX_INFO_CATEGORY("Frame Memory", "Shrinking frame arena from {0} bytes to {1} bytes", m_Capacity, capacity);
+
+					Memory::Free(m_Data);
+					m_Data = static_cast<uint8*>(Memory::Allocate(capacity, m_Tag));
+					m_Capacity = capacity;
+
+					m_QuietResetCount = 0;
+					m_QuietPeakSize = 0;
+				}
+			}
+			else
+			{
+				m_QuietResetCount = 0;
+				m_QuietPeakSize = 0;
+			}
+		}
+
+		m_OverflowSize = 0;
+		m_Offset.store(0, std::memory_order_relaxed);
+	}
+
+	uint64 FrameArena::GetUsedSize() const
+	{
+		uint64 offset = m_Offset.load(std::memory_order_relaxed);
+		return offset < m_Capacity ? offset : m_Capacity;
+	}
+
+	struct FrameMemoryData
+	{
+		std::vector<Unique<FrameArena>> Arenas;
+		std::atomic<FrameArena*> CurrentArena = nullptr;
+
+		FrameMemoryStats LastStats;
+	};
+
+	static FrameMemoryData* s_Data = nullptr;
+
+	void FrameMemory::Init(uint32 frameCount, uint64 capacity)
+	{
+		FLUX_VERIFY(!s_Data);
+		FLUX_VERIFY(frameCount > 0);
+
+		s_Data = new FrameMemoryData();
+		for (uint32 i = 0; i < frameCount; i++)
+			s_Data->Arenas.push_back(CreateUnique<FrameArena>(capacity, MemoryTag::Frame));
+
+		s_Data->CurrentArena = s_Data->Arenas[0].get();
+	}
+
+	void FrameMemory::Shutdown()
+	{
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void FrameMemory::BeginFrame(uint32 frameIndex)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_VERIFY(frameIndex < s_Data->Arenas.size());
+
+		FrameArena* arena = s_Data->Arenas[frameIndex].get();
+
+		// The render commands of the frame that last used this arena have been executed at this point
+		s_Data->LastStats.UsedBytes = arena->GetUsedSize();
+		s_Data->LastStats.OverflowBytes = arena->GetOverflowSize();
+
+		arena->Reset();
+		s_Data->LastStats.Capacity = arena->GetCapacity();
+
+		s_Data->CurrentArena.store(arena, std::memory_order_release);
+	}
+
+	void* FrameMemory::Allocate(uint64 size, uint64 alignment)
+	{
+		FLUX_VERIFY(s_Data, "Frame memory is not initialized!");
+		return s_Data->CurrentArena.load(std::memory_order_acquire)->Allocate(size, alignment);
+	}
+
+	FrameMemoryStats FrameMemory::GetStats()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		return s_Data->LastStats;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "BaseTypes.h"
+#include "Memory.h"
+
+namespace Flux {
+
+	// Linear arena that is reset as a whole. Allocation is a single atomic add,
+	// so job system workers can allocate from it alongside the main thread.
+	// Allocations that don't fit go to the heap and the arena grows on the next reset.
+	// It shrinks again after many resets that used little of it.
+	class FrameArena
+	{
+	public:
+		FrameArena(uint64 capacity, MemoryTag tag);
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		void* Allocate(uint64 size, uint64 alignment);
+		void Reset();
+
+		uint64 GetUsedSize() const;
+		uint64 GetCapacity() const { return m_Capacity; }
+		uint64 GetOverflowSize() const { return m_OverflowSize; }
+
+		static constexpr uint64 s_Alignment = 16;
+	private:
+		// Resets in a row that used at most a quarter of the arena before it shrinks
+		static constexpr uint32 s_ShrinkResetCount = 300;
+
+		// Padded to the alignment so the allocation that follows the header stays aligned
+		struct alignas(s_Alignment) OverflowBlock
+		{
+			OverflowBlock* Next;
+		};
+	private:
+		uint8* m_Data = nullptr;
+		uint64 m_Capacity = 0;
+		uint64 m_InitialCapacity = 0;
+		std::atomic<uint64> m_Offset = 0;
+
+		std::mutex m_OverflowMutex;
+		OverflowBlock* m_OverflowBlocks = nullptr;
+		uint64 m_OverflowSize = 0;
+
+		uint32 m_QuietResetCount = 0;
+		uint64 m_QuietPeakSize = 0;
+
+		MemoryTag m_Tag;
+	};
+
+	struct FrameMemoryStats
+	{
+		// Of the last completed frame that used the same arena
+		uint64 UsedBytes = 0;
+		uint64 OverflowBytes = 0;
+		uint64 Capacity = 0;
+	};
+
+	// One arena per frame in flight, indexed like the render command queues.
+	// Frame memory stays valid until the same frame index begins again, so it may be
+	// referenced by render commands of its frame, but must not be kept across frames.
+	// Only the main thread and job system workers may allocate from it, never the render thread.
+	class FrameMemory
+	{
+	public:
+		static void Init(uint32 frameCount, uint64 capacity = 4 * 1024 * 1024);
+		static void Shutdown();
+
+		static void BeginFrame(uint32 frameIndex);
+
+		static void* Allocate(uint64 size, uint64 alignment = FrameArena::s_Alignment);
+
+		template<typename T, typename... TArgs>
+		static T* New(TArgs&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "Frame memory is never destructed!");
+			return new(Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+		}
+
+		static FrameMemoryStats GetStats();
+	};
+
+	// Stateless STL allocator on top of FrameMemory, deallocate is a no-op
+	template<typename T>
+	class FrameAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameAllocator() = default;
+
+		template<typename TOther>
+		FrameAllocator(const FrameAllocator<TOther>&) {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(FrameMemory::Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* memory, size_t count)
+		{
+		}
+
+		template<typename TOther>
+		bool operator==(const FrameAllocator<TOther>&) const { return true; }
+		template<typename TOther>
+		bool operator!=(const FrameAllocator<TOther>&) const { return false; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+	namespace Utils {
+
+		template<typename... TArgs>
+		FrameString FrameFormat(fmt::format_string<TArgs...> format, TArgs&&... args)
+		{
+			FrameString result;
+			fmt::format_to(std::back_inserter(result), format, std::forward<TArgs>(args)...);
+			return result;
+		}
+
+	}
+
+}
\ No newline at end of file
@@ -22,6 +22,10 @@ namespace Flux {
 
 		uint32 GetHash() const { return (uint32)CityHash64((char*)this, sizeof(Guid)); }
 
+		// CoCreateGuid only fixes the version and variant bits, which are stored in m_B and m_C,
+		// so the remaining words are already random and just need to be spread over 64 bits
+		uint64 GetFastHash() const { return ((uint64)m_A << 32 | m_D) * 0x9E3779B97F4A7C15ull; }
+
 		bool IsValid() const
 		{
 			return (m_A | m_B | m_C | m_D) != 0;
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "Guid.h"
+
+namespace Flux {
+
+	// Open addressing hash map from Guid to T (Robin Hood probing, backward shift deletion).
+	// Keys and values are stored inline in a single slot array.
+	// Unlike std::unordered_map, inserting or erasing may move other elements,
+	// so references and iterators are only valid until the map is modified.
+	template<typename T>
+	class GuidMap
+	{
+	public:
+		using ValueType = std::pair<Guid, T>;
+
+		template<bool IsConst>
+		class IteratorBase
+		{
+		public:
+			using MapType = std::conditional_t<IsConst, const GuidMap, GuidMap>;
+			using Reference = std::conditional_t<IsConst, const ValueType&, ValueType&>;
+			using Pointer = std::conditional_t<IsConst, const ValueType*, ValueType*>;
+
+			IteratorBase(MapType* map, size_t index, size_t steps = s_UnknownSteps)
+				: m_Map(map), m_Index(index), m_Steps(steps)
+			{
+				SkipEmptySlots();
+			}
+
+			Reference operator*() const { return m_Map->m_Slots[m_Index]; }
+			Pointer operator->() const { return &m_Map->m_Slots[m_Index]; }
+
+			IteratorBase& operator++()
+			{
+				Step();
+				SkipEmptySlots();
+				return *this;
+			}
+
+			bool operator==(const IteratorBase& other) const { return m_Index == other.m_Index && m_Map == other.m_Map; }
+			bool operator!=(const IteratorBase& other) const { return !(*this == other); }
+		private:
+			void SkipEmptySlots()
+			{
+				while (m_Index < m_Map->m_Distances.size() && m_Map->m_Distances[m_Index] == 0)
+					Step();
+			}
+
+			// Iteration wraps around the end of the slots and stops after visiting every slot once
+			void Step()
+			{
+				const size_t capacity = m_Map->m_Distances.size();
+
+				// Iterators returned by find only need to know where the iteration started once they're advanced
+				if (m_Steps == s_UnknownSteps)
+					m_Steps = (m_Index - m_Map->GetIterationStart()) & (capacity - 1);
+
+				m_Steps++;
+				m_Index = m_Steps < capacity ? (m_Index + 1) & (capacity - 1) : capacity;
+			}
+		private:
+			static constexpr size_t s_UnknownSteps = ~0ull;
+
+			MapType* m_Map;
+			size_t m_Index;
+			// Slots visited since the start of the iteration
+			size_t m_Steps;
+
+			friend class GuidMap;
+		};
+
+		using Iterator = IteratorBase<false>;
+		using ConstIterator = IteratorBase<true>;
+	public:
+		GuidMap() = default;
+
+		Iterator begin() { return Iterator(this, GetIterationStart(), 0); }
+		Iterator end() { return Iterator(this, m_Distances.size(), 0); }
+		ConstIterator begin() const { return ConstIterator(this, GetIterationStart(), 0); }
+		ConstIterator end() const { return ConstIterator(this, m_Distances.size(), 0); }
+
+		Iterator find(const Guid& key) { return Iterator(this, FindIndex(key)); }
+		ConstIterator find(const Guid& key) const { return ConstIterator(this, FindIndex(key)); }
+
+		bool contains(const Guid& key) const { return FindIndex(key) != m_Distances.size(); }
+
+		T& at(const Guid& key)
+		{
+			size_t index = FindIndex(key);
+			FLUX_VERIFY(index != m_Distances.size(), "Guid {0} not found!", key.ToString());
+			return m_Slots[index].second;
+		}
+
+		const T& at(const Guid& key) const
+		{
+			size_t index = FindIndex(key);
+			FLUX_VERIFY(index != m_Distances.size(), "Guid {0} not found!", key.ToString());
+			return m_Slots[index].second;
+		}
+
+		T& operator[](const Guid& key)
+		{
+			return try_emplace(key).first->second;
+		}
+
+		template<typename... TArgs>
+		std::pair<Iterator, bool> try_emplace(const Guid& key, TArgs&&... args)
+		{
+			size_t index = FindIndex(key);
+			if (index != m_Distances.size())
+				return { Iterator(this, index), false };
+
+			if ((m_Size + 1) * 8 > m_Distances.size() * 7)
+				Rehash(m_Distances.empty() ? s_MinCapacity : m_Distances.size() * 2);
+
+			index = InsertUnique(ValueType(key, T(std::forward<TArgs>(args)...)));
+			return { Iterator(this, index), true };
+		}
+
+		std::pair<Iterator, bool> insert(const ValueType& value)
+		{
+			return try_emplace(value.first, value.second);
+		}
+
+		// Bulk insert, grows the map at most once
+		template<typename InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			reserve(m_Size + static_cast<size_t>(std::distance(first, last)));
+
+			for (auto it = first; it != last; ++it)
+				try_emplace(it->first, it->second);
+		}
+
+		size_t erase(const Guid& key)
+		{
+			size_t index = FindIndex(key);
+			if (index == m_Distances.size())
+				return 0;
+
+			EraseIndex(index);
+			return 1;
+		}
+
+		Iterator erase(Iterator it)
+		{
+			// The following element is shifted back into this slot. It hasn't been visited yet, as the backward
+			// shift never moves the element in the slot the iteration started at.
+			EraseIndex(it.m_Index);
+			return Iterator(this, it.m_Index, it.m_Steps);
+		}
+
+		void reserve(size_t count)
+		{
+			size_t capacity = s_MinCapacity;
+			while (capacity * 7 < count * 8)
+				capacity *= 2;
+
+			if (capacity > m_Distances.size())
+				Rehash(capacity);
+		}
+
+		void clear()
+		{
+			m_Slots.clear();
+			m_Distances.clear();
+			m_Size = 0;
+			m_Shift = 64;
+		}
+
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+		size_t capacity() const { return m_Distances.size(); }
+	private:
+		// First slot that is empty or holds an element in its home slot. Backward shifts never move such an element
+		// to the slot before it, so erasing while iterating from here never moves an element that was already visited.
+		size_t GetIterationStart() const
+		{
+			size_t index = 0;
+			while (index < m_Distances.size() && m_Distances[index] > 1)
+				index++;
+			return index;
+		}
+
+		size_t GetHomeIndex(const Guid& key) const
+		{
+			return static_cast<size_t>(key.GetFastHash() >> m_Shift);
+		}
+
+		size_t FindIndex(const Guid& key) const
+		{
+			if (m_Size == 0)
+				return m_Distances.size();
+
+			const size_t mask = m_Distances.size() - 1;
+
+			// Robin Hood invariant: the key can't be further away than the
+			// probe distance of the element currently occupying the slot
+			size_t index = GetHomeIndex(key);
+			for (uint32 distance = 1; m_Distances[index] >= distance; distance++)
+			{
+				if (m_Slots[index].first == key)
+					return index;
+
+				index = (index + 1) & mask;
+			}
+			return m_Distances.size();
+		}
+
+		size_t InsertUnique(ValueType&& value)
+		{
+			const size_t mask = m_Distances.size() - 1;
+
+			size_t resultIndex = m_Distances.size();
+			size_t index = GetHomeIndex(value.first);
+			uint32 distance = 1;
+
+			while (true)
+			{
+				if (m_Distances[index] == 0)
+				{
+					m_Distances[index] = distance;
+					m_Slots[index] = std::move(value);
+					m_Size++;
+					return resultIndex != m_Distances.size() ? resultIndex : index;
+				}
+
+				// Take the slot from elements closer to their home slot
+				if (m_Distances[index] < distance)
+				{
+					std::swap(distance, m_Distances[index]);
+					std::swap(value, m_Slots[index]);
+
+					if (resultIndex == m_Distances.size())
+						resultIndex = index;
+				}
+
+				index = (index + 1) & mask;
+				distance++;
+			}
+		}
+
+		void EraseIndex(size_t index)
+		{
+			const size_t mask = m_Distances.size() - 1;
+
+			size_t nextIndex = (index + 1) & mask;
+			while (m_Distances[nextIndex] > 1)
+			{
+				m_Slots[index] = std::move(m_Slots[nextIndex]);
+				m_Distances[index] = m_Distances[nextIndex] - 1;
+
+				index = nextIndex;
+				nextIndex = (nextIndex + 1) & mask;
+			}
+
+			m_Slots[index] = ValueType();
+			m_Distances[index] = 0;
+			m_Size--;
+		}
+
+		void Rehash(size_t capacity)
+		{
+			FLUX_ASSERT((capacity & (capacity - 1)) == 0);
+
+			std::vector<ValueType> slots(capacity);
+			std::vector<uint32> distances(capacity, 0);
+			std::swap(slots, m_Slots);
+			std::swap(distances, m_Distances);
+
+			m_Size = 0;
+			m_Shift = 64;
+			for (size_t i = capacity; i > 1; i >>= 1)
+				m_Shift--;
+
+			for (size_t i = 0; i < distances.size(); i++)
+			{
+				if (distances[i] != 0)
+					InsertUnique(std::move(slots[i]));
+			}
+		}
+	private:
+		static constexpr size_t s_MinCapacity = 16;
+
+		std::vector<ValueType> m_Slots;
+		// Probe distance + 1 of each slot, 0 for empty slots
+		std::vector<uint32> m_Distances;
+
+		size_t m_Size = 0;
+		uint32 m_Shift = 64;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <city.h>
+
+namespace Flux {
+
+	namespace Utils {
+
+		inline void HashCombine(uint64& hash, const void* data, size_t size)
+		{
+			hash = Hash128to64(uint128(hash, CityHash64((const char*)data, size)));
+		}
+
+		template<typename T>
+		inline void HashCombine(uint64& hash, const T& value)
+		{
+			// Only for types without padding, padding bytes aren't initialized
+			static_assert(std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>);
+			HashCombine(hash, &value, sizeof(T));
+		}
+
+	}
+
+}
\ No newline at end of file
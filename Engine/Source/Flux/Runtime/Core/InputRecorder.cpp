@@ -0,0 +1,487 @@
+#include "FluxPCH.h"
+#include "InputRecorder.h"
+
+#include "Engine.h"
+
+#include "Events/KeyEvent.h"
+#include "Events/MouseEvent.h"
+
+namespace Flux {
+
+	static constexpr uint32 s_InputRecordingMagic = 0x504E4946; // "FINP"
+	static constexpr uint32 s_InputRecordingVersion = 1;
+
+#pragma pack(push, 1)
+	struct InputRecordingHeader
+	{
+		uint32 Magic = s_InputRecordingMagic;
+		uint32 Version = s_InputRecordingVersion;
+		uint32 FrameCount = 0;
+		uint32 EventCount = 0;
+		// Mouse positions are only meaningful for a main window of the same size
+		uint32 WindowWidth = 0;
+		uint32 WindowHeight = 0;
+	};
+
+	// Followed by the events of the frame
+	struct InputRecordingFrame
+	{
+		float DeltaTime;
+		uint32 EventCount;
+	};
+
+	struct InputRecordingEvent
+	{
+		EventType Type;
+		// Key, mouse button or code point
+		uint32 Code;
+		float X;
+		float Y;
+	};
+#pragma pack(pop)
+
+	struct InputRecorderData
+	{
+		// Recording
+		bool Recording = false;
+		std::ofstream RecordingStream;
+		InputRecordingHeader RecordingHeader;
+		std::vector<InputRecordingEvent> FrameEvents;
+		float FrameDeltaTime = 0.0f;
+		bool FrameStarted = false;
+
+		// Replay
+		bool Replaying = false;
+		std::filesystem::path ReplayPath;
+		InputRecordingHeader ReplayHeader;
+		std::vector<InputRecordingFrame> ReplayFrames;
+		std::vector<InputRecordingEvent> ReplayEvents;
+		uint32 ReplayFrameIndex = 0;
+		uint64 ReplayEventIndex = 0;
+		float ReplayDeltaTime = 0.0f;
+		uint64 ReplayStartTime = 0;
+		uint64 ReplayFrameStartTime = 0;
+		std::vector<float> ReplayFrameTimes;
+
+		std::optional<InputReplayResult> ReplayResult;
+	};
+
+	static InputRecorderData* s_Data = nullptr;
+
+	namespace Utils {
+
+		static bool IsInputEvent(EventType type)
+		{
+			switch (type)
+			{
+			case EventType::KeyPressed:
+			case EventType::KeyReleased:
+			case EventType::KeyTyped:
+			case EventType::MouseButtonPressed:
+			case EventType::MouseButtonReleased:
+			case EventType::MouseMoved:
+			case EventType::MouseScrolled:
+				return true;
+			}
+			return false;
+		}
+
+		static InputRecordingEvent SerializeInputEvent(Event& event)
+		{
+			InputRecordingEvent result = { event.GetType(), 0, 0.0f, 0.0f };
+
+			EventHandler handler(event);
+			handler.Bind<KeyPressedEvent>([&](KeyPressedEvent& event) { result.Code = static_cast<uint32>(event.GetKey()); });
+			handler.Bind<KeyReleasedEvent>([&](KeyReleasedEvent& event) { result.Code = static_cast<uint32>(event.GetKey()); });
+			handler.Bind<KeyTypedEvent>([&](KeyTypedEvent& event) { result.Code = static_cast<uint32>(event.GetCodePoint()); });
+			handler.Bind<MouseButtonPressedEvent>([&](MouseButtonPressedEvent& event) { result.Code = static_cast<uint32>(event.GetButton()); });
+			handler.Bind<MouseButtonReleasedEvent>([&](MouseButtonReleasedEvent& event) { result.Code = static_cast<uint32>(event.GetButton()); });
+			handler.Bind<MouseMovedEvent>([&](MouseMovedEvent& event) { result.X = event.GetX(); result.Y = event.GetY(); });
+			handler.Bind<MouseScrolledEvent>([&](MouseScrolledEvent& event) { result.X = event.GetX(); result.Y = event.GetY(); });
+
+			return result;
+		}
+
+		static void DispatchInputEvent(const InputRecordingEvent& recordedEvent, Ref<Window> window, const EventCallback& callback)
+		{
+			switch (recordedEvent.Type)
+			{
+			case EventType::KeyPressed:
+			{
+				KeyPressedEvent event(window, static_cast<KeyCode>(recordedEvent.Code));
+				callback(event);
+				break;
+			}
+			case EventType::KeyReleased:
+			{
+				KeyReleasedEvent event(window, static_cast<KeyCode>(recordedEvent.Code));
+				callback(event);
+				break;
+			}
+			case EventType::KeyTyped:
+			{
+				KeyTypedEvent event(window, static_cast<char32>(recordedEvent.Code));
+				callback(event);
+				break;
+			}
+			case EventType::MouseButtonPressed:
+			{
+				MouseButtonPressedEvent event(window, static_cast<MouseButtonCode>(recordedEvent.Code));
+				callback(event);
+				break;
+			}
+			case EventType::MouseButtonReleased:
+			{
+				MouseButtonReleasedEvent event(window, static_cast<MouseButtonCode>(recordedEvent.Code));
+				callback(event);
+				break;
+			}
+			case EventType::MouseMoved:
+			{
+				MouseMovedEvent event(window, recordedEvent.X, recordedEvent.Y);
+				callback(event);
+				break;
+			}
+			case EventType::MouseScrolled:
+			{
+				MouseScrolledEvent event(window, recordedEvent.X, recordedEvent.Y);
+				callback(event);
+				break;
+			}
+			}
+		}
+
+		static float GetFrameTimePercentile(const std::vector<float>& sortedFrameTimes, float percentile)
+		{
+			size_t index = static_cast<size_t>(percentile * static_cast<float>(sortedFrameTimes.size() - 1) + 0.5f);
+			return sortedFrameTimes[std::min(index, sortedFrameTimes.size() - 1)];
+		}
+
+	}
+
+	void InputRecorder::Init()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		s_Data = new InputRecorderData();
+	}
+
+	void InputRecorder::Shutdown()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		StopRecording();
+		StopReplay();
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool InputRecorder::StartRecording(const std::filesystem::path& path)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		if (s_Data->Replaying)
+		{
+			FLUX_WARNING_CATEGORY("Input Recorder", "Can't record while replaying");
+			return false;
+		}
+
+		StopRecording();
+
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path());
+
+		s_Data->RecordingStream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!s_Data->RecordingStream)
+		{
+			FLUX_ERROR_CATEGORY("Input Recorder", "Failed to open '{0}'", path.string());
+			return false;
+		}
+
+		s_Data->RecordingHeader = {};
+		if (Ref<Window> window = Engine::Get().GetMainWindow())
+		{
+			s_Data->RecordingHeader.WindowWidth = window->GetWidth();
+			s_Data->RecordingHeader.WindowHeight = window->GetHeight();
+		}
+
+		// Rewritten with the final counts once the recording stops
+		s_Data->RecordingStream.write(reinterpret_cast<const char*>(&s_Data->RecordingHeader), sizeof(InputRecordingHeader));
+
+		s_Data->Recording = true;
+		s_Data->FrameStarted = false;
+		s_Data->FrameEvents.clear();
+
+		FLUX_INFO_CATEGORY("Input Recorder", "Recording input to '{0}'", path.string());
+		return true;
+	}
+
+	void InputRecorder::StopRecording()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		if (!s_Data->Recording)
+			return;
+
+		auto& stream = s_Data->RecordingStream;
+		auto& header = s_Data->RecordingHeader;
+
+		if (s_Data->FrameStarted)
+		{
+			InputRecordingFrame frame = { s_Data->FrameDeltaTime, static_cast<uint32>(s_Data->FrameEvents.size()) };
+			stream.write(reinterpret_cast<const char*>(&frame), sizeof(InputRecordingFrame));
+			stream.write(reinterpret_cast<const char*>(s_Data->FrameEvents.data()), s_Data->FrameEvents.size() * sizeof(InputRecordingEvent));
+
+			header.FrameCount++;
+			header.EventCount += frame.EventCount;
+		}
+
+		stream.seekp(0);
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(InputRecordingHeader));
+		stream.close();
+
+		s_Data->Recording = false;
+		s_Data->FrameEvents.clear();
+
+		FLUX_INFO_CATEGORY("Input Recorder", "Recorded {0} frames with {1} events", header.FrameCount, header.EventCount);
+	}
+
+	bool InputRecorder::IsRecording()
+	{
+		return s_Data->Recording;
+	}
+
+	bool InputRecorder::StartReplay(const std::filesystem::path& path, float deltaTime)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		if (s_Data->Recording)
+		{
+			FLUX_WARNING_CATEGORY("Input Recorder", "Can't replay while recording");
+			return false;
+		}
+
+		StopReplay();
+
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		if (!stream)
+		{
+			FLUX_ERROR_CATEGORY("Input Recorder", "Failed to open '{0}'", path.string());
+			return false;
+		}
+
+		auto& header = s_Data->ReplayHeader;
+		stream.read(reinterpret_cast<char*>(&header), sizeof(InputRecordingHeader));
+		if (!stream || header.Magic != s_InputRecordingMagic || header.Version != s_InputRecordingVersion)
+		{
+			FLUX_ERROR_CATEGORY("Input Recorder", "'{0}' is not a supported input recording", path.string());
+			return false;
+		}
+
+		// The counts have to fit into the rest of the file before anything is allocated for them
+		std::streamoff dataOffset = stream.tellg();
+		stream.seekg(0, std::ios::end);
+		uint64 dataSize = static_cast<uint64>(stream.tellg() - dataOffset);
+		stream.seekg(dataOffset);
+
+		if (static_cast<uint64>(header.FrameCount) > dataSize / sizeof(InputRecordingFrame) ||
+			static_cast<uint64>(header.EventCount) > (dataSize - header.FrameCount * sizeof(InputRecordingFrame)) / sizeof(InputRecordingEvent))
+		{
+			FLUX_ERROR_CATEGORY("Input Recorder", "'{0}' is truncated", path.string());
+			return false;
+		}
+
+		s_Data->ReplayFrames.resize(header.FrameCount);
+		s_Data->ReplayEvents.resize(header.EventCount);
+
+		uint64 eventOffset = 0;
+		for (auto& frame : s_Data->ReplayFrames)
+		{
+			stream.read(reinterpret_cast<char*>(&frame), sizeof(InputRecordingFrame));
+			if (!stream || eventOffset + frame.EventCount > header.EventCount)
+				break;
+
+			stream.read(reinterpret_cast<char*>(s_Data->ReplayEvents.data() + eventOffset), frame.EventCount * sizeof(InputRecordingEvent));
+			eventOffset += frame.EventCount;
+		}
+
+		if (!stream || eventOffset != header.EventCount)
+		{
+			FLUX_ERROR_CATEGORY("Input Recorder", "'{0}' is truncated", path.string());
+			s_Data->ReplayFrames.clear();
+			s_Data->ReplayEvents.clear();
+			return false;
+		}
+
+		if (Ref<Window> window = Engine::Get().GetMainWindow())
+		{
+			if (window->GetWidth() != header.WindowWidth || window->GetHeight() != header.WindowHeight)
+				FLUX_WARNING_CATEGORY("Input Recorder", "Recorded with a {0}x{1} window, replaying with {2}x{3}", header.WindowWidth, header.WindowHeight, window->GetWidth(), window->GetHeight());
+		}
+
+		s_Data->Replaying = true;
+		s_Data->ReplayPath = path;
+		s_Data->ReplayFrameIndex = 0;
+		s_Data->ReplayEventIndex = 0;
+		s_Data->ReplayDeltaTime = deltaTime;
+		s_Data->ReplayStartTime = 0;
+		s_Data->ReplayFrameStartTime = 0;
+		s_Data->ReplayFrameTimes.clear();
+		s_Data->ReplayFrameTimes.reserve(header.FrameCount);
+		s_Data->ReplayResult.reset();
+
+		FLUX_INFO_CATEGORY("Input Recorder", "Replaying {0} frames from '{1}' with a delta time of {2}ms", header.FrameCount, path.string(), deltaTime * 1000.0f);
+		return true;
+	}
+
+	void InputRecorder::StopReplay()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		if (!s_Data->Replaying)
+			return;
+
+		s_Data->Replaying = false;
+		s_Data->ReplayFrames.clear();
+		s_Data->ReplayEvents.clear();
+	}
+
+	bool InputRecorder::IsReplaying()
+	{
+		return s_Data->Replaying;
+	}
+
+	float InputRecorder::GetReplayDeltaTime()
+	{
+		return s_Data->ReplayDeltaTime;
+	}
+
+	uint32 InputRecorder::GetReplayFrameIndex()
+	{
+		return s_Data->ReplayFrameIndex;
+	}
+
+	uint32 InputRecorder::GetReplayFrameCount()
+	{
+		return s_Data->ReplayHeader.FrameCount;
+	}
+
+	const std::optional<InputReplayResult>& InputRecorder::GetReplayResult()
+	{
+		return s_Data->ReplayResult;
+	}
+
+	void InputRecorder::BeginFrame(float deltaTime, Ref<Window> window, const EventCallback& callback)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		if (s_Data->Recording)
+		{
+			if (s_Data->FrameStarted)
+			{
+				auto& stream = s_Data->RecordingStream;
+
+				InputRecordingFrame frame = { s_Data->FrameDeltaTime, static_cast<uint32>(s_Data->FrameEvents.size()) };
+				stream.write(reinterpret_cast<const char*>(&frame), sizeof(InputRecordingFrame));
+				stream.write(reinterpret_cast<const char*>(s_Data->FrameEvents.data()), s_Data->FrameEvents.size() * sizeof(InputRecordingEvent));
+
+				s_Data->RecordingHeader.FrameCount++;
+				s_Data->RecordingHeader.EventCount += frame.EventCount;
+			}
+
+			s_Data->FrameStarted = true;
+			s_Data->FrameDeltaTime = deltaTime;
+			s_Data->FrameEvents.clear();
+		}
+
+		if (s_Data->Replaying)
+		{
+			uint64 time = Platform::GetNanoTime();
+			if (s_Data->ReplayFrameIndex > 0)
+				s_Data->ReplayFrameTimes.push_back(float(time - s_Data->ReplayFrameStartTime) * 0.001f * 0.001f);
+			else
+				s_Data->ReplayStartTime = time;
+
+			s_Data->ReplayFrameStartTime = time;
+
+			// The last frame has been measured
+			if (s_Data->ReplayFrameIndex == s_Data->ReplayFrames.size())
+			{
+				EndReplay();
+				return;
+			}
+
+			const auto& frame = s_Data->ReplayFrames[s_Data->ReplayFrameIndex++];
+			for (uint32 i = 0; i < frame.EventCount; i++)
+				Utils::DispatchInputEvent(s_Data->ReplayEvents[s_Data->ReplayEventIndex++], window, callback);
+		}
+	}
+
+	bool InputRecorder::OnEvent(Event& event)
+	{
+		if (!s_Data || !Utils::IsInputEvent(event.GetType()))
+			return true;
+
+		if (s_Data->Replaying)
+			return false;
+
+		if (s_Data->Recording && s_Data->FrameStarted)
+			s_Data->FrameEvents.push_back(Utils::SerializeInputEvent(event));
+
+		return true;
+	}
+
+	void InputRecorder::EndReplay()
+	{
+		auto& frameTimes = s_Data->ReplayFrameTimes;
+
+		InputReplayResult result;
+		result.Path = s_Data->ReplayPath;
+		result.FrameCount = static_cast<uint32>(frameTimes.size());
+		result.DeltaTime = s_Data->ReplayDeltaTime;
+		result.TotalTime = float(s_Data->ReplayFrameStartTime - s_Data->ReplayStartTime) * 0.001f * 0.001f * 0.001f;
+
+		if (!frameTimes.empty())
+		{
+			// Written in frame order, so runs of different builds can be compared frame by frame
+			std::filesystem::path csvPath = s_Data->ReplayPath;
+			csvPath.replace_filename(csvPath.stem().string() + "_FrameTimes.csv");
+
+			std::ofstream stream(csvPath);
+			if (stream)
+			{
+				stream << "Frame,FrameTime\n";
+				for (size_t i = 0; i < frameTimes.size(); i++)
+					stream << fmt::format("{0},{1:.4f}\n", i, frameTimes[i]);
+			}
+			else
+			{
+				FLUX_ERROR_CATEGORY("Input Recorder", "Failed to open '{0}'", csvPath.string());
+			}
+
+			double totalFrameTime = 0.0;
+			for (float frameTime : frameTimes)
+				totalFrameTime += frameTime;
+
+			std::vector<float> sortedFrameTimes = frameTimes;
+			std::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+
+			result.AverageFrameTime = static_cast<float>(totalFrameTime / double(frameTimes.size()));
+			result.MinFrameTime = sortedFrameTimes.front();
+			result.MaxFrameTime = sortedFrameTimes.back();
+			result.MedianFrameTime = Utils::GetFrameTimePercentile(sortedFrameTimes, 0.5f);
+			result.P95FrameTime = Utils::GetFrameTimePercentile(sortedFrameTimes, 0.95f);
+			result.P99FrameTime = Utils::GetFrameTimePercentile(sortedFrameTimes, 0.99f);
+		}
+
+		FLUX_INFO_CATEGORY("Input Recorder", "Replay of '{0}' ({1} frames, {2}s)", result.Path.string(), result.FrameCount, result.TotalTime);
+		FLUX_INFO_CATEGORY("Input Recorder", "  Average: {0}ms", result.AverageFrameTime);
+		FLUX_INFO_CATEGORY("Input Recorder", "  Min: {0}ms, Max: {1}ms", result.MinFrameTime, result.MaxFrameTime);
+		FLUX_INFO_CATEGORY("Input Recorder", "  Median: {0}ms, 95th: {1}ms, 99th: {2}ms", result.MedianFrameTime, result.P95FrameTime, result.P99FrameTime);
+
+		s_Data->ReplayResult = result;
+		StopReplay();
+	}
+
+}
\ No newline at end of file
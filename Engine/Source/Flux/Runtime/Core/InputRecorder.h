@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Window.h"
+
+namespace Flux {
+
+	struct InputReplayResult
+	{
+		std::filesystem::path Path;
+		uint32 FrameCount = 0;
+		// Every replayed frame simulates this much time
+		float DeltaTime = 0.0f;
+
+		// Wall clock frame times in milliseconds
+		float AverageFrameTime = 0.0f;
+		float MinFrameTime = 0.0f;
+		float MaxFrameTime = 0.0f;
+		float MedianFrameTime = 0.0f;
+		float P95FrameTime = 0.0f;
+		float P99FrameTime = 0.0f;
+
+		// Seconds
+		float TotalTime = 0.0f;
+	};
+
+	// Records the key and mouse events dispatched by the engine per frame, and replays them on later runs.
+	// Replays run with a fixed delta time, so the same frames are simulated on every run and build,
+	// and the wall clock time of every replayed frame is measured.
+	// All events are replayed on the main window, window events are never recorded.
+	class InputRecorder
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static bool StartRecording(const std::filesystem::path& path);
+		static void StopRecording();
+		static bool IsRecording();
+
+		static bool StartReplay(const std::filesystem::path& path, float deltaTime = 1.0f / 60.0f);
+		static void StopReplay();
+		static bool IsReplaying();
+		static float GetReplayDeltaTime();
+		static uint32 GetReplayFrameIndex();
+		static uint32 GetReplayFrameCount();
+
+		// Set once a replay has played all of its frames
+		static const std::optional<InputReplayResult>& GetReplayResult();
+
+		// Called by the engine once per frame before events are dispatched.
+		// Live input events are ignored while replaying, the recorded events of the frame are dispatched instead.
+		static void BeginFrame(float deltaTime, Ref<Window> window, const EventCallback& callback);
+
+		// Called by the engine for every live event, returns false if the event must not be dispatched
+		static bool OnEvent(Event& event);
+	private:
+		static void EndReplay();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "FluxPCH.h"
+#include "JobSystem.h"
+
+namespace Flux {
+
+	struct QueuedJob
+	{
+		Job Function;
+		JobCounter* Counter;
+	};
+
+	struct JobSystemData
+	{
+		std::vector<Unique<Thread>> Workers;
+
+		std::deque<QueuedJob> Jobs;
+		std::condition_variable JobsCondVar;
+		std::mutex JobsMutex;
+
+		bool Running = false;
+	};
+
+	static JobSystemData* s_Data = nullptr;
+
+	void JobSystem::Init(uint32 workerCount)
+	{
+		FLUX_VERIFY(!s_Data);
+
+		if (workerCount == 0)
+		{
+			// Leave room for the event, main and render threads
+			uint32 processorCount = std::thread::hardware_concurrency();
+			workerCount = processorCount > 4 ? processorCount - 3 : 1;
+		}
+
+		s_Data = new JobSystemData();
+		s_Data->Running = true;
+
+		for (uint32 i = 0; i < workerCount; i++)
+		{
+			ThreadCreateInfo createInfo;
+			createInfo.Name = fmt::format("Worker Thread {0}", i);
+			createInfo.Priority = ThreadPriority::Normal;
+
+			auto& worker = s_Data->Workers.emplace_back(Thread::Create(createInfo));
+			worker->Submit(FLUX_BIND_CALLBACK(WorkerLoop));
+		}
+
+		FLUX_INFO_CATEGORY("Job System", "Initialized with {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_Data->JobsMutex);
+			s_Data->Running = false;
+		}
+		s_Data->JobsCondVar.notify_all();
+
+		// Joins the worker threads
+		s_Data->Workers.clear();
+
+		FLUX_VERIFY(s_Data->Jobs.empty());
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void JobSystem::Execute(JobCounter& counter, Job job)
+	{
+		counter.Value.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data->JobsMutex);
+			s_Data->Jobs.push_back({ std::move(job), &counter });
+		}
+		s_Data->JobsCondVar.notify_one();
+	}
+
+	void JobSystem::Dispatch(JobCounter& counter, uint32 jobCount, uint32 groupSize, DispatchJob job)
+	{
+		if (jobCount == 0)
+			return;
+
+		FLUX_VERIFY(groupSize > 0);
+
+		const uint32 groupCount = (jobCount + groupSize - 1) / groupSize;
+		counter.Value.fetch_add(groupCount, std::memory_order_relaxed);
+
+		auto sharedJob = CreateShared<DispatchJob>(std::move(job));
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data->JobsMutex);
+			for (uint32 groupIndex = 0; groupIndex < groupCount; groupIndex++)
+			{
+				const uint32 begin = groupIndex * groupSize;
+				const uint32 end = Math::Min(begin + groupSize, jobCount);
+
+				s_Data->Jobs.push_back({ [sharedJob, begin, end]() { (*sharedJob)(begin, end); }, &counter });
+			}
+		}
+		s_Data->JobsCondVar.notify_all();
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!ExecuteNextJob())
+				Platform::Sleep(0.0f);
+		}
+	}
+
+	uint32 JobSystem::GetWorkerCount()
+	{
+		return static_cast<uint32>(s_Data->Workers.size());
+	}
+
+	bool JobSystem::ExecuteNextJob()
+	{
+		QueuedJob job;
+		{
+			std::lock_guard<std::mutex> lock(s_Data->JobsMutex);
+			if (s_Data->Jobs.empty())
+				return false;
+
+			job = std::move(s_Data->Jobs.front());
+			s_Data->Jobs.pop_front();
+		}
+
+		{
+			FLUX_PROFILE_SCOPE("JobSystem::Job");
+			job.Function();
+		}
+		job.Counter->Value.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void JobSystem::WorkerLoop()
+	{
+		while (true)
+		{
+			QueuedJob job;
+			{
+				std::unique_lock<std::mutex> lock(s_Data->JobsMutex);
+				s_Data->JobsCondVar.wait(lock, []() { return !s_Data->Jobs.empty() || !s_Data->Running; });
+
+				if (s_Data->Jobs.empty())
+					break;
+
+				job = std::move(s_Data->Jobs.front());
+				s_Data->Jobs.pop_front();
+			}
+
+			{
+				FLUX_PROFILE_SCOPE("JobSystem::Job");
+				job.Function();
+			}
+			job.Counter->Value.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Thread.h"
+
+namespace Flux {
+
+	struct JobCounter
+	{
+		std::atomic<uint32> Value = 0;
+
+		bool IsDone() const { return Value.load(std::memory_order_acquire) == 0; }
+	};
+
+	using DispatchJob = std::function<void(uint32 begin, uint32 end)>;
+
+	class JobSystem
+	{
+	public:
+		static void Init(uint32 workerCount = 0);
+		static void Shutdown();
+
+		static void Execute(JobCounter& counter, Job job);
+		static void Dispatch(JobCounter& counter, uint32 jobCount, uint32 groupSize, DispatchJob job);
+
+		// Executes pending jobs on the calling thread until the counter reaches zero,
+		// so it is safe to wait from inside a job.
+		static void Wait(const JobCounter& counter);
+
+		static uint32 GetWorkerCount();
+	private:
+		static bool ExecuteNextJob();
+		static void WorkerLoop();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Flux/Runtime/Core/BaseTypes.h"
+
+// Layout of binary logs (.flog), shared with the fluxlogdump tool, so this header must not depend on the engine.
+// The file starts with a BinaryLogHeader followed by entries, each one is a BinaryLogEntryType and the matching struct.
+// Sites (format string, category and argument types of a log call) and threads are written once,
+// before the first message that references them. Messages only store the site ID and the raw argument bytes.
+
+namespace Flux {
+
+	inline constexpr uint32 s_BinaryLogMagic = 0x474F4C46; // "FLOG"
+	inline constexpr uint32 s_BinaryLogVersion = 1;
+
+	enum class BinaryLogEntryType : uint8
+	{
+		Site = 0,
+		Thread,
+		Message,
+		DroppedMessages
+	};
+
+	// Arguments are stored as their raw bytes, strings as a uint32 size followed by the characters.
+	// Custom types are formatted by the engine and written as strings.
+	enum class LogArgumentType : uint8
+	{
+		Bool = 0,
+		Char,
+		Int8,
+		Int16,
+		Int32,
+		Int64,
+		UInt8,
+		UInt16,
+		UInt32,
+		UInt64,
+		Float,
+		Double,
+		Pointer,
+		String,
+		Custom
+	};
+
+	// Indexed by LogVerbosity
+	inline constexpr const char* s_BinaryLogVerbosityNames[] = { "Trace", "Debug", "Info", "Warning", "Error", "Critical" };
+
+#pragma pack(push, 1)
+	struct BinaryLogHeader
+	{
+		uint32 Magic = s_BinaryLogMagic;
+		uint32 Version = s_BinaryLogVersion;
+		// Nanoseconds since the epoch of std::chrono::system_clock
+		int64 StartTime = 0;
+	};
+
+	// Followed by the category, the format string and one LogArgumentType per argument
+	struct BinaryLogSite
+	{
+		uint32 SiteID;
+		uint16 CategorySize;
+		uint32 FormatSize;
+		uint8 ArgumentCount;
+	};
+
+	// Followed by the thread name
+	struct BinaryLogThread
+	{
+		uint32 ThreadID;
+		uint16 NameSize;
+	};
+
+	// Followed by the arguments
+	struct BinaryLogMessage
+	{
+		uint32 SiteID;
+		uint32 ThreadID;
+		int64 Time;
+		uint8 Verbosity;
+		uint32 ArgumentsSize;
+	};
+
+	struct BinaryLogDroppedMessages
+	{
+		int64 Time;
+		uint64 Count;
+	};
+#pragma pack(pop)
+
+}
\ No newline at end of file
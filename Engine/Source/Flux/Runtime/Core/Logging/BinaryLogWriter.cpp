@@ -0,0 +1,190 @@
+#include "FluxPCH.h"
+#include "BinaryLogWriter.h"
+
+namespace Flux {
+
+	namespace Utils {
+
+		static int64 ToBinaryLogTime(std::chrono::system_clock::time_point time)
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+		}
+
+	}
+
+	BinaryLogWriter::BinaryLogWriter(const std::filesystem::path& path)
+	{
+		m_Stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!m_Stream)
+			return;
+
+		BinaryLogHeader header;
+		header.StartTime = Utils::ToBinaryLogTime(std::chrono::system_clock::now());
+		WriteBytes(&header, sizeof(BinaryLogHeader));
+		WriteBuffer();
+	}
+
+	BinaryLogWriter::~BinaryLogWriter()
+	{
+		EndPass();
+		Flush();
+	}
+
+	void BinaryLogWriter::Write(const LogRecord& record, const uint8* arguments, ThreadID threadID, std::string_view threadName)
+	{
+		if (!IsOpen())
+			return;
+
+		WriteThread(threadID, threadName);
+
+		auto& pendingMessage = m_PendingMessages.emplace_back();
+		pendingMessage.Message.SiteID = GetSiteID(record);
+		pendingMessage.Message.ThreadID = static_cast<uint32>(threadID);
+		pendingMessage.Message.Time = Utils::ToBinaryLogTime(record.Time);
+		pendingMessage.Message.Verbosity = static_cast<uint8>(record.Verbosity);
+		pendingMessage.ArgumentsOffset = m_PendingArguments.size();
+
+		// Custom arguments are formatted here, everything else already has its binary representation
+		if (record.Descriptor->HasCustomArguments)
+			record.Descriptor->BinaryFunction(arguments, m_PendingArguments);
+		else
+			m_PendingArguments.insert(m_PendingArguments.end(), arguments, arguments + record.ArgumentsSize);
+
+		pendingMessage.Message.ArgumentsSize = static_cast<uint32>(m_PendingArguments.size() - pendingMessage.ArgumentsOffset);
+
+		if (record.Verbosity >= LogVerbosity::Warning)
+			m_FlushPending = true;
+	}
+
+	void BinaryLogWriter::WriteText(std::chrono::system_clock::time_point time, LogVerbosity verbosity, ThreadID threadID, std::string_view threadName, std::string_view text)
+	{
+		std::vector<uint8> arguments(Utils::LogArgument<std::string_view>::GetSize(text));
+		uint8* argumentsData = arguments.data();
+		Utils::LogArgument<std::string_view>::Encode(argumentsData, text);
+
+		LogRecord record;
+		record.Descriptor = &Utils::LogRecordDescriptorStorage<std::string_view>::Descriptor;
+		record.Format = "{}";
+		record.Category = {};
+		record.Time = time;
+		record.ArgumentsSize = static_cast<uint32>(arguments.size());
+		record.Verbosity = verbosity;
+
+		Write(record, arguments.data(), threadID, threadName);
+	}
+
+	void BinaryLogWriter::WriteDroppedMessages(std::chrono::system_clock::time_point time, uint64 count)
+	{
+		if (!IsOpen())
+			return;
+
+		BinaryLogDroppedMessages entry;
+		entry.Time = Utils::ToBinaryLogTime(time);
+		entry.Count = count;
+		WriteEntry(BinaryLogEntryType::DroppedMessages, entry);
+		WriteBuffer();
+	}
+
+	void BinaryLogWriter::EndPass()
+	{
+		if (!IsOpen())
+			return;
+
+		std::stable_sort(m_PendingMessages.begin(), m_PendingMessages.end(), [](const PendingMessage& a, const PendingMessage& b)
+		{
+			return a.Message.Time < b.Message.Time;
+		});
+
+		for (auto& pendingMessage : m_PendingMessages)
+		{
+			WriteEntry(BinaryLogEntryType::Message, pendingMessage.Message);
+			WriteBytes(m_PendingArguments.data() + pendingMessage.ArgumentsOffset, pendingMessage.Message.ArgumentsSize);
+		}
+
+		m_PendingMessages.clear();
+		m_PendingArguments.clear();
+
+		WriteBuffer();
+
+		// Same as the text log, warnings and errors make it to the disk right away
+		if (m_FlushPending)
+			Flush();
+	}
+
+	void BinaryLogWriter::Flush()
+	{
+		if (!IsOpen())
+			return;
+
+		m_Stream.flush();
+		m_FlushPending = false;
+	}
+
+	uint32 BinaryLogWriter::GetSiteID(const LogRecord& record)
+	{
+		SiteKey key = { record.Format.data(), record.Category.data(), record.Descriptor };
+
+		auto it = m_Sites.find(key);
+		if (it != m_Sites.end())
+			return it->second;
+
+		uint32 siteID = static_cast<uint32>(m_Sites.size());
+		m_Sites[key] = siteID;
+
+		const LogRecordDescriptor& descriptor = *record.Descriptor;
+
+		BinaryLogSite entry;
+		entry.SiteID = siteID;
+		entry.CategorySize = static_cast<uint16>(std::min<size_t>(record.Category.size(), UINT16_MAX));
+		entry.FormatSize = static_cast<uint32>(record.Format.size());
+		entry.ArgumentCount = descriptor.ArgumentCount;
+		WriteEntry(BinaryLogEntryType::Site, entry);
+
+		WriteBytes(record.Category.data(), entry.CategorySize);
+		WriteBytes(record.Format.data(), entry.FormatSize);
+
+		for (uint8 i = 0; i < descriptor.ArgumentCount; i++)
+		{
+			LogArgumentType type = descriptor.ArgumentTypes[i];
+			if (type == LogArgumentType::Custom)
+				type = LogArgumentType::String;
+
+			m_Buffer.push_back(static_cast<uint8>(type));
+		}
+
+		return siteID;
+	}
+
+	void BinaryLogWriter::WriteThread(ThreadID threadID, std::string_view threadName)
+	{
+		// Thread IDs are reused, the name is written again if a new thread shows up with a known ID
+		auto it = m_Threads.find(threadID);
+		if (it != m_Threads.end() && it->second == threadName)
+			return;
+
+		m_Threads[threadID] = threadName;
+
+		BinaryLogThread entry;
+		entry.ThreadID = static_cast<uint32>(threadID);
+		entry.NameSize = static_cast<uint16>(std::min<size_t>(threadName.size(), UINT16_MAX));
+		WriteEntry(BinaryLogEntryType::Thread, entry);
+		WriteBytes(threadName.data(), entry.NameSize);
+	}
+
+	void BinaryLogWriter::WriteBytes(const void* data, size_t size)
+	{
+		const uint8* bytes = static_cast<const uint8*>(data);
+		m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+	}
+
+	void BinaryLogWriter::WriteBuffer()
+	{
+		if (m_Buffer.empty())
+			return;
+
+		m_Stream.write(reinterpret_cast<const char*>(m_Buffer.data()), m_Buffer.size());
+		m_WrittenSize += m_Buffer.size();
+		m_Buffer.clear();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Logger.h"
+
+namespace Flux {
+
+	// Writes log records in the binary log format (see BinaryLogFormat.h), not thread safe
+	class BinaryLogWriter
+	{
+	public:
+		BinaryLogWriter(const std::filesystem::path& path);
+		~BinaryLogWriter();
+
+		// Messages are buffered until EndPass, so the messages of all threads are written in the order they were logged
+		void Write(const LogRecord& record, const uint8* arguments, ThreadID threadID, std::string_view threadName);
+		void WriteText(std::chrono::system_clock::time_point time, LogVerbosity verbosity, ThreadID threadID, std::string_view threadName, std::string_view text);
+		void WriteDroppedMessages(std::chrono::system_clock::time_point time, uint64 count);
+
+		void EndPass();
+		void Flush();
+
+		bool IsOpen() const { return m_Stream.is_open(); }
+		uint64 GetWrittenSize() const { return m_WrittenSize; }
+	private:
+		uint32 GetSiteID(const LogRecord& record);
+		void WriteThread(ThreadID threadID, std::string_view threadName);
+
+		template<typename T>
+		void WriteEntry(BinaryLogEntryType type, const T& entry)
+		{
+			m_Buffer.push_back(static_cast<uint8>(type));
+			WriteBytes(&entry, sizeof(T));
+		}
+
+		void WriteBytes(const void* data, size_t size);
+		void WriteBuffer();
+	private:
+		std::ofstream m_Stream;
+		uint64 m_WrittenSize = 0;
+
+		struct SiteKey
+		{
+			const char* Format;
+			const char* Category;
+			const LogRecordDescriptor* Descriptor;
+
+			bool operator==(const SiteKey& other) const = default;
+		};
+
+		struct SiteKeyHash
+		{
+			size_t operator()(const SiteKey& key) const
+			{
+				size_t hash = std::hash<const void*>()(key.Format);
+				hash ^= std::hash<const void*>()(key.Category) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				hash ^= std::hash<const void*>()(key.Descriptor) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				return hash;
+			}
+		};
+
+		std::unordered_map<SiteKey, uint32, SiteKeyHash> m_Sites;
+		std::unordered_map<ThreadID, std::string> m_Threads;
+
+		struct PendingMessage
+		{
+			BinaryLogMessage Message;
+			uint64 ArgumentsOffset;
+		};
+
+		std::vector<PendingMessage> m_PendingMessages;
+		std::vector<uint8> m_PendingArguments;
+		bool m_FlushPending = false;
+
+		std::vector<uint8> m_Buffer;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "FluxPCH.h"
+#include "LogBenchmark.h"
+
+namespace Flux {
+
+	LogBenchmarkResult LogBenchmark::Run(uint32 threadCount, uint32 messagesPerThread, LogOverflowPolicy overflowPolicy)
+	{
+		LogBenchmarkResult result;
+		result.ThreadCount = threadCount;
+		result.MessagesPerThread = messagesPerThread;
+		result.OverflowPolicy = overflowPolicy;
+
+		LogOverflowPolicy previousOverflowPolicy = Logger::GetOverflowPolicy();
+		Logger::SetOverflowPolicy(overflowPolicy);
+		Logger::Flush();
+
+		uint64 droppedMessages = Logger::GetDroppedMessageCount();
+
+		std::vector<Unique<Thread>> threads;
+		std::atomic<uint32> readyThreads = 0;
+		std::atomic<bool> start = false;
+
+		for (uint32 i = 0; i < threadCount; i++)
+		{
+			ThreadCreateInfo createInfo;
+			createInfo.Name = fmt::format("Log Benchmark Thread {0}", i);
+
+			auto& thread = threads.emplace_back(Thread::Create(createInfo));
+			thread->Submit([&readyThreads, &start, messagesPerThread, i]()
+			{
+				readyThreads.fetch_add(1, std::memory_order_release);
+				while (!start.load(std::memory_order_acquire))
+					std::this_thread::yield();
+
+				for (uint32 j = 0; j < messagesPerThread; j++)
+					FLUX_INFO_CATEGORY("Log Benchmark", "Thread {0}: message {1} ({2:.3f})", i, j, j * 0.5f);
+			});
+		}
+
+		while (readyThreads.load(std::memory_order_acquire) < threadCount)
+			std::this_thread::yield();
+
+		uint64 startTime = Platform::GetNanoTime();
+		start.store(true, std::memory_order_release);
+
+		for (auto& thread : threads)
+			thread->Wait();
+
+		uint64 logEndTime = Platform::GetNanoTime();
+
+		Logger::Flush();
+
+		uint64 flushEndTime = Platform::GetNanoTime();
+
+		// Joins the threads
+		threads.clear();
+
+		Logger::SetOverflowPolicy(previousOverflowPolicy);
+
+		result.LogTime = float(logEndTime - startTime) * 0.001f * 0.001f;
+		result.FlushTime = float(flushEndTime - startTime) * 0.001f * 0.001f;
+		result.MessagesPerSecond = float(threadCount) * float(messagesPerThread) / (result.LogTime * 0.001f);
+		result.DroppedMessages = Logger::GetDroppedMessageCount() - droppedMessages;
+
+		FLUX_INFO_CATEGORY("Log Benchmark", "{0} threads, {1} messages each ({2})", threadCount, messagesPerThread, overflowPolicy == LogOverflowPolicy::Block ? "Block" : "Drop");
+		FLUX_INFO_CATEGORY("Log Benchmark", "  Logging: {0}ms ({1:.0f} messages/s)", result.LogTime, result.MessagesPerSecond);
+		FLUX_INFO_CATEGORY("Log Benchmark", "  Written: {0}ms", result.FlushTime);
+		FLUX_INFO_CATEGORY("Log Benchmark", "  Dropped: {0} messages", result.DroppedMessages);
+
+		return result;
+	}
+
+}
\ No newline at end of file
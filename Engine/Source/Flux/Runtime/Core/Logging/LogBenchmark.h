@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Logger.h"
+
+namespace Flux {
+
+	struct LogBenchmarkResult
+	{
+		uint32 ThreadCount = 0;
+		uint32 MessagesPerThread = 0;
+		LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::Block;
+
+		// Until every thread has logged its messages
+		float LogTime = 0.0f;
+		// Until every message has been written
+		float FlushTime = 0.0f;
+
+		float MessagesPerSecond = 0.0f;
+		uint64 DroppedMessages = 0;
+	};
+
+	class LogBenchmark
+	{
+	public:
+		static LogBenchmarkResult Run(uint32 threadCount = 8, uint32 messagesPerThread = 10000, LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Block);
+	};
+
+}
\ No newline at end of file
@@ -2,27 +2,56 @@
 
 #include "Logger.h"
 
-#ifndef FLUX_BUILD_SHIPPING
+// Messages below this LogVerbosity are compiled out
+#ifndef FLUX_LOG_MIN_VERBOSITY
+	#ifndef FLUX_BUILD_SHIPPING
+		#define FLUX_LOG_MIN_VERBOSITY 0
+	#else
+		#define FLUX_LOG_MIN_VERBOSITY 2
+	#endif
+#endif
+
+#if FLUX_LOG_MIN_VERBOSITY <= 0
 	#define FLUX_TRACE_ENABLED
 #endif
 
+// The arguments of disabled categories are not evaluated
+#define FLUX_LOG_CATEGORY_IMPL(category, verbosity, ...) do { if constexpr (::Flux::Utils::IsLogCategoryEnabled(category)) ::Flux::Logger::LogCategory(category, verbosity, __VA_ARGS__); } while (false)
+
 #ifdef FLUX_TRACE_ENABLED
 	#define FLUX_TRACE(...) ::Flux::Logger::Log(::Flux::LogVerbosity::Trace, __VA_ARGS__)
-	#define FLUX_TRACE_CATEGORY(category, ...) ::Flux::Logger::LogCategory(category, ::Flux::LogVerbosity::Trace, __VA_ARGS__)
+	#define FLUX_TRACE_CATEGORY(category, ...) FLUX_LOG_CATEGORY_IMPL(category, ::Flux::LogVerbosity::Trace, __VA_ARGS__)
 #else
 	#define FLUX_TRACE(...)
 	#define FLUX_TRACE_CATEGORY(...)
 #endif
 
 #define FLUX_LOG(verbosity, ...) ::Flux::Logger::Log(verbosity, __VA_ARGS__)
-#define FLUX_LOG_CATEGORY(verbosity, category, ...) ::Flux::Logger::LogCategory(category, verbosity, __VA_ARGS__)
+#define FLUX_LOG_CATEGORY(verbosity, category, ...) FLUX_LOG_CATEGORY_IMPL(category, verbosity, __VA_ARGS__)
+
+#if FLUX_LOG_MIN_VERBOSITY <= 2
+	#define FLUX_INFO(...)                    ::Flux::Logger::Log(::Flux::LogVerbosity::Info, __VA_ARGS__)
+	#define FLUX_INFO_CATEGORY(category, ...) FLUX_LOG_CATEGORY_IMPL(category, ::Flux::LogVerbosity::Info, __VA_ARGS__)
+#else
+	#define FLUX_INFO(...)
+	#define FLUX_INFO_CATEGORY(...)
+#endif
 
-#define FLUX_INFO(...)     ::Flux::Logger::Log(::Flux::LogVerbosity::Info,     __VA_ARGS__)
-#define FLUX_WARNING(...)  ::Flux::Logger::Log(::Flux::LogVerbosity::Warning,  __VA_ARGS__)
-#define FLUX_ERROR(...)    ::Flux::Logger::Log(::Flux::LogVerbosity::Error,    __VA_ARGS__)
-#define FLUX_CRITICAL(...) ::Flux::Logger::Log(::Flux::LogVerbosity::Critical, __VA_ARGS__)
+#if FLUX_LOG_MIN_VERBOSITY <= 3
+	#define FLUX_WARNING(...)                    ::Flux::Logger::Log(::Flux::LogVerbosity::Warning, __VA_ARGS__)
+	#define FLUX_WARNING_CATEGORY(category, ...) FLUX_LOG_CATEGORY_IMPL(category, ::Flux::LogVerbosity::Warning, __VA_ARGS__)
+#else
+	#define FLUX_WARNING(...)
+	#define FLUX_WARNING_CATEGORY(...)
+#endif
+
+#if FLUX_LOG_MIN_VERBOSITY <= 4
+	#define FLUX_ERROR(...)                    ::Flux::Logger::Log(::Flux::LogVerbosity::Error, __VA_ARGS__)
+	#define FLUX_ERROR_CATEGORY(category, ...) FLUX_LOG_CATEGORY_IMPL(category, ::Flux::LogVerbosity::Error, __VA_ARGS__)
+#else
+	#define FLUX_ERROR(...)
+	#define FLUX_ERROR_CATEGORY(...)
+#endif
 
-#define FLUX_INFO_CATEGORY(category, ...)     ::Flux::Logger::LogCategory(category, ::Flux::LogVerbosity::Info,     __VA_ARGS__)
-#define FLUX_WARNING_CATEGORY(category, ...)  ::Flux::Logger::LogCategory(category, ::Flux::LogVerbosity::Warning,  __VA_ARGS__)
-#define FLUX_ERROR_CATEGORY(category, ...)    ::Flux::Logger::LogCategory(category, ::Flux::LogVerbosity::Error,    __VA_ARGS__)
-#define FLUX_CRITICAL_CATEGORY(category, ...) ::Flux::Logger::LogCategory(category, ::Flux::LogVerbosity::Critical, __VA_ARGS__)
\ No newline at end of file
+#define FLUX_CRITICAL(...)                    ::Flux::Logger::Log(::Flux::LogVerbosity::Critical, __VA_ARGS__)
+#define FLUX_CRITICAL_CATEGORY(category, ...) FLUX_LOG_CATEGORY_IMPL(category, ::Flux::LogVerbosity::Critical, __VA_ARGS__)
\ No newline at end of file
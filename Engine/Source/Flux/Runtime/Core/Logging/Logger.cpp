@@ -1,6 +1,9 @@
 #include "FluxPCH.h"
 #include "Logger.h"
 
+#include "LogMacros.h"
+#include "BinaryLogWriter.h"
+
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
@@ -10,31 +13,531 @@ namespace Flux {
 	#define FLUX_HAS_CONSOLE
 #endif
 
-	void Logger::Init()
+	// Single producer, single consumer ring of variable sized entries.
+	// Entries never wrap, the rest of the ring is skipped with a padding entry instead.
+	class LogRing
 	{
-		std::vector<spdlog::sink_ptr> sinks = {
-			std::make_shared<spdlog::sinks::basic_file_sink_mt>("Logs/Latest.log", true),
-#ifdef FLUX_HAS_CONSOLE
-			std::make_shared<spdlog::sinks::stdout_color_sink_mt>()
-#endif
+	public:
+		LogRing(uint32 capacity)
+			: m_Capacity(capacity)
+		{
+			m_Data = new uint8[m_Capacity];
+		}
+
+		~LogRing()
+		{
+			delete[] m_Data;
+		}
+
+		// Producer
+		uint8* BeginWrite(uint32 size)
+		{
+			const uint32 entrySize = (sizeof(EntryHeader) + size + s_Alignment - 1) & ~(s_Alignment - 1);
+
+			uint64 head = m_Head.load(std::memory_order_relaxed);
+			uint64 tail = m_Tail.load(std::memory_order_acquire);
+
+			uint32 offset = static_cast<uint32>(head % m_Capacity);
+			uint32 remaining = m_Capacity - offset;
+			uint32 requiredSize = entrySize <= remaining ? entrySize : remaining + entrySize;
+			if (head + requiredSize - tail > m_Capacity)
+				return nullptr;
+
+			if (entrySize > remaining)
+			{
+				new(m_Data + offset) EntryHeader{ remaining, true };
+				head += remaining;
+				offset = 0;
+			}
+
+			new(m_Data + offset) EntryHeader{ entrySize, false };
+			m_PendingHead = head + entrySize;
+			return m_Data + offset + sizeof(EntryHeader);
+		}
+
+		void EndWrite()
+		{
+			m_Head.store(m_PendingHead, std::memory_order_release);
+		}
+
+		// Consumer
+		uint8* BeginRead()
+		{
+			uint64 tail = m_Tail.load(std::memory_order_relaxed);
+			uint64 head = m_Head.load(std::memory_order_acquire);
+
+			while (tail != head)
+			{
+				EntryHeader* header = reinterpret_cast<EntryHeader*>(m_Data + tail % m_Capacity);
+				if (!header->Padding)
+				{
+					m_ReadSize = header->Size;
+					return reinterpret_cast<uint8*>(header + 1);
+				}
+
+				tail += header->Size;
+				m_Tail.store(tail, std::memory_order_release);
+			}
+
+			return nullptr;
+		}
+
+		void EndRead()
+		{
+			m_Tail.store(m_Tail.load(std::memory_order_relaxed) + m_ReadSize, std::memory_order_release);
+		}
+
+		uint64 GetUsedSize() const { return m_Head.load(std::memory_order_relaxed) - m_Tail.load(std::memory_order_relaxed); }
+		uint32 GetCapacity() const { return m_Capacity; }
+
+		// Largest record that is written through the ring
+		uint32 GetMaxRecordSize() const { return m_Capacity / 4; }
+
+		// Cleared when the owning thread exits, so another thread can take over the ring
+		std::atomic<bool> Owned = true;
+
+		// Only accessed with the rings mutex locked
+		ThreadID OwnerThreadID = 0;
+		std::string OwnerThreadName;
+
+		static constexpr uint32 s_Alignment = 8;
+	private:
+		struct EntryHeader
+		{
+			uint32 Size;
+			uint32 Padding;
 		};
+	private:
+		uint8* m_Data = nullptr;
+		uint32 m_Capacity = 0;
+
+		alignas(64) std::atomic<uint64> m_Head = 0;
+		uint64 m_PendingHead = 0;
+
+		alignas(64) std::atomic<uint64> m_Tail = 0;
+		uint32 m_ReadSize = 0;
+	};
+
+	struct LogMessage
+	{
+		std::chrono::system_clock::time_point Time;
+		LogVerbosity Verbosity;
+		std::string Text;
+	};
+
+	struct LoggerData
+	{
+		Unique<spdlog::logger> Logger;
+		// The sinks are single threaded, only the logger thread writes unless the message is immediate
+		std::mutex SinkMutex;
+
+		std::vector<std::shared_ptr<LogRing>> Rings;
+		std::mutex RingsMutex;
+		uint32 Session = 0;
+
+		Unique<Thread> LoggerThread;
+		ThreadID LoggerThreadID = 0;
+		std::atomic<bool> Running = false;
+		std::mutex WakeMutex;
+		std::condition_variable WakeCondVar;
+		// Incremented after every pass over all rings
+		std::atomic<uint64> DrainCount = 0;
+
+		std::atomic<LogOverflowPolicy> OverflowPolicy = LogOverflowPolicy::Block;
+		std::atomic<uint64> DroppedMessages = 0;
+		std::atomic<uint64> TotalDroppedMessages = 0;
+
+		std::vector<LogMessage> Messages;
+		fmt::memory_buffer FormatBuffer;
+
+		Unique<BinaryLogWriter> BinaryLog;
+		// Written by the logger thread and by immediate messages
+		std::mutex BinaryLogMutex;
+	};
+
+	static LoggerData* s_Data = nullptr;
+	static std::atomic<uint32> s_Session = 0;
+
+	static constexpr uint32 s_LogRingCapacity = 256 * 1024;
+
+	struct ThreadLogRing
+	{
+		// Keeps the ring alive if the thread outlives the logger
+		std::shared_ptr<LogRing> Ring;
+		uint32 Session = 0;
+
+		// Used instead of the ring for records that don't fit
+		std::vector<uint8> OversizedRecord;
+		bool WritingOversizedRecord = false;
+
+		LogVerbosity RecordVerbosity = LogVerbosity::Trace;
+
+		~ThreadLogRing()
+		{
+			if (Ring)
+				Ring->Owned.store(false, std::memory_order_release);
+		}
+	};
+
+	static thread_local ThreadLogRing t_ThreadLogRing;
+
+	namespace Utils {
+
+		static LogRing* GetThreadLogRing()
+		{
+			auto& threadRing = t_ThreadLogRing;
+			if (threadRing.Ring && threadRing.Session == s_Data->Session)
+				return threadRing.Ring.get();
+
+			if (threadRing.Ring)
+				threadRing.Ring->Owned.store(false, std::memory_order_release);
+
+			// Only the binary log stores thread names, queried before locking since a failure logs
+			ThreadID threadID = Platform::GetCurrentThreadID();
+			std::string threadName;
+			if (s_Data->BinaryLog)
+				threadName = Platform::GetThreadName(Platform::GetCurrentThread());
+
+			std::lock_guard<std::mutex> lock(s_Data->RingsMutex);
+
+			threadRing.Ring = nullptr;
+
+			// Reuse the ring of a thread that has exited once the logger thread has emptied it
+			for (auto& ring : s_Data->Rings)
+			{
+				if (!ring->Owned.load(std::memory_order_acquire) && ring->GetUsedSize() == 0)
+				{
+					ring->Owned.store(true, std::memory_order_relaxed);
+					threadRing.Ring = ring;
+					break;
+				}
+			}
+
+			if (!threadRing.Ring)
+				threadRing.Ring = s_Data->Rings.emplace_back(std::make_shared<LogRing>(s_LogRingCapacity));
+
+			threadRing.Ring->OwnerThreadID = threadID;
+			threadRing.Ring->OwnerThreadName = std::move(threadName);
+			threadRing.Session = s_Data->Session;
+			return threadRing.Ring.get();
+		}
+
+		static void WakeLoggerThread()
+		{
+			s_Data->WakeCondVar.notify_one();
+		}
+
+		static void FormatLogMessage(const LogRecord& record, const uint8* arguments, fmt::memory_buffer& buffer)
+		{
+			buffer.clear();
+
+			if (!record.Category.empty())
+				fmt::format_to(std::back_inserter(buffer), "[{0}] ", record.Category);
+
+			try
+			{
+				record.Descriptor->FormatFunction(record.Format, arguments, buffer);
+			}
+			catch (const fmt::format_error& error)
+			{
+				fmt::format_to(std::back_inserter(buffer), "Failed to format '{0}': {1}", std::string_view(record.Format.data(), record.Format.size()), error.what());
+			}
+		}
+
+		static void WriteLogMessage(std::chrono::system_clock::time_point time, LogVerbosity verbosity, std::string_view text)
+		{
+			auto level = static_cast<spdlog::level::level_enum>(verbosity);
+			s_Data->Logger->log(time, spdlog::source_loc(), level, text);
+		}
+
+	}
+
+	void Logger::Init(const LoggerCreateInfo& createInfo)
+	{
+		std::vector<spdlog::sink_ptr> sinks;
+
+		if (createInfo.TextLog)
+		{
+			auto& sink = sinks.emplace_back(std::make_shared<spdlog::sinks::basic_file_sink_st>("Logs/Latest.log", true));
+			sink->set_pattern("[%T] [%n] %v");
+		}
 
-		sinks[0]->set_pattern("[%T] [%n] %v");
 #ifdef FLUX_HAS_CONSOLE
-		sinks[1]->set_pattern("%^[%T] [%n] %v%$");
+		if (createInfo.ConsoleLog)
+		{
+			auto& sink = sinks.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_st>());
+			sink->set_pattern("%^[%T] [%n] %v%$");
+		}
 #endif
 
-		s_Logger = CreateUnique<spdlog::logger>("Flux", sinks.begin(), sinks.end());
-		s_Logger->set_level(spdlog::level::trace);
+		s_Data = new LoggerData();
+		s_Data->Session = ++s_Session;
+
+		if (createInfo.BinaryLog)
+		{
+			std::filesystem::create_directories("Logs");
+
+			s_Data->BinaryLog = CreateUnique<BinaryLogWriter>("Logs/Latest.flog");
+			if (!s_Data->BinaryLog->IsOpen())
+				s_Data->BinaryLog.reset();
+		}
+
+		s_Data->Logger = CreateUnique<spdlog::logger>("Flux", sinks.begin(), sinks.end());
+		s_Data->Logger->set_level(spdlog::level::trace);
+		s_Data->Logger->flush_on(spdlog::level::warn);
+
+		s_Data->Running = true;
+
+		ThreadCreateInfo loggerThreadCreateInfo;
+		loggerThreadCreateInfo.Name = "Logger Thread";
+		loggerThreadCreateInfo.Priority = ThreadPriority::BelowNormal;
+
+		s_Data->LoggerThread = Thread::Create(loggerThreadCreateInfo);
+		s_Data->LoggerThreadID = s_Data->LoggerThread->GetID();
+		s_Data->LoggerThread->Submit(LoggerThreadLoop);
 	}
 
 	void Logger::Shutdown()
 	{
-		s_Logger.reset();
+		s_Data->Running = false;
+		Utils::WakeLoggerThread();
+
+		// Joins the logger thread after the last pass over the rings
+		s_Data->LoggerThread.reset();
+		s_Data->Logger->flush();
+		s_Data->BinaryLog.reset();
+
+		delete s_Data;
+		s_Data = nullptr;
 
 		spdlog::shutdown();
 	}
 
+	void Logger::Flush()
+	{
+		if (!s_Data || Platform::GetCurrentThreadID() == s_Data->LoggerThreadID)
+			return;
+
+		// The pass in progress may have missed messages of this thread, so wait for the one after it
+		uint64 drainCount = s_Data->DrainCount.load(std::memory_order_acquire);
+		while (s_Data->DrainCount.load(std::memory_order_acquire) < drainCount + 2)
+		{
+			// The logger thread makes a last pass on its own when shutting down
+			if (!s_Data->Running.load(std::memory_order_acquire))
+				break;
+
+			Utils::WakeLoggerThread();
+			std::this_thread::yield();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data->SinkMutex);
+			s_Data->Logger->flush();
+		}
+
+		if (s_Data->BinaryLog)
+		{
+			std::lock_guard<std::mutex> lock(s_Data->BinaryLogMutex);
+			s_Data->BinaryLog->Flush();
+		}
+	}
+
+	void Logger::SetOverflowPolicy(LogOverflowPolicy policy)
+	{
+		s_Data->OverflowPolicy.store(policy, std::memory_order_relaxed);
+	}
+
+	LogOverflowPolicy Logger::GetOverflowPolicy()
+	{
+		return s_Data->OverflowPolicy.load(std::memory_order_relaxed);
+	}
+
+	uint64 Logger::GetDroppedMessageCount()
+	{
+		return s_Data->TotalDroppedMessages.load(std::memory_order_relaxed);
+	}
+
+	uint8* Logger::BeginRecord(uint32 size, LogVerbosity verbosity)
+	{
+		if (!s_Data || static_cast<uint8>(verbosity) < FLUX_LOG_MIN_VERBOSITY)
+			return nullptr;
+
+		LogRing* ring = Utils::GetThreadLogRing();
+		t_ThreadLogRing.RecordVerbosity = verbosity;
+
+		// Huge messages are written on the calling thread
+		if (size > ring->GetMaxRecordSize())
+		{
+			t_ThreadLogRing.OversizedRecord.resize(size);
+			t_ThreadLogRing.WritingOversizedRecord = true;
+			return t_ThreadLogRing.OversizedRecord.data();
+		}
+
+		uint8* buffer = ring->BeginWrite(size);
+		while (!buffer)
+		{
+			if (s_Data->OverflowPolicy.load(std::memory_order_relaxed) == LogOverflowPolicy::Drop)
+			{
+				s_Data->DroppedMessages.fetch_add(1, std::memory_order_relaxed);
+				s_Data->TotalDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Utils::WakeLoggerThread();
+			std::this_thread::yield();
+
+			buffer = ring->BeginWrite(size);
+		}
+
+		return buffer;
+	}
+
+	void Logger::EndRecord()
+	{
+		auto& threadRing = t_ThreadLogRing;
+		if (threadRing.WritingOversizedRecord)
+		{
+			threadRing.WritingOversizedRecord = false;
+
+			const LogRecord& record = *reinterpret_cast<const LogRecord*>(threadRing.OversizedRecord.data());
+
+			fmt::memory_buffer buffer;
+			Utils::FormatLogMessage(record, threadRing.OversizedRecord.data() + sizeof(LogRecord), buffer);
+			LogImmediate(record.Verbosity, std::string_view(buffer.data(), buffer.size()));
+			return;
+		}
+
+		LogRing* ring = threadRing.Ring.get();
+		ring->EndWrite();
+
+		// Errors show up right away, and a filling ring is emptied before the thread has to block
+		if (threadRing.RecordVerbosity >= LogVerbosity::Error || ring->GetUsedSize() > ring->GetCapacity() / 2)
+			Utils::WakeLoggerThread();
+	}
+
+	void Logger::LogImmediate(LogVerbosity verbosity, std::string_view message)
+	{
+		if (!s_Data)
+			return;
+
+		Flush();
+
+		auto time = std::chrono::system_clock::now();
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data->SinkMutex);
+			Utils::WriteLogMessage(time, verbosity, message);
+			s_Data->Logger->flush();
+		}
+
+		if (s_Data->BinaryLog)
+		{
+			// The name is only known if the thread has logged before, querying it here could fail and recurse
+			ThreadID threadID = Platform::GetCurrentThreadID();
+			std::string threadName;
+			if (t_ThreadLogRing.Ring && t_ThreadLogRing.Session == s_Data->Session)
+			{
+				std::lock_guard<std::mutex> lock(s_Data->RingsMutex);
+				threadName = t_ThreadLogRing.Ring->OwnerThreadName;
+			}
+
+			std::lock_guard<std::mutex> lock(s_Data->BinaryLogMutex);
+			s_Data->BinaryLog->WriteText(time, verbosity, threadID, threadName, message);
+			s_Data->BinaryLog->EndPass();
+			s_Data->BinaryLog->Flush();
+		}
+	}
+
+	void Logger::LoggerThreadLoop()
+	{
+		auto& messages = s_Data->Messages;
+		BinaryLogWriter* binaryLog = s_Data->BinaryLog.get();
+
+		// Formatting is skipped entirely when only the binary log is written
+		const bool textLog = !s_Data->Logger->sinks().empty();
+
+		while (true)
+		{
+			bool running = s_Data->Running.load(std::memory_order_acquire);
+			uint32 recordCount = 0;
+
+			std::unique_lock<std::mutex> binaryLogLock;
+			if (binaryLog)
+				binaryLogLock = std::unique_lock<std::mutex>(s_Data->BinaryLogMutex);
+
+			{
+				std::lock_guard<std::mutex> lock(s_Data->RingsMutex);
+
+				for (auto& ring : s_Data->Rings)
+				{
+					while (uint8* entry = ring->BeginRead())
+					{
+						const LogRecord& record = *reinterpret_cast<const LogRecord*>(entry);
+						const uint8* arguments = entry + sizeof(LogRecord);
+
+						if (textLog)
+						{
+							Utils::FormatLogMessage(record, arguments, s_Data->FormatBuffer);
+
+							auto& message = messages.emplace_back();
+							message.Time = record.Time;
+							message.Verbosity = record.Verbosity;
+							message.Text.assign(s_Data->FormatBuffer.data(), s_Data->FormatBuffer.size());
+						}
+
+						if (binaryLog)
+							binaryLog->Write(record, arguments, ring->OwnerThreadID, ring->OwnerThreadName);
+
+						recordCount++;
+						ring->EndRead();
+					}
+				}
+			}
+
+			uint64 droppedMessages = recordCount > 0 ? s_Data->DroppedMessages.exchange(0, std::memory_order_relaxed) : 0;
+
+			if (binaryLog)
+			{
+				binaryLog->EndPass();
+				if (droppedMessages > 0)
+					binaryLog->WriteDroppedMessages(std::chrono::system_clock::now(), droppedMessages);
+
+				binaryLogLock.unlock();
+			}
+
+			// Rings are drained one after another, the messages of all threads are written in the order they were logged
+			std::stable_sort(messages.begin(), messages.end(), [](const LogMessage& a, const LogMessage& b)
+			{
+				return a.Time < b.Time;
+			});
+
+			if (!messages.empty())
+			{
+				std::lock_guard<std::mutex> lock(s_Data->SinkMutex);
+
+				for (auto& message : messages)
+					Utils::WriteLogMessage(message.Time, message.Verbosity, message.Text);
+
+				if (droppedMessages > 0)
+					Utils::WriteLogMessage(std::chrono::system_clock::now(), LogVerbosity::Warning, fmt::format("[Logger] {0} messages were dropped", droppedMessages));
+			}
+
+			bool idle = recordCount == 0;
+			messages.clear();
+
+			s_Data->DrainCount.fetch_add(1, std::memory_order_release);
+
+			if (!running)
+				break;
+
+			if (idle)
+			{
+				std::unique_lock<std::mutex> lock(s_Data->WakeMutex);
+				s_Data->WakeCondVar.wait_for(lock, std::chrono::milliseconds(5));
+			}
+		}
+	}
+
 	void Logger::CheckIsInThread(ThreadID threadID, std::string_view functionName)
 	{
 		if (Platform::GetCurrentThreadID() != threadID)
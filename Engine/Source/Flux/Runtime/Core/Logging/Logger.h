@@ -2,11 +2,18 @@
 
 #include "Flux/Runtime/Core/Thread.h"
 
+#include "BinaryLogFormat.h"
+
 #pragma warning(push, 0)
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/fmt.h>
 #pragma warning(pop)
 
+// Categories in this comma separated list of string literals are compiled out
+#ifndef FLUX_LOG_DISABLED_CATEGORIES
+	#define FLUX_LOG_DISABLED_CATEGORIES
+#endif
+
 namespace Flux {
 
 	enum class LogVerbosity : uint8
@@ -19,38 +26,272 @@ namespace Flux {
 		Critical
 	};
 
+	// What a thread does when its log ring is full
+	enum class LogOverflowPolicy : uint8
+	{
+		// Wait for the logger thread, nothing is lost
+		Block = 0,
+		// Discard the message, the logger thread reports how many were dropped
+		Drop
+	};
+
+	struct LoggerCreateInfo
+	{
+		// Logs/Latest.log
+		bool TextLog = true;
+		// Logs/Latest.flog, decoded with fluxlogdump
+		bool BinaryLog = false;
+#ifndef FLUX_BUILD_SHIPPING
+		bool ConsoleLog = true;
+#endif
+	};
+
+	using LogFormatFunction = void(*)(fmt::string_view format, const uint8* arguments, fmt::memory_buffer& buffer);
+	using LogBinaryFunction = void(*)(const uint8* arguments, std::vector<uint8>& buffer);
+
+	// Shared by every message with the same argument types
+	struct LogRecordDescriptor
+	{
+		LogFormatFunction FormatFunction;
+		// Converts the arguments to their binary log representation
+		LogBinaryFunction BinaryFunction;
+		const LogArgumentType* ArgumentTypes;
+		uint8 ArgumentCount;
+		// Without custom arguments the serialized arguments already are the binary log representation
+		bool HasCustomArguments;
+	};
+
+	// Header of a message in a log ring, followed by the serialized arguments
+	struct LogRecord
+	{
+		const LogRecordDescriptor* Descriptor;
+		fmt::string_view Format;
+		std::string_view Category;
+		std::chrono::system_clock::time_point Time;
+		uint32 ArgumentsSize;
+		LogVerbosity Verbosity;
+	};
+
+	namespace Utils {
+
+		// Trivially copyable arguments are copied into the record as they are
+		template<typename T>
+		constexpr LogArgumentType GetLogArgumentType()
+		{
+			if constexpr (std::is_same_v<T, bool>)
+				return LogArgumentType::Bool;
+			else if constexpr (std::is_same_v<T, char>)
+				return LogArgumentType::Char;
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+				return sizeof(T) == 1 ? LogArgumentType::Int8 : sizeof(T) == 2 ? LogArgumentType::Int16 : sizeof(T) == 4 ? LogArgumentType::Int32 : LogArgumentType::Int64;
+			else if constexpr (std::is_integral_v<T>)
+				return sizeof(T) == 1 ? LogArgumentType::UInt8 : sizeof(T) == 2 ? LogArgumentType::UInt16 : sizeof(T) == 4 ? LogArgumentType::UInt32 : LogArgumentType::UInt64;
+			else if constexpr (std::is_same_v<T, float>)
+				return LogArgumentType::Float;
+			else if constexpr (std::is_same_v<T, double>)
+				return LogArgumentType::Double;
+			else if constexpr (std::is_pointer_v<T> && sizeof(T) == sizeof(uint64))
+				return LogArgumentType::Pointer;
+			else
+				return LogArgumentType::Custom;
+		}
+
+		template<typename T>
+		struct LogValueArgument
+		{
+			using DecodedType = T;
+
+			static constexpr LogArgumentType Type = GetLogArgumentType<T>();
+
+			static uint32 GetSize(const T& value) { return sizeof(T); }
+
+			static void Encode(uint8*& buffer, const T& value)
+			{
+				memcpy(buffer, &value, sizeof(T));
+				buffer += sizeof(T);
+			}
+
+			static T Decode(const uint8*& buffer)
+			{
+				alignas(T) uint8 storage[sizeof(T)];
+				memcpy(storage, buffer, sizeof(T));
+				buffer += sizeof(T);
+				return *reinterpret_cast<T*>(storage);
+			}
+
+			static void WriteBinary(const uint8*& arguments, std::vector<uint8>& buffer)
+			{
+				if constexpr (Type == LogArgumentType::Custom)
+				{
+					fmt::memory_buffer text;
+					fmt::format_to(std::back_inserter(text), "{}", Decode(arguments));
+
+					uint32 size = static_cast<uint32>(text.size());
+					buffer.insert(buffer.end(), reinterpret_cast<const uint8*>(&size), reinterpret_cast<const uint8*>(&size) + sizeof(uint32));
+					buffer.insert(buffer.end(), text.data(), text.data() + size);
+				}
+				else
+				{
+					buffer.insert(buffer.end(), arguments, arguments + sizeof(T));
+					arguments += sizeof(T);
+				}
+			}
+		};
+
+		// Strings are copied, the caller's memory may be gone once the message is formatted
+		struct LogStringArgument
+		{
+			using DecodedType = std::string_view;
+
+			static constexpr LogArgumentType Type = LogArgumentType::String;
+
+			static uint32 GetSize(std::string_view value) { return sizeof(uint32) + static_cast<uint32>(value.size()); }
+
+			static void Encode(uint8*& buffer, std::string_view value)
+			{
+				uint32 size = static_cast<uint32>(value.size());
+				memcpy(buffer, &size, sizeof(uint32));
+				memcpy(buffer + sizeof(uint32), value.data(), size);
+				buffer += sizeof(uint32) + size;
+			}
+
+			static std::string_view Decode(const uint8*& buffer)
+			{
+				uint32 size;
+				memcpy(&size, buffer, sizeof(uint32));
+				std::string_view value(reinterpret_cast<const char*>(buffer + sizeof(uint32)), size);
+				buffer += sizeof(uint32) + size;
+				return value;
+			}
+
+			static void WriteBinary(const uint8*& arguments, std::vector<uint8>& buffer)
+			{
+				uint32 size;
+				memcpy(&size, arguments, sizeof(uint32));
+				buffer.insert(buffer.end(), arguments, arguments + sizeof(uint32) + size);
+				arguments += sizeof(uint32) + size;
+			}
+		};
+
+		// Everything else is formatted on the calling thread, format specs of these arguments are ignored
+		template<typename T>
+		struct LogFormattedArgument
+		{
+			using DecodedType = std::string_view;
+
+			static constexpr LogArgumentType Type = LogArgumentType::String;
+
+			static uint32 GetSize(const T& value) { return sizeof(uint32) + static_cast<uint32>(fmt::formatted_size("{}", value)); }
+
+			static void Encode(uint8*& buffer, const T& value)
+			{
+				uint32 size = static_cast<uint32>(fmt::formatted_size("{}", value));
+				memcpy(buffer, &size, sizeof(uint32));
+				fmt::format_to(reinterpret_cast<char*>(buffer + sizeof(uint32)), "{}", value);
+				buffer += sizeof(uint32) + size;
+			}
+
+			static std::string_view Decode(const uint8*& buffer) { return LogStringArgument::Decode(buffer); }
+			static void WriteBinary(const uint8*& arguments, std::vector<uint8>& buffer) { LogStringArgument::WriteBinary(arguments, buffer); }
+		};
+
+		template<typename T>
+		struct LogArgument : std::conditional_t<std::is_trivially_copyable_v<T>, LogValueArgument<T>, LogFormattedArgument<T>> {};
+
+		template<> struct LogArgument<const char*> : LogStringArgument {};
+		template<> struct LogArgument<char*> : LogStringArgument {};
+		template<> struct LogArgument<std::string> : LogStringArgument {};
+		template<> struct LogArgument<std::string_view> : LogStringArgument {};
+
+		// Runs on the logger thread
+		template<typename... TArgs>
+		void FormatLogRecord(fmt::string_view format, const uint8* arguments, fmt::memory_buffer& buffer)
+		{
+			// Braced initialization decodes the arguments in order
+			std::tuple<typename LogArgument<TArgs>::DecodedType...> decodedArguments{ LogArgument<TArgs>::Decode(arguments)... };
+			std::apply([&](auto&... values)
+			{
+				fmt::vformat_to(std::back_inserter(buffer), format, fmt::make_format_args(values...));
+			}, decodedArguments);
+		}
+
+		template<typename... TArgs>
+		void WriteLogRecordBinary(const uint8* arguments, std::vector<uint8>& buffer)
+		{
+			(LogArgument<TArgs>::WriteBinary(arguments, buffer), ...);
+		}
+
+		template<typename... TArgs>
+		struct LogRecordDescriptorStorage
+		{
+			static_assert(sizeof...(TArgs) <= UINT8_MAX);
+
+			// The trailing element keeps the array valid without arguments
+			static constexpr LogArgumentType ArgumentTypes[] = { LogArgument<TArgs>::Type..., LogArgumentType::Custom };
+
+			static constexpr LogRecordDescriptor Descriptor = {
+				&FormatLogRecord<TArgs...>,
+				&WriteLogRecordBinary<TArgs...>,
+				ArgumentTypes,
+				static_cast<uint8>(sizeof...(TArgs)),
+				(false || ... || (LogArgument<TArgs>::Type == LogArgumentType::Custom))
+			};
+		};
+
+		inline constexpr std::string_view s_DisabledLogCategories[] = { "", FLUX_LOG_DISABLED_CATEGORIES };
+
+		constexpr bool IsLogCategoryEnabled(std::string_view category)
+		{
+			for (std::string_view disabledCategory : s_DisabledLogCategories)
+			{
+				if (!disabledCategory.empty() && disabledCategory == category)
+					return false;
+			}
+			return true;
+		}
+
+	}
+
+	// Messages are serialized into a ring per thread and formatted and written by the logger thread.
+	// Format strings and categories must be string literals, they are referenced until the message is written.
 	class Logger
 	{
 	public:
-		static void Init();
+		static void Init(const LoggerCreateInfo& createInfo = {});
 		static void Shutdown();
 
+		// Waits until every message logged before the call has been written
+		static void Flush();
+
+		static void SetOverflowPolicy(LogOverflowPolicy policy);
+		static LogOverflowPolicy GetOverflowPolicy();
+
+		static uint64 GetDroppedMessageCount();
+
 		template<typename... TArgs>
 		static void Log(LogVerbosity verbosity, fmt::format_string<TArgs...> fmt, TArgs&&... args)
 		{
-			auto level = static_cast<spdlog::level::level_enum>(verbosity);
-			s_Logger->log(level, fmt, std::forward<TArgs>(args)...);
+			Enqueue<std::decay_t<TArgs>...>({}, verbosity, fmt::string_view(fmt), args...);
 		}
 
 		template<typename... TArgs>
 		static void LogCategory(std::string_view category, LogVerbosity verbosity, fmt::format_string<TArgs...> fmt, TArgs&&... args)
 		{
-			auto level = static_cast<spdlog::level::level_enum>(verbosity);
-			s_Logger->log(level, "[{0}] {1}", category, fmt::format(fmt, std::forward<TArgs>(args)...));
+			Enqueue<std::decay_t<TArgs>...>(category, verbosity, fmt::string_view(fmt), args...);
 		}
 
 		template<typename... TArgs>
 		static void AssertionFailed(fmt::format_string<TArgs...> fmt, TArgs&&... args)
 		{
 			auto expression = fmt::format(fmt, std::forward<TArgs>(args)...);
-			s_Logger->error(fmt::format("Assertion failed: {0}", expression));
+			LogImmediate(LogVerbosity::Error, fmt::format("Assertion failed: {0}", expression));
 			AssertMessageBox("Assertion failed!", expression);
 		}
 
 		static void AssertionFailed()
 		{
 			std::string_view message = "Assertion failed!";
-			s_Logger->error(message);
+			LogImmediate(LogVerbosity::Error, message);
 			AssertMessageBox(message);
 		}
 
@@ -58,22 +299,51 @@ namespace Flux {
 		static void VerifyFailed(fmt::format_string<TArgs...> fmt, TArgs&&... args)
 		{
 			auto expression = fmt::format(fmt, std::forward<TArgs>(args)...);
-			s_Logger->error(fmt::format("Verify failed: {0}", expression));
+			LogImmediate(LogVerbosity::Error, fmt::format("Verify failed: {0}", expression));
 			AssertMessageBox("Verify failed!", expression);
 		}
 
 		static void VerifyFailed()
 		{
 			std::string_view message = "Verify failed!";
-			s_Logger->error(message);
+			LogImmediate(LogVerbosity::Error, message);
 			AssertMessageBox(message);
 		}
 
 		static void CheckIsInThread(ThreadID threadID, std::string_view functionName = "");
 	private:
+		template<typename... TArgs>
+		static void Enqueue(std::string_view category, LogVerbosity verbosity, fmt::string_view format, const TArgs&... args)
+		{
+			const uint32 argumentsSize = (0 + ... + Utils::LogArgument<TArgs>::GetSize(args));
+
+			uint8* buffer = BeginRecord(sizeof(LogRecord) + argumentsSize, verbosity);
+			if (!buffer)
+				return;
+
+			LogRecord* record = new(buffer) LogRecord();
+			record->Descriptor = &Utils::LogRecordDescriptorStorage<TArgs...>::Descriptor;
+			record->Format = format;
+			record->Category = category;
+			record->Time = std::chrono::system_clock::now();
+			record->ArgumentsSize = argumentsSize;
+			record->Verbosity = verbosity;
+
+			uint8* arguments = buffer + sizeof(LogRecord);
+			(Utils::LogArgument<TArgs>::Encode(arguments, args), ...);
+
+			EndRecord();
+		}
+
+		static uint8* BeginRecord(uint32 size, LogVerbosity verbosity);
+		static void EndRecord();
+
+		// Writes on the calling thread after flushing, used before the process may go down
+		static void LogImmediate(LogVerbosity verbosity, std::string_view message);
+
+		static void LoggerThreadLoop();
+
 		static void AssertMessageBox(std::string_view message, std::string_view expression = "");
-	private:
-		inline static Unique<spdlog::logger> s_Logger;
 	};
 
 }
\ No newline at end of file
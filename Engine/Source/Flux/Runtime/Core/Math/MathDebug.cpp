@@ -0,0 +1,110 @@
+#include "FluxPCH.h"
+#include "MathDebug.h"
+
+#ifdef FLUX_MATH_DEBUG_ENABLED
+
+namespace Flux {
+
+	struct MathDebugThread
+	{
+		Unique<MathDebug::ThreadCounters> Counters;
+		// Counter values at the last EndFrame
+		std::array<uint32, MathDebug::MaxFunctionCount> LastCalls = {};
+	};
+
+	struct MathDebugData
+	{
+		std::mutex Mutex;
+		std::vector<std::string_view> FunctionNames;
+		std::vector<MathDebugThread> Threads;
+
+		// Main thread only
+		std::vector<MathFunctionStats> FunctionStats;
+	};
+
+	// Call sites can run before the engine is initialized, so this is never destroyed
+	static MathDebugData& GetMathDebugData()
+	{
+		static MathDebugData* data = new MathDebugData();
+		return *data;
+	}
+
+	uint32 MathDebug::RegisterFunction(std::string_view functionName)
+	{
+		auto& data = GetMathDebugData();
+		std::lock_guard<std::mutex> lock(data.Mutex);
+
+		FLUX_VERIFY(data.FunctionNames.size() < MaxFunctionCount, "Too many math debug functions!");
+
+		data.FunctionNames.push_back(functionName);
+		return static_cast<uint32>(data.FunctionNames.size() - 1);
+	}
+
+	MathDebug::ThreadCounters* MathDebug::RegisterThread()
+	{
+		auto& data = GetMathDebugData();
+		std::lock_guard<std::mutex> lock(data.Mutex);
+
+		// Counters of finished threads are kept, EndFrame still reads them
+		auto& thread = data.Threads.emplace_back();
+		thread.Counters = CreateUnique<ThreadCounters>();
+
+		t_Counters = thread.Counters.get();
+		return t_Counters;
+	}
+
+	void MathDebug::EndFrame()
+	{
+		auto& data = GetMathDebugData();
+		std::lock_guard<std::mutex> lock(data.Mutex);
+
+		auto& functionStats = data.FunctionStats;
+		for (size_t i = functionStats.size(); i < data.FunctionNames.size(); i++)
+		{
+			auto& stats = functionStats.emplace_back();
+			stats.Name = data.FunctionNames[i];
+			stats.History.resize(HistoryFrameCount, 0.0f);
+		}
+
+		for (auto& stats : functionStats)
+			stats.LastFrameCalls = 0;
+
+		for (auto& thread : data.Threads)
+		{
+			for (size_t i = 0; i < functionStats.size(); i++)
+			{
+				uint32 calls = thread.Counters->Calls[i].load(std::memory_order_relaxed);
+				functionStats[i].LastFrameCalls += calls - thread.LastCalls[i];
+				thread.LastCalls[i] = calls;
+			}
+		}
+
+		for (auto& stats : functionStats)
+		{
+			stats.TotalCalls += stats.LastFrameCalls;
+			stats.History[stats.HistoryOffset] = static_cast<float>(stats.LastFrameCalls);
+			stats.HistoryOffset = (stats.HistoryOffset + 1) % HistoryFrameCount;
+		}
+	}
+
+	void MathDebug::Reset()
+	{
+		auto& data = GetMathDebugData();
+		std::lock_guard<std::mutex> lock(data.Mutex);
+
+		for (auto& stats : data.FunctionStats)
+		{
+			stats.LastFrameCalls = 0;
+			stats.TotalCalls = 0;
+			std::fill(stats.History.begin(), stats.History.end(), 0.0f);
+		}
+	}
+
+	const std::vector<MathFunctionStats>& MathDebug::GetFunctionStats()
+	{
+		return GetMathDebugData().FunctionStats;
+	}
+
+}
+
+#endif
\ No newline at end of file
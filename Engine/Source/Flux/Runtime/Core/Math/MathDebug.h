@@ -1,41 +1,74 @@
 #pragma once
 
-#ifdef FLUX_BUILD_DEBUG
+// Define FLUX_MATH_DEBUG_ENABLED (premake5 --math-debug) to count math calls in Release builds
+#if defined(FLUX_BUILD_DEBUG) && !defined(FLUX_MATH_DEBUG_ENABLED)
 	#define FLUX_MATH_DEBUG_ENABLED
 #endif
 
 #ifdef FLUX_MATH_DEBUG_ENABLED
 	#include "Flux/Runtime/Core/BaseTypes.h"
 
-	#include <map>
+	#include <array>
+	#include <atomic>
 	#include <string_view>
+	#include <vector>
 #endif
 
 namespace Flux {
 
 #ifdef FLUX_MATH_DEBUG_ENABLED
+	struct MathFunctionStats
+	{
+		std::string_view Name;
+		uint32 LastFrameCalls = 0;
+		uint64 TotalCalls = 0;
+
+		// Calls per frame, oldest first starting at HistoryOffset
+		std::vector<float> History;
+		uint32 HistoryOffset = 0;
+	};
+
 	class MathDebug
 	{
 	public:
-		using FunctionCallMap = std::map<std::string_view, uint32>;
-	public:
-		inline static void Reset()
-		{
-			s_FunctionCalls.clear();
-		}
-		inline static const FunctionCallMap& GetFunctionCalls()
+		static constexpr uint32 MaxFunctionCount = 256;
+		static constexpr uint32 HistoryFrameCount = 120;
+
+		// Only written by the owning thread, read by EndFrame
+		struct ThreadCounters
 		{
-			return s_FunctionCalls;
-		}
-		inline static void AddCall(std::string_view functionName)
+			std::array<std::atomic<uint32>, MaxFunctionCount> Calls = {};
+		};
+
+		// Called once per call site by FLUX_MATH_PROFILE_FUNC
+		static uint32 RegisterFunction(std::string_view functionName);
+
+		inline static void AddCall(uint32 functionID)
 		{
-			s_FunctionCalls[functionName]++;
+			ThreadCounters* counters = t_Counters;
+			if (!counters)
+				counters = RegisterThread();
+
+			// Single writer, so a plain load and store is enough
+			auto& calls = counters->Calls[functionID];
+			calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 		}
-	public:
-		inline static FunctionCallMap s_FunctionCalls;
+
+		// Merges the counters of all threads into the per-frame stats, called by the main loop
+		static void EndFrame();
+		static void Reset();
+
+		// Only valid on the main thread
+		static const std::vector<MathFunctionStats>& GetFunctionStats();
+	private:
+		static ThreadCounters* RegisterThread();
+	private:
+		inline static thread_local ThreadCounters* t_Counters = nullptr;
 	};
 
-	#define FLUX_MATH_PROFILE_FUNC() MathDebug::AddCall(__FUNCTION__)
+	#define FLUX_MATH_PROFILE_FUNC() \
+		static const uint32 s_MathDebugFunctionID = ::Flux::MathDebug::RegisterFunction(__FUNCTION__); \
+		::Flux::MathDebug::AddCall(s_MathDebugFunctionID)
 #else
 	#define FLUX_MATH_PROFILE_FUNC()
 #endif
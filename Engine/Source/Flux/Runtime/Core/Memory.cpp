@@ -0,0 +1,405 @@
+#include "FluxPCH.h"
+#include "Memory.h"
+
+namespace Flux {
+
+	// Keeps the user pointer aligned like malloc's
+	struct alignas(16) AllocationHeader
+	{
+		uint64 Size;
+		MemoryTag Tag;
+		bool Tracked;
+	};
+
+	static_assert(sizeof(AllocationHeader) == 16);
+
+	struct MemoryTagCounters
+	{
+		std::atomic<uint64> LiveBytes;
+		std::atomic<uint64> PeakBytes;
+		std::atomic<uint64> LiveAllocations;
+		std::atomic<uint64> TotalAllocations;
+
+		std::atomic<uint64> FrameAllocations;
+		std::atomic<uint64> FrameBytes;
+		std::atomic<uint64> LastFrameAllocations;
+		std::atomic<uint64> LastFrameBytes;
+	};
+
+	static constexpr uint32 s_MaxCallstackDepth = 16;
+
+	struct AllocationRecord
+	{
+		uint64 Size;
+		MemoryTag Tag;
+		uint32 FrameCount;
+		void* Frames[s_MaxCallstackDepth];
+	};
+
+	struct MemoryTrackingData
+	{
+		std::mutex Mutex;
+		std::unordered_map<void*, AllocationRecord> Allocations;
+	};
+
+	// Allocations happen before and after the engine lifetime, so the counters are plain statics.
+	// The last entry holds the totals of all tags.
+	static std::array<MemoryTagCounters, static_cast<size_t>(MemoryTag::Count) + 1> s_Counters;
+	static std::atomic<bool> s_CaptureCallstacks = false;
+
+	static std::atomic<uint64> s_HeapAllocations = 0;
+	static std::atomic<uint64> s_FrameStartHeapAllocations = 0;
+	static std::atomic<uint64> s_LastFrameHeapAllocations = 0;
+
+	namespace Utils {
+
+		// Never destroyed, tracked allocations can be freed during static destruction
+		static MemoryTrackingData& GetMemoryTrackingData()
+		{
+			static MemoryTrackingData* data = new MemoryTrackingData();
+			return *data;
+		}
+
+		static void AddAllocation(MemoryTagCounters& counters, uint64 size)
+		{
+			uint64 liveBytes = counters.LiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+			counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+			counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+			counters.FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+			counters.FrameBytes.fetch_add(size, std::memory_order_relaxed);
+
+			uint64 peakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+			while (liveBytes > peakBytes && !counters.PeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		static void RemoveAllocation(MemoryTagCounters& counters, uint64 size)
+		{
+			counters.LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+			counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		static void CountHeapAllocation()
+		{
+#ifndef FLUX_BUILD_SHIPPING
+			s_HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+		}
+
+		static void OnAllocated(MemoryTag tag, uint64 size)
+		{
+			CountHeapAllocation();
+
+			AddAllocation(s_Counters[static_cast<size_t>(tag)], size);
+			AddAllocation(s_Counters.back(), size);
+		}
+
+		static void OnFreed(MemoryTag tag, uint64 size)
+		{
+			RemoveAllocation(s_Counters[static_cast<size_t>(tag)], size);
+			RemoveAllocation(s_Counters.back(), size);
+		}
+
+		static void TrackAllocation(void* memory, uint64 size, MemoryTag tag)
+		{
+			AllocationRecord record;
+			record.Size = size;
+			record.Tag = tag;
+			// Skip TrackAllocation and the Memory function that called it
+			record.FrameCount = Platform::CaptureStackTrace(record.Frames, s_MaxCallstackDepth, 2);
+
+			auto& data = GetMemoryTrackingData();
+			std::lock_guard<std::mutex> lock(data.Mutex);
+			data.Allocations[memory] = record;
+		}
+
+		static void UntrackAllocation(void* memory)
+		{
+			auto& data = GetMemoryTrackingData();
+			std::lock_guard<std::mutex> lock(data.Mutex);
+			data.Allocations.erase(memory);
+		}
+
+		static MemoryTagStats GetCounterStats(const MemoryTagCounters& counters)
+		{
+			MemoryTagStats stats;
+			stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+			stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+			stats.LiveAllocations = counters.LiveAllocations.load(std::memory_order_relaxed);
+			stats.TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed);
+			stats.FrameAllocations = counters.LastFrameAllocations.load(std::memory_order_relaxed);
+			stats.FrameBytes = counters.LastFrameBytes.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+	}
+
+	void* Memory::Allocate(uint64 size, MemoryTag tag)
+	{
+		AllocationHeader* header = static_cast<AllocationHeader*>(malloc(sizeof(AllocationHeader) + size));
+		if (!header)
+			return nullptr;
+
+		header->Size = size;
+		header->Tag = tag;
+		header->Tracked = s_CaptureCallstacks.load(std::memory_order_relaxed);
+
+		void* memory = header + 1;
+		Utils::OnAllocated(tag, size);
+
+		if (header->Tracked)
+			Utils::TrackAllocation(memory, size, tag);
+
+		return memory;
+	}
+
+	void* Memory::Reallocate(void* memory, uint64 size, MemoryTag tag)
+	{
+		if (!memory)
+			return Allocate(size, tag);
+
+		AllocationHeader* header = static_cast<AllocationHeader*>(memory) - 1;
+		const uint64 oldSize = header->Size;
+		const MemoryTag memoryTag = header->Tag;
+		const bool wasTracked = header->Tracked;
+
+		// The old block stays valid if this fails
+		AllocationHeader* newHeader = static_cast<AllocationHeader*>(realloc(header, sizeof(AllocationHeader) + size));
+		if (!newHeader)
+			return nullptr;
+
+		if (wasTracked)
+			Utils::UntrackAllocation(memory);
+
+		newHeader->Size = size;
+		newHeader->Tracked = s_CaptureCallstacks.load(std::memory_order_relaxed);
+
+		void* newMemory = newHeader + 1;
+		Utils::OnFreed(memoryTag, oldSize);
+		Utils::OnAllocated(memoryTag, size);
+
+		if (newHeader->Tracked)
+			Utils::TrackAllocation(newMemory, size, memoryTag);
+
+		return newMemory;
+	}
+
+	void Memory::Free(void* memory)
+	{
+		if (!memory)
+			return;
+
+		AllocationHeader* header = static_cast<AllocationHeader*>(memory) - 1;
+		if (header->Tracked)
+			Utils::UntrackAllocation(memory);
+
+		Utils::OnFreed(header->Tag, header->Size);
+		free(header);
+	}
+
+	void Memory::EndFrame()
+	{
+		for (auto& counters : s_Counters)
+		{
+			counters.LastFrameAllocations.store(counters.FrameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+			counters.LastFrameBytes.store(counters.FrameBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		uint64 heapAllocations = s_HeapAllocations.load(std::memory_order_relaxed);
+		s_LastFrameHeapAllocations.store(heapAllocations - s_FrameStartHeapAllocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		s_FrameStartHeapAllocations.store(heapAllocations, std::memory_order_relaxed);
+	}
+
+	MemoryTagStats Memory::GetStats(MemoryTag tag)
+	{
+		FLUX_VERIFY(tag < MemoryTag::Count);
+		return Utils::GetCounterStats(s_Counters[static_cast<size_t>(tag)]);
+	}
+
+	MemoryTagStats Memory::GetTotalStats()
+	{
+		return Utils::GetCounterStats(s_Counters.back());
+	}
+
+	uint64 Memory::GetFrameHeapAllocations()
+	{
+		return s_LastFrameHeapAllocations.load(std::memory_order_relaxed);
+	}
+
+	uint64 Memory::GetHeapAllocationCount()
+	{
+		return s_HeapAllocations.load(std::memory_order_relaxed);
+	}
+
+	void Memory::SetCallstackCaptureEnabled(bool enabled)
+	{
+		s_CaptureCallstacks.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool Memory::IsCallstackCaptureEnabled()
+	{
+		return s_CaptureCallstacks.load(std::memory_order_relaxed);
+	}
+
+	uint64 Memory::ReportLeaks()
+	{
+		for (uint8 i = 0; i < static_cast<uint8>(MemoryTag::Count); i++)
+		{
+			MemoryTag tag = static_cast<MemoryTag>(i);
+			MemoryTagStats stats = GetStats(tag);
+			if (stats.LiveAllocations > 0)
+				FLUX_WARNING_CATEGORY("Memory", "{0}: {1} bytes in {2} allocations still alive", Utils::MemoryTagToString(tag), stats.LiveBytes, stats.LiveAllocations);
+		}
+
+		auto& data = Utils::GetMemoryTrackingData();
+		std::lock_guard<std::mutex> lock(data.Mutex);
+
+		for (auto& [memory, record] : data.Allocations)
+		{
+			FLUX_WARNING_CATEGORY("Memory", "Leaked {0} bytes ({1}) at 0x{2:016x}", record.Size, Utils::MemoryTagToString(record.Tag), reinterpret_cast<uintptr>(memory));
+			for (uint32 i = 0; i < record.FrameCount; i++)
+				FLUX_WARNING_CATEGORY("Memory", "    {0}", Platform::GetSymbolName(record.Frames[i]));
+		}
+
+		return data.Allocations.size();
+	}
+
+}
+
+#ifndef FLUX_BUILD_SHIPPING
+
+// Replaced only to count allocations
+
+static void* AllocateAligned(size_t size, std::align_val_t alignment) noexcept
+{
+	size_t alignmentSize = static_cast<size_t>(alignment);
+	size_t alignedSize = ((size > 0 ? size : 1) + alignmentSize - 1) & ~(alignmentSize - 1);
+
+#ifdef FLUX_PLATFORM_WINDOWS
+	return _aligned_malloc(alignedSize, alignmentSize);
+#else
+	return aligned_alloc(alignmentSize, alignedSize);
+#endif
+}
+
+static void FreeAligned(void* memory) noexcept
+{
+#ifdef FLUX_PLATFORM_WINDOWS
+	_aligned_free(memory);
+#else
+	free(memory);
+#endif
+}
+
+void* operator new(size_t size)
+{
+	Flux::Utils::CountHeapAllocation();
+
+	if (void* memory = malloc(size > 0 ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	Flux::Utils::CountHeapAllocation();
+	return malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t size) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	Flux::Utils::CountHeapAllocation();
+
+	if (void* memory = AllocateAligned(size, alignment))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	Flux::Utils::CountHeapAllocation();
+	return AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, alignment, tag);
+}
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept
+{
+	FreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t alignment) noexcept
+{
+	FreeAligned(memory);
+}
+
+void operator delete(void* memory, size_t size, std::align_val_t alignment) noexcept
+{
+	FreeAligned(memory);
+}
+
+void operator delete[](void* memory, size_t size, std::align_val_t alignment) noexcept
+{
+	FreeAligned(memory);
+}
+
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	FreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	FreeAligned(memory);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "BaseTypes.h"
+
+namespace Flux {
+
+	enum class MemoryTag : uint8
+	{
+		Unknown = 0,
+		Renderer,
+		Assets,
+		Scene,
+		ImGui,
+		Commands,
+		Frame,
+
+		Count
+	};
+
+	namespace Utils {
+
+		inline const char* MemoryTagToString(MemoryTag tag)
+		{
+			switch (tag)
+			{
+			case MemoryTag::Unknown: return "Unknown";
+			case MemoryTag::Renderer: return "Renderer";
+			case MemoryTag::Assets: return "Assets";
+			case MemoryTag::Scene: return "Scene";
+			case MemoryTag::ImGui: return "ImGui";
+			case MemoryTag::Commands: return "Commands";
+			case MemoryTag::Frame: return "Frame";
+			}
+			return "";
+		}
+
+		// Tag of T::AllocationTag if T declares one
+		template<typename T>
+		constexpr MemoryTag GetAllocationTag()
+		{
+			if constexpr (requires { T::AllocationTag; })
+				return T::AllocationTag;
+			else
+				return MemoryTag::Unknown;
+		}
+
+	}
+
+	struct MemoryTagStats
+	{
+		uint64 LiveBytes = 0;
+		uint64 PeakBytes = 0;
+		uint64 LiveAllocations = 0;
+		uint64 TotalAllocations = 0;
+
+		// Allocations made during the last completed frame
+		uint64 FrameAllocations = 0;
+		uint64 FrameBytes = 0;
+	};
+
+	// Tracking layer for engine allocations. Every allocation carries a small header
+	// with its size and tag, so Free and Reallocate don't need to be told the tag again.
+	class Memory
+	{
+	public:
+		static void* Allocate(uint64 size, MemoryTag tag = MemoryTag::Unknown);
+		// tag is only used when memory is nullptr, otherwise the allocation keeps its tag
+		static void* Reallocate(void* memory, uint64 size, MemoryTag tag = MemoryTag::Unknown);
+		static void Free(void* memory);
+
+		static void EndFrame();
+
+		static MemoryTagStats GetStats(MemoryTag tag);
+		static MemoryTagStats GetTotalStats();
+
+		// Heap allocations of any kind (operator new and Memory) during the last completed frame,
+		// always 0 in shipping builds
+		static uint64 GetFrameHeapAllocations();
+		// Running count of heap allocations, for measuring a section of code
+		static uint64 GetHeapAllocationCount();
+
+		// Allocations made while enabled remember their callstack until they are freed
+		static void SetCallstackCaptureEnabled(bool enabled);
+		static bool IsCallstackCaptureEnabled();
+
+		// Logs the live bytes of every tag and the callstack of every tracked allocation
+		// that is still alive, returns the number of tracked allocations
+		static uint64 ReportLeaks();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "BaseTypes.h"
+#include "Memory.h"
+
+namespace Flux {
+
+	template<typename T>
+	class ObjectPool;
+
+	// Index and generation of an object in ObjectPool<T>.
+	// Destroying the object bumps the generation of its slot, so stale handles resolve to nullptr
+	// instead of to whatever object reuses the slot.
+	template<typename T>
+	class PoolHandle
+	{
+	public:
+		PoolHandle() = default;
+		PoolHandle(uint32 index, uint32 generation)
+			: m_Index(index), m_Generation(generation) {}
+
+		T* Get() const { return ObjectPool<T>::Get().Resolve(*this); }
+
+		T* operator->() const
+		{
+			T* object = Get();
+			FLUX_ASSERT(object, "Pool handle {0} (generation {1}) is stale!", m_Index, m_Generation);
+			return object;
+		}
+
+		T& operator*() const { return *operator->(); }
+
+		bool IsValid() const { return Get() != nullptr; }
+
+		uint32 GetIndex() const { return m_Index; }
+		uint32 GetGeneration() const { return m_Generation; }
+
+		bool operator==(const PoolHandle& other) const { return m_Index == other.m_Index && m_Generation == other.m_Generation; }
+		bool operator!=(const PoolHandle& other) const { return !(*this == other); }
+
+		static constexpr uint32 s_InvalidIndex = UINT32_MAX;
+	private:
+		uint32 m_Index = s_InvalidIndex;
+		uint32 m_Generation = 0;
+	};
+
+	// Slab allocator for objects of type T. Slabs are never freed or moved, so resolving
+	// a handle is lock-free and may happen on any thread, e.g. inside render commands.
+	// Allocating and freeing slots takes a lock.
+	template<typename T>
+	class ObjectPool
+	{
+	public:
+		// Pools are never destroyed, objects can outlive the engine in release queues
+		static ObjectPool& Get()
+		{
+			static ObjectPool* pool = new ObjectPool();
+			return *pool;
+		}
+
+		template<typename... TArgs>
+		PoolHandle<T> Create(TArgs&&... args)
+		{
+			Slot* slot = AllocateSlot();
+			new(slot->Storage) T(std::forward<TArgs>(args)...);
+			return PoolHandle<T>(slot->Index, slot->Generation.load(std::memory_order_relaxed));
+		}
+
+		void Destroy(PoolHandle<T> handle)
+		{
+			T* object = Resolve(handle);
+			if (!object)
+			{
+				FLUX_VERIFY(false, "Destroying stale pool handle {0}!", handle.GetIndex());
+				return;
+			}
+
+			object->~T();
+			FreeSlot(GetSlot(handle.GetIndex()));
+		}
+
+		T* Resolve(PoolHandle<T> handle) const
+		{
+			if (handle.GetIndex() == PoolHandle<T>::s_InvalidIndex)
+				return nullptr;
+
+			Slot* slot = GetSlot(handle.GetIndex());
+			if (!slot || slot->Generation.load(std::memory_order_acquire) != handle.GetGeneration())
+				return nullptr;
+
+			return reinterpret_cast<T*>(slot->Storage);
+		}
+
+		// Uninitialized storage for a T, used by FLUX_POOLED_CLASS
+		void* Allocate()
+		{
+			return AllocateSlot()->Storage;
+		}
+
+		void Free(void* memory)
+		{
+			// Storage is the first member of Slot
+			FreeSlot(reinterpret_cast<Slot*>(memory));
+		}
+
+		uint32 GetLiveCount() const { return m_LiveCount.load(std::memory_order_relaxed); }
+		uint32 GetCapacity() const { return m_SlabCount.load(std::memory_order_relaxed) * s_SlabSize; }
+
+		static constexpr uint32 s_SlabSize = 64;
+		static constexpr uint32 s_MaxSlabCount = 1024;
+	private:
+		struct Slot
+		{
+			alignas(T) uint8 Storage[sizeof(T)];
+			std::atomic<uint32> Generation = 1;
+			uint32 Index = 0;
+			uint32 NextFree = PoolHandle<T>::s_InvalidIndex;
+		};
+
+		ObjectPool() = default;
+
+		Slot* GetSlot(uint32 index) const
+		{
+			uint32 slabIndex = index / s_SlabSize;
+			if (slabIndex >= s_MaxSlabCount)
+				return nullptr;
+
+			Slot* slab = m_Slabs[slabIndex].load(std::memory_order_acquire);
+			return slab ? &slab[index % s_SlabSize] : nullptr;
+		}
+
+		Slot* AllocateSlot()
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if (m_FreeList == PoolHandle<T>::s_InvalidIndex)
+				AllocateSlab();
+
+			Slot* slot = GetSlot(m_FreeList);
+			m_FreeList = slot->NextFree;
+			m_LiveCount.fetch_add(1, std::memory_order_relaxed);
+			return slot;
+		}
+
+		void FreeSlot(Slot* slot)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			slot->Generation.fetch_add(1, std::memory_order_release);
+			slot->NextFree = m_FreeList;
+			m_FreeList = slot->Index;
+			m_LiveCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void AllocateSlab()
+		{
+			uint32 slabIndex = m_SlabCount.load(std::memory_order_relaxed);
+			FLUX_VERIFY(slabIndex < s_MaxSlabCount, "Object pool is full!");
+
+			Slot* slab = static_cast<Slot*>(Memory::Allocate(sizeof(Slot) * s_SlabSize, Utils::GetAllocationTag<T>()));
+
+			// Chain the new slots in order, so the lowest index is handed out first
+			for (uint32 i = 0; i < s_SlabSize; i++)
+			{
+				Slot* slot = new(&slab[i]) Slot();
+				slot->Index = slabIndex * s_SlabSize + i;
+				slot->NextFree = i + 1 < s_SlabSize ? slot->Index + 1 : m_FreeList;
+			}
+
+			m_FreeList = slabIndex * s_SlabSize;
+
+			m_Slabs[slabIndex].store(slab, std::memory_order_release);
+			m_SlabCount.store(slabIndex + 1, std::memory_order_relaxed);
+		}
+	private:
+		std::array<std::atomic<Slot*>, s_MaxSlabCount> m_Slabs = {};
+		std::atomic<uint32> m_SlabCount = 0;
+		std::atomic<uint32> m_LiveCount = 0;
+
+		std::mutex m_Mutex;
+		uint32 m_FreeList = PoolHandle<T>::s_InvalidIndex;
+	};
+
+}
+
+// Allocates instances of a ReferenceCounted class from ObjectPool<type>, classes deriving from it can't be pooled this way
+#define FLUX_POOLED_CLASS(type) \
+	static void* operator new(size_t size) { FLUX_ASSERT(size == sizeof(type)); return ::Flux::ObjectPool<type>::Get().Allocate(); } \
+	static void* operator new(size_t size, ::Flux::MemoryTag tag) { return operator new(size); } \
+	static void operator delete(void* memory) { ::Flux::ObjectPool<type>::Get().Free(memory); } \
+	static void operator delete(void* memory, ::Flux::MemoryTag tag) { operator delete(memory); }
\ No newline at end of file
@@ -69,9 +69,14 @@ namespace Flux {
 		static void PumpMessages();
 
 		static void Sleep(float seconds);
+		// Sleeps on a high resolution timer and spins the last part of the wait,
+		// so the calling thread wakes up within microseconds of the given GetNanoTime
+		static void SleepUntil(uint64 nanoTime);
 
 		static float GetTime();
 		static uint64 GetNanoTime();
+		// Raw CPU timestamp counter, only meaningful as a difference
+		static uint64 GetCycleCount();
 
 		static DialogResult OpenFolderDialog(Window* window, std::string* outPath, const std::string& title = "Select Folder");
 		static DialogResult MessageBox(MessageBoxButtons buttons, MessageBoxIcon icon, const std::string& text, const std::string& caption);
@@ -79,6 +84,11 @@ namespace Flux {
 		static bool IsDebuggerPresent();
 		static void DebugBreak();
 
+		// Fills frames with the return addresses of the calling thread, returns the number of frames
+		static uint32 CaptureStackTrace(void** frames, uint32 maxFrames, uint32 skipFrames = 0);
+		// Function name and source location of a code address, if debug symbols are available
+		static std::string GetSymbolName(void* address);
+
 		static bool SetConsoleTitle(const std::string& title);
 
 		static bool SetThreadName(ThreadHandle handle, std::string_view name);
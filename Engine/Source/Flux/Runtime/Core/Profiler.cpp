@@ -0,0 +1,320 @@
+#include "FluxPCH.h"
+#include "Profiler.h"
+
+#include "Engine.h"
+
+namespace Flux {
+
+	namespace Utils {
+
+		static std::string EscapeJSONString(std::string_view string)
+		{
+			std::string result;
+			result.reserve(string.size());
+			for (char c : string)
+			{
+				if (c == '"' || c == '\\')
+					result += '\\';
+				result += c;
+			}
+			return result;
+		}
+
+	}
+
+	// Written by the owning thread only, read by the main thread in Profiler::MarkFrame
+	struct ProfilerThreadBuffer
+	{
+		ThreadID ID = 0;
+		uint32 ThreadIndex = 0;
+		uint32 Depth = 0;
+
+		std::unique_ptr<ProfilerEvent[]> Events;
+
+		alignas(64) std::atomic<uint64> WriteIndex = 0;
+		alignas(64) std::atomic<uint64> ReadIndex = 0;
+		std::atomic<uint64> DroppedEvents = 0;
+	};
+
+	struct ProfilerData
+	{
+		uint32 Generation = 0;
+
+		std::mutex ThreadsMutex;
+		std::vector<Unique<ProfilerThreadBuffer>> ThreadBuffers;
+		std::unordered_map<ThreadID, std::string> ThreadNames;
+		bool ThreadNamesDirty = false;
+
+		std::mutex NamesMutex;
+		std::unordered_set<std::string> Names;
+
+		std::atomic<bool> Paused = false;
+
+		// Main thread only
+		std::deque<ProfilerFrame> Frames;
+		std::vector<ProfilerThread> Threads;
+		uint64 FrameIndex = 0;
+		uint64 DroppedEvents = 0;
+
+		// The timestamp counter frequency is measured against Platform::GetNanoTime,
+		// the longer the profiler runs, the more accurate it gets
+		uint64 CalibrationCycles = 0;
+		uint64 CalibrationNanoTime = 0;
+		double CyclesPerNanosecond = 1.0;
+	};
+
+	static constexpr uint32 s_ThreadBufferCapacity = 1 << 16;
+	static constexpr uint32 s_MaxFrameCount = 300;
+
+	static ProfilerData* s_Data = nullptr;
+	static uint32 s_Generation = 0;
+
+	// Buffers of a previous profiler instance are detected by the generation
+	thread_local ProfilerThreadBuffer* t_ThreadBuffer = nullptr;
+	thread_local uint32 t_ThreadGeneration = 0;
+
+	static ProfilerThreadBuffer* GetThreadBuffer()
+	{
+		if (!s_Data)
+			return nullptr;
+
+		if (t_ThreadGeneration != s_Data->Generation)
+		{
+			std::lock_guard<std::mutex> lock(s_Data->ThreadsMutex);
+
+			auto& buffer = s_Data->ThreadBuffers.emplace_back(CreateUnique<ProfilerThreadBuffer>());
+			buffer->ID = Platform::GetCurrentThreadID();
+			buffer->ThreadIndex = static_cast<uint32>(s_Data->ThreadBuffers.size() - 1);
+			buffer->Events = std::make_unique<ProfilerEvent[]>(s_ThreadBufferCapacity);
+
+			t_ThreadBuffer = buffer.get();
+			t_ThreadGeneration = s_Data->Generation;
+		}
+
+		return t_ThreadBuffer;
+	}
+
+	void Profiler::Init()
+	{
+		FLUX_VERIFY(!s_Data);
+
+		s_Data = new ProfilerData();
+		s_Data->Generation = ++s_Generation;
+		s_Data->CalibrationCycles = Platform::GetCycleCount();
+		s_Data->CalibrationNanoTime = Platform::GetNanoTime();
+	}
+
+	void Profiler::Shutdown()
+	{
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void Profiler::MarkFrame()
+	{
+		if (!s_Data)
+			return;
+
+		uint64 cycles = Platform::GetCycleCount();
+		uint64 nanoTime = Platform::GetNanoTime();
+		if (nanoTime > s_Data->CalibrationNanoTime)
+			s_Data->CyclesPerNanosecond = double(cycles - s_Data->CalibrationCycles) / double(nanoTime - s_Data->CalibrationNanoTime);
+
+		bool paused = s_Data->Paused.load(std::memory_order_relaxed);
+
+		ProfilerFrame* frame = nullptr;
+		if (!paused && !s_Data->Frames.empty())
+		{
+			frame = &s_Data->Frames.back();
+			frame->End = cycles;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data->ThreadsMutex);
+
+			if (s_Data->Threads.size() != s_Data->ThreadBuffers.size() || s_Data->ThreadNamesDirty)
+			{
+				s_Data->Threads.resize(s_Data->ThreadBuffers.size());
+				for (size_t i = 0; i < s_Data->ThreadBuffers.size(); i++)
+				{
+					auto& thread = s_Data->Threads[i];
+					thread.ID = s_Data->ThreadBuffers[i]->ID;
+
+					auto it = s_Data->ThreadNames.find(thread.ID);
+					thread.Name = it != s_Data->ThreadNames.end() ? it->second : fmt::format("Thread {0}", thread.ID);
+				}
+				s_Data->ThreadNamesDirty = false;
+			}
+
+			uint64 droppedEvents = 0;
+			for (auto& buffer : s_Data->ThreadBuffers)
+			{
+				uint64 readIndex = buffer->ReadIndex.load(std::memory_order_relaxed);
+				uint64 writeIndex = buffer->WriteIndex.load(std::memory_order_acquire);
+
+				if (frame)
+				{
+					for (uint64 i = readIndex; i < writeIndex; i++)
+						frame->Events.push_back(buffer->Events[i & (s_ThreadBufferCapacity - 1)]);
+				}
+
+				buffer->ReadIndex.store(writeIndex, std::memory_order_release);
+				droppedEvents += buffer->DroppedEvents.load(std::memory_order_relaxed);
+			}
+			s_Data->DroppedEvents = droppedEvents;
+		}
+
+		if (paused)
+			return;
+
+		auto& newFrame = s_Data->Frames.emplace_back();
+		newFrame.Index = s_Data->FrameIndex++;
+		newFrame.Start = cycles;
+
+		if (s_Data->Frames.size() > s_MaxFrameCount)
+			s_Data->Frames.pop_front();
+	}
+
+	void Profiler::SetPaused(bool paused)
+	{
+		s_Data->Paused.store(paused, std::memory_order_relaxed);
+	}
+
+	bool Profiler::IsPaused()
+	{
+		return s_Data->Paused.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::SetThreadName(ThreadID threadID, std::string_view name)
+	{
+		if (!s_Data)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_Data->ThreadsMutex);
+		s_Data->ThreadNames[threadID] = name;
+		s_Data->ThreadNamesDirty = true;
+	}
+
+	const char* Profiler::InternName(std::string_view name)
+	{
+		FLUX_VERIFY(s_Data);
+
+		std::lock_guard<std::mutex> lock(s_Data->NamesMutex);
+		return s_Data->Names.emplace(name).first->c_str();
+	}
+
+	const std::deque<ProfilerFrame>& Profiler::GetFrames()
+	{
+		return s_Data->Frames;
+	}
+
+	const std::vector<ProfilerThread>& Profiler::GetThreads()
+	{
+		return s_Data->Threads;
+	}
+
+	uint64 Profiler::GetDroppedEventCount()
+	{
+		return s_Data->DroppedEvents;
+	}
+
+	float Profiler::CyclesToMilliseconds(uint64 cycles)
+	{
+		return static_cast<float>(double(cycles) / s_Data->CyclesPerNanosecond * 0.001 * 0.001);
+	}
+
+	bool Profiler::ExportChromeTrace(const std::filesystem::path& path)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		auto& frames = s_Data->Frames;
+		if (frames.empty())
+			return false;
+
+		std::ofstream stream(path);
+		if (!stream)
+		{
+			FLUX_ERROR_CATEGORY("Profiler", "Failed to open '{0}'", path.string());
+			return false;
+		}
+
+		const uint64 baseCycles = frames.front().Start;
+		auto toMicroseconds = [baseCycles](uint64 cycles)
+		{
+			return double(cycles - baseCycles) / s_Data->CyclesPerNanosecond * 0.001;
+		};
+
+		std::string json = "{\"traceEvents\":[\n";
+
+		for (auto& thread : s_Data->Threads)
+			json += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{0},\"args\":{{\"name\":\"{1}\"}}}},\n", thread.ID, Utils::EscapeJSONString(thread.Name));
+
+		uint32 eventCount = 0;
+		for (auto& frame : frames)
+		{
+			json += fmt::format("{{\"name\":\"Frame {0}\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":{1:.3f}}},\n", frame.Index, toMicroseconds(frame.Start));
+
+			for (auto& event : frame.Events)
+			{
+				// Events that were still open when the first frame started
+				if (event.Start < baseCycles)
+					continue;
+
+				ThreadID threadID = s_Data->Threads[event.ThreadIndex].ID;
+				json += fmt::format("{{\"name\":\"{0}\",\"cat\":\"Flux\",\"ph\":\"X\",\"pid\":0,\"tid\":{1},\"ts\":{2:.3f},\"dur\":{3:.3f}}},\n",
+					Utils::EscapeJSONString(event.Name), threadID, toMicroseconds(event.Start), toMicroseconds(event.End) - toMicroseconds(event.Start));
+				eventCount++;
+			}
+		}
+
+		// Remove the trailing comma
+		json.erase(json.size() - 2);
+		json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+		stream << json;
+
+		FLUX_INFO_CATEGORY("Profiler", "Exported {0} events from {1} frames to '{2}'", eventCount, frames.size(), path.string());
+		return true;
+	}
+
+	void Profiler::BeginScope()
+	{
+		if (ProfilerThreadBuffer* buffer = GetThreadBuffer())
+			buffer->Depth++;
+	}
+
+	void Profiler::EndScope(const char* name, uint64 start)
+	{
+		uint64 end = Platform::GetCycleCount();
+
+		ProfilerThreadBuffer* buffer = GetThreadBuffer();
+		if (!buffer)
+			return;
+
+		// Scopes that were opened before the profiler was initialized
+		if (buffer->Depth == 0)
+			return;
+		buffer->Depth--;
+
+		if (s_Data->Paused.load(std::memory_order_relaxed))
+			return;
+
+		uint64 writeIndex = buffer->WriteIndex.load(std::memory_order_relaxed);
+		uint64 readIndex = buffer->ReadIndex.load(std::memory_order_acquire);
+		if (writeIndex - readIndex >= s_ThreadBufferCapacity)
+		{
+			buffer->DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto& event = buffer->Events[writeIndex & (s_ThreadBufferCapacity - 1)];
+		event.Name = name;
+		event.Start = start;
+		event.End = end;
+		event.Depth = buffer->Depth;
+		event.ThreadIndex = buffer->ThreadIndex;
+
+		buffer->WriteIndex.store(writeIndex + 1, std::memory_order_release);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Platform.h"
+
+namespace Flux {
+
+#ifndef FLUX_BUILD_SHIPPING
+	#define FLUX_PROFILER_ENABLED
+#endif
+
+	// A completed scope, Start and End are CPU timestamps (see Platform::GetCycleCount)
+	struct ProfilerEvent
+	{
+		const char* Name = nullptr;
+		uint64 Start = 0;
+		uint64 End = 0;
+		uint32 Depth = 0;
+		uint32 ThreadIndex = 0;
+	};
+
+	struct ProfilerFrame
+	{
+		uint64 Index = 0;
+		uint64 Start = 0;
+		uint64 End = 0;
+
+		// Events that were completed during the frame, grouped by thread
+		std::vector<ProfilerEvent> Events;
+	};
+
+	struct ProfilerThread
+	{
+		ThreadID ID = 0;
+		std::string Name;
+	};
+
+	class Profiler
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		// Called once per frame by the main loop, collects the events of all threads
+		static void MarkFrame();
+
+		static void SetPaused(bool paused);
+		static bool IsPaused();
+
+		static void SetThreadName(ThreadID threadID, std::string_view name);
+
+		// Scope names have to outlive the profiler, this returns a copy that does
+		static const char* InternName(std::string_view name);
+
+		// Only valid on the main thread
+		static const std::deque<ProfilerFrame>& GetFrames();
+		static const std::vector<ProfilerThread>& GetThreads();
+		static uint64 GetDroppedEventCount();
+
+		static float CyclesToMilliseconds(uint64 cycles);
+
+		// Writes the collected frames in the Chrome trace event format,
+		// which can be opened in chrome://tracing or ui.perfetto.dev
+		static bool ExportChromeTrace(const std::filesystem::path& path);
+
+		static void BeginScope();
+		static void EndScope(const char* name, uint64 start);
+	};
+
+	class ProfilerScope
+	{
+	public:
+		ProfilerScope(const char* name)
+			: m_Name(name)
+		{
+			Profiler::BeginScope();
+			m_Start = Platform::GetCycleCount();
+		}
+
+		~ProfilerScope()
+		{
+			Profiler::EndScope(m_Name, m_Start);
+		}
+
+		ProfilerScope(const ProfilerScope&) = delete;
+		ProfilerScope& operator=(const ProfilerScope&) = delete;
+	private:
+		const char* m_Name;
+		uint64 m_Start;
+	};
+
+#ifdef FLUX_PROFILER_ENABLED
+	#define FLUX_PROFILE_SCOPE_NAME_IMPL(line) profilerScope##line
+	#define FLUX_PROFILE_SCOPE_NAME(line) FLUX_PROFILE_SCOPE_NAME_IMPL(line)
+
+	#define FLUX_PROFILE_SCOPE(name) ::Flux::ProfilerScope FLUX_PROFILE_SCOPE_NAME(__LINE__)(name)
+	#define FLUX_PROFILE_FUNC() FLUX_PROFILE_SCOPE(__FUNCTION__)
+	#define FLUX_PROFILE_FRAME() ::Flux::Profiler::MarkFrame()
+#else
+	#define FLUX_PROFILE_SCOPE(name) (void)0
+	#define FLUX_PROFILE_FUNC() (void)0
+	#define FLUX_PROFILE_FRAME() (void)0
+#endif
+
+}
\ No newline at end of file
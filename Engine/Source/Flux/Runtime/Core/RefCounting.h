@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Memory.h"
+
 namespace Flux {
 
 	template<typename T>
@@ -25,8 +27,17 @@ namespace Flux {
 	public:
 		virtual ~ReferenceCounted() = default;
 
-		uint32 IncrementReferenceCount() const { return ++m_ReferenceCount; }
-		uint32 DecrementReferenceCount() const { return --m_ReferenceCount; }
+		// Subclasses override this to account their instances to a subsystem
+		static constexpr MemoryTag AllocationTag = MemoryTag::Unknown;
+
+		static void* operator new(size_t size) { return Memory::Allocate(size, AllocationTag); }
+		static void* operator new(size_t size, MemoryTag tag) { return Memory::Allocate(size, tag); }
+		static void operator delete(void* memory) { Memory::Free(memory); }
+		static void operator delete(void* memory, MemoryTag tag) { Memory::Free(memory); }
+
+		// Taking another reference doesn't need to synchronize with anything, only releasing the last one does
+		uint32 IncrementReferenceCount() const { return m_ReferenceCount.fetch_add(1, std::memory_order_relaxed) + 1; }
+		uint32 DecrementReferenceCount() const { return m_ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
 
 		uint32 GetReferenceCount() const { return m_ReferenceCount; }
 
@@ -62,6 +73,13 @@ namespace Flux {
 			IncrementReferenceCount();
 		}
 
+		// Moves hand over the reference without touching the reference count
+		Ref(Ref<T>&& other) noexcept
+			: m_Reference(other.m_Reference)
+		{
+			other.m_Reference = nullptr;
+		}
+
 		template<typename TOther>
 		Ref(const Ref<TOther>& other)
 			: m_Reference(static_cast<T*>(other.m_Reference))
@@ -96,6 +114,17 @@ namespace Flux {
 			return *this;
 		}
 
+		Ref& operator=(Ref<T>&& other) noexcept
+		{
+			if (this != &other)
+			{
+				DecrementReferenceCount();
+				m_Reference = other.m_Reference;
+				other.m_Reference = nullptr;
+			}
+			return *this;
+		}
+
 		template<typename TOther>
 		Ref& operator=(const Ref<TOther>& other)
 		{
@@ -145,7 +174,7 @@ namespace Flux {
 		template<typename... TArgs>
 		static Ref<T> Create(TArgs&&... args)
 		{
-			return Ref<T>(new T(std::forward<TArgs>(args)...));
+			return Ref<T>(new(T::AllocationTag) T(std::forward<TArgs>(args)...));
 		}
 	private:
 		void IncrementReferenceCount() const
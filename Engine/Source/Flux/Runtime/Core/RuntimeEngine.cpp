@@ -2,6 +2,7 @@
 #include "RuntimeEngine.h"
 
 #include "Flux/Runtime/Renderer/Renderer.h"
+#include "Flux/Runtime/Core/JobSystem.h"
 
 namespace Flux {
 
@@ -57,6 +58,13 @@ namespace Flux {
 		m_RenderPipeline = nullptr;
 	}
 
+	void RuntimeEngine::OnFixedUpdate()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_Scene->OnFixedUpdate();
+	}
+
 	void RuntimeEngine::OnUpdate()
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
@@ -83,6 +91,8 @@ namespace Flux {
 		ImGui::Text("Delta Time: %.2fms", m_DeltaTime * 1000.0f);
 		// ImGui::DragFloat("Fixed Delta Time", &m_FixedDeltaTime, 0.001f, 0.001f, 0.1f);
 		ImGui::Text("Fixed Delta Time: %.2f", m_FixedDeltaTime);
+		ImGui::Text("Fixed Update: %.2fms", m_FixedUpdateTime);
+		ImGui::Text("Dropped ticks: %llu", m_DroppedTickCount);
 
 		ImGui::Separator();
 		ImGui::Text("Command queues: %d", Renderer::GetQueueCount());
@@ -98,15 +108,44 @@ namespace Flux {
 			ImGui::Text("Render Thread wait: %.2fms", m_RenderThreadWaitTime);
 		}
 
+		ImGui::Separator();
+		ImGui::Text("Idle: %.2fms", m_IdleTime);
+		ImGui::Text("Frame rate limit wait: %.2fms", m_FrameRateLimitWaitTime);
+
+		ImGui::Separator();
+		FrameMemoryStats frameMemoryStats = FrameMemory::GetStats();
+		ImGui::Text("Heap allocations: %llu per frame", Memory::GetFrameHeapAllocations());
+		ImGui::Text("Frame memory: %.2f / %.2f KB", frameMemoryStats.UsedBytes / 1024.0f, frameMemoryStats.Capacity / 1024.0f);
+
+		ImGui::Separator();
+		if (ImGui::Button("Export Profiler Trace"))
+			Profiler::ExportChromeTrace("FluxTrace.json");
+
+		if (m_Scene)
+		{
+			ImGui::Separator();
+			ImGui::Text("Scene systems (%d workers)", JobSystem::GetWorkerCount());
+
+			for (auto& system : m_Scene->GetSystemScheduler().GetSystems())
+			{
+				const char* phaseString = Utils::SceneSystemPhaseToString(system.Info.Phase);
+				ImGui::Text("[%s:%d] %s: %.3fms", phaseString, system.BatchIndex, system.Info.Name.c_str(), system.LastExecutionTime);
+			}
+		}
+
 #ifdef FLUX_MATH_DEBUG_ENABLED
 		ImGui::Separator();
 
-		auto& mathFunctionCalls = MathDebug::GetFunctionCalls();
+		if (ImGui::Button("Reset Math Calls"))
+			MathDebug::Reset();
 
-		for (auto& [functionName, numCalls] : mathFunctionCalls)
+		for (auto& stats : MathDebug::GetFunctionStats())
 		{
-			std::string textString = fmt::format("{0}: {1} calls", functionName, numCalls);
+			FrameString textString = Utils::FrameFormat("{0}: {1} calls ({2} total)", stats.Name, stats.LastFrameCalls, stats.TotalCalls);
 			ImGui::TextUnformatted(textString.c_str());
+			ImGui::PushID(stats.Name.data());
+			ImGui::PlotHistogram("##History", stats.History.data(), static_cast<int32>(stats.History.size()), stats.HistoryOffset, nullptr, 0.0f, FLT_MAX, { 0.0f, 30.0f });
+			ImGui::PopID();
 		}
 #endif
 
@@ -20,6 +20,7 @@ namespace Flux {
 	protected:
 		virtual void OnInit() override;
 		virtual void OnShutdown() override;
+		virtual void OnFixedUpdate() override;
 		virtual void OnUpdate() override;
 		virtual void OnImGuiRender() override;
 		virtual void OnEvent(Event& event) override;
@@ -154,6 +154,16 @@ namespace Flux {
 			return CursorShape::None;
 		}
 
+		static void* ImGuiAllocate(size_t size, void* userData)
+		{
+			return Memory::Allocate(size, MemoryTag::ImGui);
+		}
+
+		static void ImGuiFree(void* memory, void* userData)
+		{
+			Memory::Free(memory);
+		}
+
 	}
 
 	static std::vector<Ref<Window>> s_ImGuiWindows;
@@ -346,6 +356,7 @@ namespace Flux {
 
 		IMGUI_CHECKVERSION();
 
+		ImGui::SetAllocatorFunctions(Utils::ImGuiAllocate, Utils::ImGuiFree);
 		m_Context = ImGui::CreateContext();
 
 		ImGuiIO& io = ImGui::GetIO();
@@ -560,6 +571,9 @@ namespace Flux {
 		pipelineCreateInfo.DepthTest = false;
 		pipelineCreateInfo.ScissorTest = true;
 		m_Pipeline = GraphicsPipeline::Create(pipelineCreateInfo);
+
+		m_VertexBuffer = StreamingBuffer::Create(1024 * 1024, StreamingBufferType::Vertex);
+		m_IndexBuffer = StreamingBuffer::Create(256 * 1024, StreamingBufferType::Index);
 	}
 
 	ImGuiRenderer::~ImGuiRenderer()
@@ -642,11 +656,12 @@ namespace Flux {
 	void ImGuiRenderer::Render()
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_PROFILE_FUNC();
 
 		ImGui::Render();
 
 		ImDrawData* drawData = ImGui::GetDrawData();
-		if (drawData)
+		if (drawData && drawData->TotalVtxCount > 0)
 		{
 			int32 viewportWidth = static_cast<uint32>(drawData->DisplaySize.x);
 			int32 viewportHeight = static_cast<uint32>(drawData->DisplaySize.y);
@@ -665,23 +680,37 @@ namespace Flux {
 				m_Shader->SetUniform("u_ProjectionMatrix", Matrix4x4::Ortho(left, right, bottom, top));
 			}
 
+			// All command lists are uploaded at once and drawn with offsets into the streaming buffers
+			StagingBuffer vertexStaging = Renderer::AllocateStaging(drawData->TotalVtxCount * sizeof(ImDrawVert));
+			StagingBuffer indexStaging = Renderer::AllocateStaging(drawData->TotalIdxCount * sizeof(ImDrawIdx));
+
+			uint64 vertexStagingOffset = 0;
+			uint64 indexStagingOffset = 0;
 			for (int32 commandListIndex = 0; commandListIndex < drawData->CmdListsCount; commandListIndex++)
 			{
 				const ImDrawList* commandList = drawData->CmdLists[commandListIndex];
 
-				const uint32 vertexBufferSize = commandList->VtxBuffer.Size * sizeof(ImDrawVert);
-				if (!m_VertexBuffer || vertexBufferSize > m_VertexBuffer->GetSize())
-					m_VertexBuffer = VertexBuffer::Create(vertexBufferSize, VertexBufferUsage::Stream);
-				m_VertexBuffer->SetData(commandList->VtxBuffer.Data, vertexBufferSize);
+				memcpy(vertexStaging.GetData<uint8>(vertexStagingOffset), commandList->VtxBuffer.Data, commandList->VtxBuffer.Size * sizeof(ImDrawVert));
+				memcpy(indexStaging.GetData<uint8>(indexStagingOffset), commandList->IdxBuffer.Data, commandList->IdxBuffer.Size * sizeof(ImDrawIdx));
 
-				const uint32 indexBufferSize = commandList->IdxBuffer.Size * sizeof(ImDrawIdx);
-				if (!m_IndexBuffer || indexBufferSize > m_IndexBuffer->GetSize())
-					m_IndexBuffer = IndexBuffer::Create(indexBufferSize, IndexBufferUsage::Stream);
-				m_IndexBuffer->SetData(commandList->IdxBuffer.Data, indexBufferSize);
+				vertexStagingOffset += commandList->VtxBuffer.Size * sizeof(ImDrawVert);
+				indexStagingOffset += commandList->IdxBuffer.Size * sizeof(ImDrawIdx);
+			}
 
-				m_VertexBuffer->Bind();
-				m_Pipeline->Bind();
-				m_IndexBuffer->Bind();
+			const uint64 vertexBufferOffset = m_VertexBuffer->Upload(vertexStaging, sizeof(ImDrawVert));
+			const uint64 indexBufferOffset = m_IndexBuffer->Upload(indexStaging, sizeof(ImDrawIdx));
+
+			m_VertexBuffer->Bind();
+			m_Pipeline->Bind();
+			m_IndexBuffer->Bind();
+
+			constexpr IndexFormat indexFormat = sizeof(ImDrawIdx) == 2 ? IndexFormat::UInt16 : IndexFormat::UInt32;
+
+			uint32 globalVertexOffset = static_cast<uint32>(vertexBufferOffset / sizeof(ImDrawVert));
+			uint64 globalIndexOffset = indexBufferOffset;
+			for (int32 commandListIndex = 0; commandListIndex < drawData->CmdListsCount; commandListIndex++)
+			{
+				const ImDrawList* commandList = drawData->CmdLists[commandListIndex];
 
 				for (int32 commandIndex = 0; commandIndex < commandList->CmdBuffer.Size; commandIndex++)
 				{
@@ -726,16 +755,17 @@ namespace Flux {
 								it->second->Bind();
 						}
 
-						constexpr IndexFormat indexFormat = sizeof(ImDrawIdx) == 2 ? IndexFormat::UInt16 : IndexFormat::UInt32;
-
 						m_Pipeline->DrawIndexed(
 							indexFormat,
 							command->ElemCount,
-							command->IdxOffset * Utils::IndexFormatSize(indexFormat),
-							command->VtxOffset
+							static_cast<uint32>(globalIndexOffset + command->IdxOffset * Utils::IndexFormatSize(indexFormat)),
+							globalVertexOffset + command->VtxOffset
 						);
 					}
 				}
+
+				globalVertexOffset += commandList->VtxBuffer.Size;
+				globalIndexOffset += commandList->IdxBuffer.Size * Utils::IndexFormatSize(indexFormat);
 			}
 		}
 
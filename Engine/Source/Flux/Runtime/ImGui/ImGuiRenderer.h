@@ -2,8 +2,7 @@
 
 #include "Flux/Runtime/Renderer/Shader.h"
 #include "Flux/Runtime/Renderer/GraphicsPipeline.h"
-#include "Flux/Runtime/Renderer/VertexBuffer.h"
-#include "Flux/Runtime/Renderer/IndexBuffer.h"
+#include "Flux/Runtime/Renderer/StreamingBuffer.h"
 #include "Flux/Runtime/Renderer/Texture.h"
 
 #include "Flux/Runtime/Core/Events/WindowEvent.h"
@@ -45,6 +44,8 @@ namespace Flux {
 	class ImGuiRenderer : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::ImGui;
+
 		ImGuiRenderer();
 		virtual ~ImGuiRenderer();
 
@@ -91,8 +92,8 @@ namespace Flux {
 
 		Ref<Shader> m_Shader;
 		Ref<GraphicsPipeline> m_Pipeline;
-		Ref<VertexBuffer> m_VertexBuffer;
-		Ref<IndexBuffer> m_IndexBuffer;
+		Ref<StreamingBuffer> m_VertexBuffer;
+		Ref<StreamingBuffer> m_IndexBuffer;
 		Ref<Texture> m_FontTexture;
 
 		std::unordered_map<FontType, std::unordered_map<FontWeight, std::unordered_map<uint32, ImFont*>>> m_Fonts;
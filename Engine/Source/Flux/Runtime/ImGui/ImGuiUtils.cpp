@@ -84,6 +84,14 @@ namespace Flux {
 		ImGui::NextColumn();
 	}
 
+	bool UI::Property(std::string_view label, bool& value)
+	{
+		BeginProperty(label);
+		bool modified = ImGui::Checkbox(CreateUniqueID(), &value);
+		EndProperty();
+		return modified;
+	}
+
 	bool UI::Property(std::string_view label, int32& value, float speed, int32 minValue, int32 maxValue)
 	{
 		BeginProperty(label);
@@ -136,7 +144,7 @@ namespace Flux {
 
 		ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 8.0f);
 		ImGui::PushStyleColor(ImGuiCol_ChildBg, ImGui::GetStyleColorVec4(ImGuiCol_FrameBg));
-		ImGui::BeginChild(fmt::format("##{0}_SearchBar", id).c_str(), size, true, windowFlags);
+		ImGui::BeginChild(Utils::FrameFormat("##{0}_SearchBar", id).c_str(), size, true, windowFlags);
 		ImGui::PopStyleColor();
 		ImGui::PopStyleVar();
 
@@ -155,7 +163,7 @@ namespace Flux {
 			ImVec2 cursorPos = ImGui::GetCursorPos();
 			ImVec2 xMarkSize = ImGui::CalcTextSize(FLUX_ICON_XMARK);
 			xMarkSize.x += 0.5f;
-			if (ImGui::InvisibleButton(fmt::format("##{0}_SearchBar_Clear", id).c_str(), xMarkSize))
+			if (ImGui::InvisibleButton(Utils::FrameFormat("##{0}_SearchBar_Clear", id).c_str(), xMarkSize))
 			{
 				buffer.FillWithZeros();
 				modified |= true;
@@ -175,7 +183,7 @@ namespace Flux {
 		ImVec2 inputFieldPos = ImGui::GetCursorPos();
 		ImVec2 inputFieldSize = { ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y * 2.0f };
 		ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 0.0f);
-		modified |= ImGui::InputTextEx(fmt::format("##{0}_SearchBar_Input", id).c_str(), nullptr, (char*)buffer.Data, buffer.Size, inputFieldSize, 0);
+		modified |= ImGui::InputTextEx(Utils::FrameFormat("##{0}_SearchBar_Input", id).c_str(), nullptr, (char*)buffer.Data, buffer.Size, inputFieldSize, 0);
 		ImGui::PopStyleVar();
 
 		if (strlen((char*)buffer.Data) == 0)
@@ -218,7 +226,7 @@ namespace Flux {
 			ImGui::PopFont();
 
 			std::string directoryName = it->filename().stem().string();
-			std::string idString = fmt::format("##{0}_{1}", id, directoryName.c_str());
+			FrameString idString = Utils::FrameFormat("##{0}_{1}", id, directoryName.c_str());
 
 			if (ImGui::IsItemHovered() && ImGui::IsMouseReleased(ImGuiMouseButton_Left))
 				ImGui::OpenPopup(idString.c_str());
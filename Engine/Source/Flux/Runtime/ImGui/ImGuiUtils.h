@@ -17,6 +17,7 @@ namespace Flux {
 		void PushFormat(const char* format);
 		void PopFormat(uint32 count = 1);
 
+		bool Property(std::string_view label, bool& value);
 		bool Property(std::string_view label, int32& value, float speed = 1.0f, int32 minValue = 0, int32 maxValue = 0);
 
 		bool Property(std::string_view label, float& value, float speed = 1.0f, float minValue = 0.0f, float maxValue = 0.0f);
@@ -7,6 +7,8 @@
 #include "WindowsWindow.h"
 
 #include <ShObjIdl.h>
+#include <intrin.h>
+#include <DbgHelp.h>
 
 namespace Flux {
 
@@ -22,6 +24,29 @@ namespace Flux {
 			return result;
 		}
 
+		struct WaitableTimer
+		{
+			HANDLE Handle = NULL;
+
+			// How long before the deadline the timer wait ends and spinning starts.
+			// Adapts to how late the timer wakes up on this machine.
+			uint64 SpinTail = 1000 * 1000;
+
+			WaitableTimer()
+			{
+				Handle = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+				// High resolution timers need Windows 10 1803
+				if (!Handle)
+					Handle = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+			}
+
+			~WaitableTimer()
+			{
+				if (Handle)
+					CloseHandle(Handle);
+			}
+		};
+
 	}
 
 	extern HINSTANCE g_Instance;
@@ -39,6 +64,10 @@ namespace Flux {
 		int16 KeyCodes[512];
 		int16 ScanCodes[FLUX_KEY_LAST + 1];
 		char KeyNames[FLUX_KEY_LAST + 1][5];
+
+		// DbgHelp is not thread-safe, symbols are loaded on first use
+		std::mutex SymbolMutex;
+		bool SymbolsInitialized = false;
 	};
 
 	static WindowsPlatformData* s_Data = nullptr;
@@ -305,6 +334,9 @@ namespace Flux {
 
 	void Platform::Shutdown()
 	{
+		if (s_Data->SymbolsInitialized)
+			SymCleanup(GetCurrentProcess());
+
 		DestroyWindow(s_Data->HelperWindowHandle);
 
 		UnregisterClassW(MAKEINTATOM(s_Data->HelperWindowClass), g_Instance);
@@ -345,6 +377,39 @@ namespace Flux {
 			::Sleep(milliseconds);
 	}
 
+	void Platform::SleepUntil(uint64 nanoTime)
+	{
+		static constexpr uint64 s_MinSpinTail = 250 * 1000;
+		static constexpr uint64 s_MaxSpinTail = 16 * 1000 * 1000;
+
+		thread_local Utils::WaitableTimer timer;
+
+		uint64 now = GetNanoTime();
+		if (timer.Handle && now + timer.SpinTail < nanoTime)
+		{
+			uint64 wakeUpTime = nanoTime - timer.SpinTail;
+
+			// Relative due time in 100 nanosecond intervals
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -static_cast<int64>((wakeUpTime - now) / 100);
+
+			if (SetWaitableTimerEx(timer.Handle, &dueTime, 0, NULL, NULL, NULL, 0))
+			{
+				WaitForSingleObject(timer.Handle, INFINITE);
+
+				now = GetNanoTime();
+				uint64 lateness = now > wakeUpTime ? now - wakeUpTime : 0;
+
+				// Moves the spin tail towards the lateness plus some headroom
+				uint64 spinTail = (timer.SpinTail * 7 + lateness + s_MinSpinTail) / 8;
+				timer.SpinTail = Math::Clamp(spinTail, s_MinSpinTail, s_MaxSpinTail);
+			}
+		}
+
+		while (GetNanoTime() < nanoTime)
+			YieldProcessor();
+	}
+
 	float Platform::GetTime()
 	{
 		uint64 value = 0;
@@ -360,6 +425,11 @@ namespace Flux {
 		return value * (nsPerSecond / s_Data->TimerFrequency);
 	}
 
+	uint64 Platform::GetCycleCount()
+	{
+		return __rdtsc();
+	}
+
 	DialogResult Platform::OpenFolderDialog(Window* window, std::string* outPath, const std::string& title)
 	{
 		IFileOpenDialog* fileDialog = NULL;
@@ -509,6 +579,44 @@ namespace Flux {
 		::DebugBreak();
 	}
 
+	uint32 Platform::CaptureStackTrace(void** frames, uint32 maxFrames, uint32 skipFrames)
+	{
+		// Skip this function as well
+		return RtlCaptureStackBackTrace(skipFrames + 1, maxFrames, frames, NULL);
+	}
+
+	std::string Platform::GetSymbolName(void* address)
+	{
+		std::lock_guard<std::mutex> lock(s_Data->SymbolMutex);
+
+		HANDLE process = GetCurrentProcess();
+		if (!s_Data->SymbolsInitialized)
+		{
+			SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+			s_Data->SymbolsInitialized = SymInitialize(process, NULL, TRUE);
+			FLUX_ASSERT(s_Data->SymbolsInitialized, "SymInitialize failed. ({0})", Platform::GetErrorMessage());
+		}
+
+		DWORD64 symbolAddress = reinterpret_cast<DWORD64>(address);
+
+		alignas(SYMBOL_INFO) char symbolBuffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+		SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(symbolBuffer);
+		symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+		symbol->MaxNameLen = MAX_SYM_NAME;
+
+		if (!s_Data->SymbolsInitialized || !SymFromAddr(process, symbolAddress, NULL, symbol))
+			return fmt::format("0x{0:016x}", symbolAddress);
+
+		IMAGEHLP_LINE64 line = {};
+		line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+
+		DWORD displacement = 0;
+		if (SymGetLineFromAddr64(process, symbolAddress, &displacement, &line))
+			return fmt::format("{0} ({1}:{2})", symbol->Name, line.FileName, line.LineNumber);
+
+		return symbol->Name;
+	}
+
 	bool Platform::SetConsoleTitle(const std::string& title)
 	{
 		return ::SetConsoleTitleA(title.c_str());
@@ -11,6 +11,7 @@ namespace Flux {
 		m_ThreadHandle = CreateThread(NULL, NULL, ThreadProc, this, NULL, &m_ThreadID);
 
 		Platform::SetThreadName(m_ThreadHandle, createInfo.Name.c_str());
+		Profiler::SetThreadName(m_ThreadID, createInfo.Name);
 		Platform::SetThreadPriority(m_ThreadHandle, createInfo.Priority);
 
 		InitializeCriticalSection(&m_CriticalSection);
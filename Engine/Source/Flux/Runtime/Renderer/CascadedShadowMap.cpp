@@ -0,0 +1,203 @@
+#include "FluxPCH.h"
+#include "CascadedShadowMap.h"
+
+#include "Flux/Runtime/Core/Engine.h"
+#include "Flux/Runtime/Core/Hash.h"
+
+namespace Flux {
+
+	CascadedShadowMap::CascadedShadowMap()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		TextureProperties properties;
+		properties.Width = s_Resolution;
+		properties.Height = s_Resolution;
+		properties.Layers = s_CascadeCount;
+		properties.Format = TextureFormat::Depth24Stencil8;
+		properties.Usage = TextureUsage::Attachment;
+		properties.DepthComparison = true;
+		m_ShadowMap = Texture::Create(properties);
+		m_StaticCache = Texture::Create(properties);
+	}
+
+	CascadedShadowMap::~CascadedShadowMap()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+	}
+
+	void CascadedShadowMap::Update(const CascadedShadowMapViewInfo& viewInfo)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_PROFILE_FUNC();
+
+		m_Stats.StaticRenderCount = 0;
+
+		// Only rotates into light space, a translation would move the snapping grid with the camera
+		m_LightForward = viewInfo.LightDirection.Normalized();
+		Vector3 up = Math::Abs(m_LightForward.Y) < 0.99f ? Vector3(0.0f, 1.0f, 0.0f) : Vector3(1.0f, 0.0f, 0.0f);
+		m_LightRight = Vector3::Cross(up, m_LightForward).Normalized();
+		m_LightUp = Vector3::Cross(m_LightForward, m_LightRight);
+
+		const float nearClip = Math::Max(viewInfo.NearClip, 0.001f);
+		const float farClip = Math::Max(Math::Min(viewInfo.FarClip, viewInfo.ShadowDistance), nearClip * 2.0f);
+
+		// Squared extent of the frustum at a depth of one, from the center to a corner.
+		// Assumes a symmetric perspective projection, like the ones of the camera components.
+		const float tanHalfX = 1.0f / viewInfo.ProjectionMatrix[0][0];
+		const float tanHalfY = 1.0f / viewInfo.ProjectionMatrix[1][1];
+		const float cornerSquared = tanHalfX * tanHalfX + tanHalfY * tanHalfY;
+
+		const Matrix4x4 inverseViewMatrix = Matrix4x4::Inverse(viewInfo.ViewMatrix);
+
+		float splitNear = nearClip;
+		for (uint32 cascadeIndex = 0; cascadeIndex < s_CascadeCount; cascadeIndex++)
+		{
+			ShadowCascade& cascade = m_Cascades[cascadeIndex];
+
+			float p = static_cast<float>(cascadeIndex + 1) / static_cast<float>(s_CascadeCount);
+			float logSplit = nearClip * Math::Pow(farClip / nearClip, p);
+			float uniformSplit = nearClip + (farClip - nearClip) * p;
+			float splitFar = s_SplitLambda * logSplit + (1.0f - s_SplitLambda) * uniformSplit;
+
+			// Smallest sphere around the frustum slice, it only depends on the projection and the split depths,
+			// so its size stays the same while the camera rotates
+			float centerDepth = Math::Min(0.5f * (splitNear + splitFar) * (1.0f + cornerSquared), splitFar);
+			float farDistance = splitFar * splitFar * cornerSquared + (splitFar - centerDepth) * (splitFar - centerDepth);
+			float nearDistance = splitNear * splitNear * cornerSquared + (centerDepth - splitNear) * (centerDepth - splitNear);
+			float radius = Math::Sqrt(Math::Max(farDistance, nearDistance));
+			radius = Math::Ceil(radius * 16.0f) / 16.0f;
+
+			// The sphere fits inside the cascade wherever the snapped center ends up
+			const float snapTexels = static_cast<float>(s_SnapTexels);
+			float texelSize = 2.0f * radius / (static_cast<float>(s_Resolution) - 2.0f * snapTexels);
+			float halfExtent = radius + snapTexels * texelSize;
+			float snapSize = snapTexels * texelSize;
+
+			Vector4 worldCenter = inverseViewMatrix * Vector4(0.0f, 0.0f, centerDepth, 1.0f);
+			Vector3 center = Vector3(worldCenter.X, worldCenter.Y, worldCenter.Z);
+
+			int32 gridX = static_cast<int32>(Math::Round(Vector3::Dot(center, m_LightRight) / snapSize));
+			int32 gridY = static_cast<int32>(Math::Round(Vector3::Dot(center, m_LightUp) / snapSize));
+			int32 gridZ = static_cast<int32>(Math::Round(Vector3::Dot(center, m_LightForward) / snapSize));
+
+			cascade.Center = Vector3(static_cast<float>(gridX), static_cast<float>(gridY), static_cast<float>(gridZ)) * snapSize;
+			cascade.HalfExtent = halfExtent;
+			cascade.NearDepth = cascade.Center.Z - halfExtent - s_CasterDistance;
+			cascade.FarDepth = cascade.Center.Z + halfExtent;
+			cascade.SplitDepth = splitFar;
+			cascade.TexelSize = texelSize;
+
+			// Orthographic projection of the light space box, with the depth reversed like the view
+			const float depthRange = cascade.FarDepth - cascade.NearDepth;
+
+			Matrix4x4& viewProjection = cascade.ViewProjectionMatrix;
+			viewProjection = Matrix4x4(1.0f);
+			for (uint32 i = 0; i < 3; i++)
+			{
+				viewProjection[i][0] = m_LightRight[i] / halfExtent;
+				viewProjection[i][1] = m_LightUp[i] / halfExtent;
+				viewProjection[i][2] = -m_LightForward[i] / depthRange;
+				viewProjection[i][3] = 0.0f;
+			}
+			viewProjection[3][0] = -cascade.Center.X / halfExtent;
+			viewProjection[3][1] = -cascade.Center.Y / halfExtent;
+			viewProjection[3][2] = cascade.FarDepth / depthRange;
+			viewProjection[3][3] = 1.0f;
+
+			uint64 cascadeKey = 0;
+			Utils::HashCombine(cascadeKey, gridX);
+			Utils::HashCombine(cascadeKey, gridY);
+			Utils::HashCombine(cascadeKey, gridZ);
+			Utils::HashCombine(cascadeKey, halfExtent);
+			Utils::HashCombine(cascadeKey, m_LightForward.X);
+			Utils::HashCombine(cascadeKey, m_LightForward.Y);
+			Utils::HashCombine(cascadeKey, m_LightForward.Z);
+			m_CascadeKeys[cascadeIndex] = cascadeKey;
+
+			splitNear = splitFar;
+		}
+	}
+
+	bool CascadedShadowMap::IntersectsCascade(uint32 cascadeIndex, const Vector3& center, float radius) const
+	{
+		const ShadowCascade& cascade = m_Cascades[cascadeIndex];
+
+		float x = Vector3::Dot(center, m_LightRight) - cascade.Center.X;
+		float y = Vector3::Dot(center, m_LightUp) - cascade.Center.Y;
+		float z = Vector3::Dot(center, m_LightForward);
+
+		float extent = cascade.HalfExtent + radius;
+		return Math::Abs(x) <= extent && Math::Abs(y) <= extent && z + radius >= cascade.NearDepth && z - radius <= cascade.FarDepth;
+	}
+
+	bool CascadedShadowMap::UpdateStaticCache(uint32 cascadeIndex, uint32 staticCasterCount, uint32 dynamicCasterCount, uint64 staticCasterHash)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		uint64 key = m_CascadeKeys[cascadeIndex];
+		Utils::HashCombine(key, staticCasterCount);
+		Utils::HashCombine(key, staticCasterHash);
+
+		ShadowCascadeStats& stats = m_Stats.Cascades[cascadeIndex];
+		stats.StaticCasterCount = staticCasterCount;
+		stats.DynamicCasterCount = dynamicCasterCount;
+		stats.Cached = key == m_StaticCacheKeys[cascadeIndex];
+
+		if (stats.Cached)
+			return false;
+
+		m_StaticCacheKeys[cascadeIndex] = key;
+		m_Stats.StaticRenderCount++;
+		m_Stats.TotalStaticRenderCount++;
+		return true;
+	}
+
+	void CascadedShadowMap::SetUncachedCasters(uint32 cascadeIndex, uint32 casterCount)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		ShadowCascadeStats& stats = m_Stats.Cascades[cascadeIndex];
+		stats.StaticCasterCount = 0;
+		stats.DynamicCasterCount = casterCount;
+		stats.Cached = false;
+	}
+
+	void CascadedShadowMap::InvalidateStaticCache()
+	{
+		for (uint32 i = 0; i < s_CascadeCount; i++)
+		{
+			m_StaticCacheKeys[i] = 0;
+			m_Stats.Cascades[i].Cached = false;
+		}
+	}
+
+	void CascadedShadowMap::Bind(Ref<Shader> shader, uint32 slot) const
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_ShadowMap->Bind(slot);
+		shader->SetUniform("u_ShadowMap", static_cast<int32>(slot));
+
+		Vector4 splitDepths;
+		Vector4 texelSizes;
+		for (uint32 i = 0; i < s_CascadeCount; i++)
+		{
+			shader->SetUniform(fmt::format("u_ShadowMatrices[{0}]", i), m_Cascades[i].ViewProjectionMatrix);
+
+			splitDepths[i] = m_Cascades[i].SplitDepth;
+			texelSizes[i] = m_Cascades[i].TexelSize;
+		}
+
+		shader->SetUniform("u_CascadeSplits", splitDepths);
+		shader->SetUniform("u_CascadeTexelSizes", texelSizes);
+	}
+
+	void CascadedShadowMap::Unbind(uint32 slot) const
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_ShadowMap->Unbind(slot);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Shader.h"
+#include "Texture.h"
+
+namespace Flux {
+
+	struct ShadowCascade
+	{
+		Matrix4x4 ViewProjectionMatrix = Matrix4x4(1.0f);
+
+		// Light space bounds, the depth range reaches towards the light to include casters outside the view
+		Vector3 Center = Vector3(0.0f);
+		float HalfExtent = 0.0f;
+		float NearDepth = 0.0f;
+		float FarDepth = 0.0f;
+
+		// View depth at which the next cascade starts
+		float SplitDepth = 0.0f;
+		// Size of a shadow map texel in world units
+		float TexelSize = 0.0f;
+	};
+
+	struct ShadowCascadeStats
+	{
+		uint32 StaticCasterCount = 0;
+		uint32 DynamicCasterCount = 0;
+		// The static depth of the previous frames is still valid
+		bool Cached = false;
+	};
+
+	struct CascadedShadowMapStats
+	{
+		static constexpr uint32 s_MaxCascadeCount = 4;
+
+		ShadowCascadeStats Cascades[s_MaxCascadeCount];
+
+		// Cascades whose static depth was rendered again this frame, and in total
+		uint32 StaticRenderCount = 0;
+		uint64 TotalStaticRenderCount = 0;
+	};
+
+	struct CascadedShadowMapViewInfo
+	{
+		Matrix4x4 ViewMatrix;
+		Matrix4x4 ProjectionMatrix;
+		float NearClip;
+		float FarClip;
+
+		Vector3 LightDirection;
+		// Distance from the camera the cascades cover
+		float ShadowDistance;
+	};
+
+	// Shadow map of the directional light, split into cascades that cover increasing depth ranges of the view.
+	// Every cascade is fit around the bounding sphere of its part of the frustum, and its center is snapped to
+	// a grid of a few texels in light space. Rotating the camera doesn't change the cascades, and moving it
+	// only changes them when it crosses a grid line, so the shadow edges don't shimmer.
+	// The depth of static casters is kept in a second texture and copied into the shadow map every frame,
+	// so only the dynamic casters are rendered, until the cascade or the static casters in it change.
+	class CascadedShadowMap : public ReferenceCounted
+	{
+	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
+		CascadedShadowMap();
+		~CascadedShadowMap();
+
+		// Fits the cascades to the view
+		void Update(const CascadedShadowMapViewInfo& viewInfo);
+
+		// Whether a sphere in world space can cast a shadow into the cascade
+		bool IntersectsCascade(uint32 cascadeIndex, const Vector3& center, float radius) const;
+
+		// Sets the casters found in the cascade, and returns whether the static depth has to be rendered again
+		bool UpdateStaticCache(uint32 cascadeIndex, uint32 staticCasterCount, uint32 dynamicCasterCount, uint64 staticCasterHash);
+		// Sets the casters found in the cascade while static shadows aren't cached, all of them are rendered every frame
+		void SetUncachedCasters(uint32 cascadeIndex, uint32 casterCount);
+		void InvalidateStaticCache();
+
+		void Bind(Ref<Shader> shader, uint32 slot) const;
+		void Unbind(uint32 slot) const;
+
+		const ShadowCascade& GetCascade(uint32 index) const { return m_Cascades[index]; }
+		Ref<Texture> GetShadowMap() const { return m_ShadowMap; }
+		Ref<Texture> GetStaticCache() const { return m_StaticCache; }
+
+		const CascadedShadowMapStats& GetStats() const { return m_Stats; }
+
+		static constexpr uint32 s_CascadeCount = CascadedShadowMapStats::s_MaxCascadeCount;
+		static constexpr uint32 s_Resolution = 2048;
+	private:
+		// Texels kept free around the bounding sphere, the center moves in steps of this many texels
+		static constexpr uint32 s_SnapTexels = 32;
+		// How far the depth range reaches towards the light, beyond the cascade
+		static constexpr float s_CasterDistance = 200.0f;
+		// Blend between logarithmic and uniform split depths
+		static constexpr float s_SplitLambda = 0.75f;
+
+		ShadowCascade m_Cascades[s_CascadeCount];
+		uint64 m_StaticCacheKeys[s_CascadeCount] = {};
+		uint64 m_CascadeKeys[s_CascadeCount] = {};
+
+		Vector3 m_LightRight = Vector3(1.0f, 0.0f, 0.0f);
+		Vector3 m_LightUp = Vector3(0.0f, 1.0f, 0.0f);
+		Vector3 m_LightForward = Vector3(0.0f, 0.0f, 1.0f);
+
+		Ref<Texture> m_ShadowMap;
+		Ref<Texture> m_StaticCache;
+
+		CascadedShadowMapStats m_Stats;
+	};
+
+}
\ No newline at end of file
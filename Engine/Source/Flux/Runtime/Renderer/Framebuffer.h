@@ -9,6 +9,11 @@ namespace Flux {
 	{
 		TextureFormat Format;
 
+		// Rendered to instead of a texture owned by the framebuffer, must have the size of the framebuffer
+		Ref<Texture> Texture;
+		// Layer of a layered texture to render to
+		uint32 Layer = 0;
+
 		FramebufferAttachment() = default;
 		FramebufferAttachment(TextureFormat format)
 			: Format(format) {}
@@ -36,6 +41,8 @@ namespace Flux {
 	class Framebuffer : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		virtual ~Framebuffer() {}
 
 		virtual void Invalidate() = 0;
@@ -7,6 +7,8 @@ namespace Flux {
 	class GraphicsContext : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		virtual ~GraphicsContext() {}
 
 		virtual bool Init() = 0;
@@ -3,6 +3,7 @@
 #include "VertexDeclaration.h"
 
 #include "IndexBuffer.h"
+#include "CompareFunction.h"
 
 namespace Flux {
 
@@ -20,6 +21,14 @@ namespace Flux {
 		UInt8,
 	};
 
+	enum class BlendMode : uint8
+	{
+		None = 0,
+
+		Alpha,
+		Additive
+	};
+
 	struct GraphicsPipelineCreateInfo
 	{
 		Flux::VertexDeclaration VertexDeclaration;
@@ -28,12 +37,21 @@ namespace Flux {
 		bool DepthTest = true;
 		bool ScissorTest = false;
 		bool DepthWrite = true;
+		CompareFunction DepthCompareFunction = CompareFunction::GreaterOrEqual;
+		bool ColorWrite = true;
+		Flux::BlendMode BlendMode = Flux::BlendMode::Alpha;
 		bool BackfaceCulling = false;
+
+		// Pushes the depth away from the viewer (glPolygonOffset), e.g. for shadow casters. Negative with reversed depth.
+		float DepthBiasConstant = 0.0f;
+		float DepthBiasSlope = 0.0f;
 	};
 
 	class GraphicsPipeline : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		virtual ~GraphicsPipeline() {}
 
 		virtual void Bind() const = 0;
@@ -12,6 +12,8 @@ namespace Flux {
 	class IndexBuffer : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		virtual ~IndexBuffer() {}
 
 		virtual void Bind() const = 0;
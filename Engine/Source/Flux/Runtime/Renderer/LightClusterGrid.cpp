@@ -0,0 +1,327 @@
+#include "FluxPCH.h"
+#include "LightClusterGrid.h"
+
+#include "Renderer.h"
+
+#include "Flux/Runtime/Core/Engine.h"
+#include "Flux/Runtime/Core/JobSystem.h"
+
+#include <xmmintrin.h>
+
+namespace Flux {
+
+	LightClusterGrid::LightClusterGrid()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_StorageBuffer = StreamingBuffer::Create(256 * 1024, StreamingBufferType::Storage);
+		m_Slices.resize(s_SliceCount);
+	}
+
+	LightClusterGrid::~LightClusterGrid()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+	}
+
+	void LightClusterGrid::Build(const ClusterLight* lights, uint32 lightCount, const LightClusterGridViewInfo& viewInfo)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_PROFILE_FUNC();
+
+		uint64 startTime = Platform::GetNanoTime();
+
+		m_ViewportWidth = viewInfo.ViewportWidth;
+		m_ViewportHeight = viewInfo.ViewportHeight;
+
+		const float nearClip = Math::Max(viewInfo.NearClip, 0.001f);
+		const float farClip = Math::Max(viewInfo.FarClip, nearClip * 2.0f);
+
+		// slice = log(z) * scale + bias, so every slice covers the same depth ratio
+		m_SliceScale = static_cast<float>(s_SliceCount) / Math::Log(farClip / nearClip);
+		m_SliceBias = -Math::Log(nearClip) * m_SliceScale;
+
+		for (uint32 i = 0; i <= s_SliceCount; i++)
+			m_SliceDepths[i] = nearClip * Math::Pow(farClip / nearClip, static_cast<float>(i) / static_cast<float>(s_SliceCount));
+
+		// Tile edges in normalized device coordinates, scaled to the view space extent at a depth of one.
+		// Assumes a symmetric perspective projection, like the ones of the camera components.
+		const float unitDepthScaleX = 1.0f / viewInfo.ProjectionMatrix[0][0];
+		const float unitDepthScaleY = 1.0f / viewInfo.ProjectionMatrix[1][1];
+
+		for (uint32 x = 0; x <= s_TileCountX; x++)
+			m_TileEdgesX[x] = (-1.0f + 2.0f * static_cast<float>(x) / static_cast<float>(s_TileCountX)) * unitDepthScaleX;
+		for (uint32 y = 0; y <= s_TileCountY; y++)
+			m_TileEdgesY[y] = (-1.0f + 2.0f * static_cast<float>(y) / static_cast<float>(s_TileCountY)) * unitDepthScaleY;
+
+		// The shader reads at least one element of every buffer
+		StagingBuffer lightStaging = Renderer::AllocateStaging(Math::Max(lightCount, 1u) * sizeof(GPULight));
+		memset(lightStaging.Data, 0, lightStaging.Size);
+
+		GPULight* gpuLights = lightStaging.GetData<GPULight>();
+
+		m_ViewLights.resize(lightCount);
+		for (uint32 i = 0; i < lightCount; i++)
+		{
+			const ClusterLight& light = lights[i];
+
+			Vector4 viewPosition = viewInfo.ViewMatrix * Vector4(light.Position.X, light.Position.Y, light.Position.Z, 1.0f);
+			Vector4 viewDirection = viewInfo.ViewMatrix * Vector4(light.Direction.X, light.Direction.Y, light.Direction.Z, 0.0f);
+
+			ViewLight& viewLight = m_ViewLights[i];
+			viewLight.Position = Vector3(viewPosition.X, viewPosition.Y, viewPosition.Z);
+			viewLight.Radius = light.Range;
+			viewLight.Direction = Vector3(viewDirection.X, viewDirection.Y, viewDirection.Z);
+			viewLight.Spot = light.Spot;
+
+			float outerConeAngle = Math::Clamp(light.OuterConeAngle, 0.1f, 89.9f) * Math::DegToRad;
+			viewLight.CosAngle = Math::Cos(outerConeAngle);
+			viewLight.SinAngle = Math::Sin(outerConeAngle);
+
+			GPULight& gpuLight = gpuLights[i];
+			gpuLight.Position[0] = light.Position.X;
+			gpuLight.Position[1] = light.Position.Y;
+			gpuLight.Position[2] = light.Position.Z;
+			gpuLight.Range = light.Range;
+			gpuLight.Color[0] = light.Color.X;
+			gpuLight.Color[1] = light.Color.Y;
+			gpuLight.Color[2] = light.Color.Z;
+			gpuLight.Direction[0] = light.Direction.X;
+			gpuLight.Direction[1] = light.Direction.Y;
+			gpuLight.Direction[2] = light.Direction.Z;
+
+			if (light.Spot)
+			{
+				float cosInnerConeAngle = Math::Cos(Math::Clamp(light.InnerConeAngle, 0.0f, light.OuterConeAngle) * Math::DegToRad);
+				float cosOuterConeAngle = viewLight.CosAngle;
+
+				gpuLight.SpotScale = 1.0f / Math::Max(cosInnerConeAngle - cosOuterConeAngle, 0.0001f);
+				gpuLight.SpotOffset = -cosOuterConeAngle * gpuLight.SpotScale;
+			}
+			else
+			{
+				gpuLight.SpotScale = 0.0f;
+				gpuLight.SpotOffset = 1.0f;
+			}
+		}
+
+		{
+			FLUX_PROFILE_SCOPE("LightClusterGrid::BinSlices");
+
+			JobCounter counter;
+			JobSystem::Dispatch(counter, s_SliceCount, 1, [this](uint32 begin, uint32 end)
+			{
+				for (uint32 sliceIndex = begin; sliceIndex < end; sliceIndex++)
+					BinSlice(sliceIndex);
+			});
+			JobSystem::Wait(counter);
+		}
+
+		uint32 lightIndexCount = 0;
+		for (auto& slice : m_Slices)
+			lightIndexCount += static_cast<uint32>(slice.LightIndices.size());
+
+		StagingBuffer clusterStaging = Renderer::AllocateStaging(s_ClusterCount * sizeof(GPUCluster));
+		StagingBuffer lightIndexStaging = Renderer::AllocateStaging(Math::Max(lightIndexCount, 1u) * sizeof(uint32));
+
+		GPUCluster* gpuClusters = clusterStaging.GetData<GPUCluster>();
+		uint32* gpuLightIndices = lightIndexStaging.GetData<uint32>();
+		gpuLightIndices[0] = 0;
+
+		m_Stats = {};
+
+		// Offsets of the slices become offsets into the shared light index list
+		uint32 sliceOffset = 0;
+		for (uint32 sliceIndex = 0; sliceIndex < s_SliceCount; sliceIndex++)
+		{
+			auto& slice = m_Slices[sliceIndex];
+
+			GPUCluster* sliceClusters = gpuClusters + sliceIndex * s_TileCountX * s_TileCountY;
+			for (uint32 i = 0; i < s_TileCountX * s_TileCountY; i++)
+			{
+				const GPUCluster& cluster = slice.Clusters[i];
+				sliceClusters[i] = { cluster.Offset + sliceOffset, cluster.Count };
+
+				if (cluster.Count > 0)
+					m_Stats.ActiveClusterCount++;
+				m_Stats.MaxLightsPerCluster = Math::Max(m_Stats.MaxLightsPerCluster, cluster.Count);
+			}
+
+			if (!slice.LightIndices.empty())
+				memcpy(gpuLightIndices + sliceOffset, slice.LightIndices.data(), slice.LightIndices.size() * sizeof(uint32));
+
+			sliceOffset += static_cast<uint32>(slice.LightIndices.size());
+		}
+
+		m_LightRange = { m_StorageBuffer->Upload(lightStaging, StreamingBuffer::s_StorageAlignment), lightStaging.Size };
+		m_ClusterRange = { m_StorageBuffer->Upload(clusterStaging, StreamingBuffer::s_StorageAlignment), clusterStaging.Size };
+		m_LightIndexRange = { m_StorageBuffer->Upload(lightIndexStaging, StreamingBuffer::s_StorageAlignment), lightIndexStaging.Size };
+
+		uint64 endTime = Platform::GetNanoTime();
+
+		m_Stats.LightCount = lightCount;
+		m_Stats.LightIndexCount = lightIndexCount;
+		m_Stats.BinningTime = float(endTime - startTime) * 0.001f * 0.001f;
+	}
+
+	void LightClusterGrid::BinSlice(uint32 sliceIndex)
+	{
+		FLUX_PROFILE_FUNC();
+
+		SliceData& slice = m_Slices[sliceIndex];
+		slice.Groups.clear();
+		slice.Clusters.resize(s_TileCountX * s_TileCountY);
+		slice.LightIndices.clear();
+
+		const float sliceNear = m_SliceDepths[sliceIndex];
+		const float sliceFar = m_SliceDepths[sliceIndex + 1];
+
+		// Only the lights overlapping the depth range of the slice are tested against its froxels
+		uint32 candidateCount = 0;
+		for (uint32 i = 0; i < static_cast<uint32>(m_ViewLights.size()); i++)
+		{
+			const ViewLight& light = m_ViewLights[i];
+			if (light.Position.Z + light.Radius < sliceNear || light.Position.Z - light.Radius > sliceFar)
+				continue;
+
+			const uint32 lane = candidateCount & 3;
+			if (lane == 0)
+			{
+				// Unused lanes are infinitely far away, so they never touch a froxel
+				LightGroup& group = slice.Groups.emplace_back();
+				for (uint32 j = 0; j < 4; j++)
+				{
+					group.X[j] = std::numeric_limits<float>::max();
+					group.Y[j] = 0.0f;
+					group.Z[j] = 0.0f;
+					group.Radius[j] = 0.0f;
+					group.DirectionX[j] = 0.0f;
+					group.DirectionY[j] = 0.0f;
+					group.DirectionZ[j] = 1.0f;
+					group.CosAngle[j] = 1.0f;
+					group.SinAngle[j] = 0.0f;
+					group.Spot[j] = 0.0f;
+					group.LightIndex[j] = 0;
+				}
+			}
+
+			LightGroup& group = slice.Groups.back();
+			group.X[lane] = light.Position.X;
+			group.Y[lane] = light.Position.Y;
+			group.Z[lane] = light.Position.Z;
+			group.Radius[lane] = light.Radius;
+			group.DirectionX[lane] = light.Direction.X;
+			group.DirectionY[lane] = light.Direction.Y;
+			group.DirectionZ[lane] = light.Direction.Z;
+			group.CosAngle[lane] = light.CosAngle;
+			group.SinAngle[lane] = light.SinAngle;
+			group.Spot[lane] = light.Spot ? 1.0f : 0.0f;
+			group.LightIndex[lane] = i;
+
+			candidateCount++;
+		}
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 minZ = _mm_set1_ps(sliceNear);
+		const __m128 maxZ = _mm_set1_ps(sliceFar);
+
+		for (uint32 y = 0; y < s_TileCountY; y++)
+		{
+			// The froxel is widest at the far end of the slice on the outer side of the view axis
+			const float tileMinY = Math::Min(m_TileEdgesY[y] * sliceNear, m_TileEdgesY[y] * sliceFar);
+			const float tileMaxY = Math::Max(m_TileEdgesY[y + 1] * sliceNear, m_TileEdgesY[y + 1] * sliceFar);
+
+			for (uint32 x = 0; x < s_TileCountX; x++)
+			{
+				const float tileMinX = Math::Min(m_TileEdgesX[x] * sliceNear, m_TileEdgesX[x] * sliceFar);
+				const float tileMaxX = Math::Max(m_TileEdgesX[x + 1] * sliceNear, m_TileEdgesX[x + 1] * sliceFar);
+
+				GPUCluster& cluster = slice.Clusters[y * s_TileCountX + x];
+				cluster.Offset = static_cast<uint32>(slice.LightIndices.size());
+
+				const __m128 minX = _mm_set1_ps(tileMinX);
+				const __m128 maxX = _mm_set1_ps(tileMaxX);
+				const __m128 minY = _mm_set1_ps(tileMinY);
+				const __m128 maxY = _mm_set1_ps(tileMaxY);
+
+				// Bounding sphere of the froxel bounds for the cone test
+				const Vector3 extent = Vector3(tileMaxX - tileMinX, tileMaxY - tileMinY, sliceFar - sliceNear) * 0.5f;
+				const __m128 centerX = _mm_set1_ps(tileMinX + extent.X);
+				const __m128 centerY = _mm_set1_ps(tileMinY + extent.Y);
+				const __m128 centerZ = _mm_set1_ps(sliceNear + extent.Z);
+				const __m128 clusterRadius = _mm_set1_ps(extent.Length());
+
+				for (const LightGroup& group : slice.Groups)
+				{
+					const __m128 lightX = _mm_load_ps(group.X);
+					const __m128 lightY = _mm_load_ps(group.Y);
+					const __m128 lightZ = _mm_load_ps(group.Z);
+					const __m128 lightRadius = _mm_load_ps(group.Radius);
+
+					// Sphere against the froxel bounds, distance to the closest point of the bounds
+					const __m128 dx = _mm_add_ps(_mm_max_ps(_mm_sub_ps(minX, lightX), zero), _mm_max_ps(_mm_sub_ps(lightX, maxX), zero));
+					const __m128 dy = _mm_add_ps(_mm_max_ps(_mm_sub_ps(minY, lightY), zero), _mm_max_ps(_mm_sub_ps(lightY, maxY), zero));
+					const __m128 dz = _mm_add_ps(_mm_max_ps(_mm_sub_ps(minZ, lightZ), zero), _mm_max_ps(_mm_sub_ps(lightZ, maxZ), zero));
+					const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+					__m128 hit = _mm_cmple_ps(distanceSquared, _mm_mul_ps(lightRadius, lightRadius));
+					if (_mm_movemask_ps(hit) == 0)
+						continue;
+
+					const __m128 spot = _mm_cmpgt_ps(_mm_load_ps(group.Spot), zero);
+					if (_mm_movemask_ps(_mm_and_ps(hit, spot)) != 0)
+					{
+						// Cone against the bounding sphere of the froxel, the sphere is outside if it's
+						// beyond the cone angle, in front of the range or behind the apex of the cone
+						const __m128 vx = _mm_sub_ps(centerX, lightX);
+						const __m128 vy = _mm_sub_ps(centerY, lightY);
+						const __m128 vz = _mm_sub_ps(centerZ, lightZ);
+						const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+						const __m128 axisLength = _mm_add_ps(_mm_add_ps(
+							_mm_mul_ps(vx, _mm_load_ps(group.DirectionX)),
+							_mm_mul_ps(vy, _mm_load_ps(group.DirectionY))),
+							_mm_mul_ps(vz, _mm_load_ps(group.DirectionZ)));
+
+						const __m128 perpendicularLength = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(lengthSquared, _mm_mul_ps(axisLength, axisLength)), zero));
+						const __m128 closestDistance = _mm_sub_ps(
+							_mm_mul_ps(_mm_load_ps(group.CosAngle), perpendicularLength),
+							_mm_mul_ps(_mm_load_ps(group.SinAngle), axisLength));
+
+						const __m128 angleCull = _mm_cmpgt_ps(closestDistance, clusterRadius);
+						const __m128 frontCull = _mm_cmpgt_ps(axisLength, _mm_add_ps(clusterRadius, lightRadius));
+						const __m128 backCull = _mm_cmplt_ps(axisLength, _mm_sub_ps(zero, clusterRadius));
+						const __m128 cull = _mm_or_ps(angleCull, _mm_or_ps(frontCull, backCull));
+
+						hit = _mm_andnot_ps(_mm_and_ps(cull, spot), hit);
+					}
+
+					uint32 mask = static_cast<uint32>(_mm_movemask_ps(hit));
+					while (mask)
+					{
+						slice.LightIndices.push_back(group.LightIndex[std::countr_zero(mask)]);
+						mask &= mask - 1;
+					}
+				}
+
+				cluster.Count = static_cast<uint32>(slice.LightIndices.size()) - cluster.Offset;
+			}
+		}
+	}
+
+	void LightClusterGrid::Bind(Ref<Shader> shader) const
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_StorageBuffer->BindRange(s_LightBinding, m_LightRange.Offset, m_LightRange.Size);
+		m_StorageBuffer->BindRange(s_ClusterBinding, m_ClusterRange.Offset, m_ClusterRange.Size);
+		m_StorageBuffer->BindRange(s_LightIndexBinding, m_LightIndexRange.Offset, m_LightIndexRange.Size);
+
+		Vector2 tileSize;
+		tileSize.X = static_cast<float>(m_ViewportWidth) / static_cast<float>(s_TileCountX);
+		tileSize.Y = static_cast<float>(m_ViewportHeight) / static_cast<float>(s_TileCountY);
+
+		shader->SetUniform("u_ClusterTileSize", tileSize);
+		shader->SetUniform("u_ClusterSliceScale", m_SliceScale);
+		shader->SetUniform("u_ClusterSliceBias", m_SliceBias);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Shader.h"
+#include "StreamingBuffer.h"
+
+namespace Flux {
+
+	// Point or spot light in world space, point lights have no direction and a cone of 180 degrees
+	struct ClusterLight
+	{
+		Vector3 Position;
+		Vector3 Color;
+		float Range = 0.0f;
+
+		bool Spot = false;
+		Vector3 Direction = Vector3(0.0f, 0.0f, 1.0f);
+		// Half angles in degrees
+		float InnerConeAngle = 0.0f;
+		float OuterConeAngle = 0.0f;
+	};
+
+	struct LightClusterGridStats
+	{
+		uint32 LightCount = 0;
+		uint32 ActiveClusterCount = 0;
+		uint32 LightIndexCount = 0;
+		uint32 MaxLightsPerCluster = 0;
+
+		float BinningTime = 0.0f;
+	};
+
+	struct LightClusterGridViewInfo
+	{
+		Matrix4x4 ViewMatrix;
+		Matrix4x4 ProjectionMatrix;
+		float NearClip;
+		float FarClip;
+		uint32 ViewportWidth;
+		uint32 ViewportHeight;
+	};
+
+	// Splits the view frustum into froxels, screen tiles with exponentially distributed depth slices,
+	// and bins the lights into the froxels they touch. Every depth slice is binned by its own job,
+	// four lights at a time against a froxel. The shader finds the light list of a fragment from its
+	// window position and view depth, so its cost only depends on the lights near the fragment.
+	class LightClusterGrid : public ReferenceCounted
+	{
+	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
+		LightClusterGrid();
+		~LightClusterGrid();
+
+		// Bins the lights and uploads the light, cluster and light index buffers of this frame
+		void Build(const ClusterLight* lights, uint32 lightCount, const LightClusterGridViewInfo& viewInfo);
+
+		// Binds the buffers of the last build and sets the uniforms used to look up the clusters
+		void Bind(Ref<Shader> shader) const;
+
+		const LightClusterGridStats& GetStats() const { return m_Stats; }
+
+		static constexpr uint32 s_TileCountX = 16;
+		static constexpr uint32 s_TileCountY = 9;
+		static constexpr uint32 s_SliceCount = 24;
+		static constexpr uint32 s_ClusterCount = s_TileCountX * s_TileCountY * s_SliceCount;
+
+		// Shader storage binding points, have to match Shader.glsl
+		static constexpr uint32 s_LightBinding = 0;
+		static constexpr uint32 s_ClusterBinding = 1;
+		static constexpr uint32 s_LightIndexBinding = 2;
+	private:
+		void BinSlice(uint32 sliceIndex);
+	private:
+		// Layout of the light array in the shader (std430)
+		struct GPULight
+		{
+			float Position[3];
+			float Range;
+			float Color[3];
+			// Spot attenuation is saturate(dot(direction, -L) * SpotScale + SpotOffset), point lights have a scale of zero
+			float SpotScale;
+			float Direction[3];
+			float SpotOffset;
+		};
+
+		struct GPUCluster
+		{
+			uint32 Offset;
+			uint32 Count;
+		};
+
+		// View space lights, four per group so they can be tested at once
+		struct LightGroup
+		{
+			alignas(16) float X[4];
+			alignas(16) float Y[4];
+			alignas(16) float Z[4];
+			alignas(16) float Radius[4];
+
+			alignas(16) float DirectionX[4];
+			alignas(16) float DirectionY[4];
+			alignas(16) float DirectionZ[4];
+			alignas(16) float CosAngle[4];
+			alignas(16) float SinAngle[4];
+			// 1 for spot lights, 0 for point lights
+			alignas(16) float Spot[4];
+
+			uint32 LightIndex[4];
+		};
+
+		struct ViewLight
+		{
+			Vector3 Position;
+			float Radius;
+			Vector3 Direction;
+			float CosAngle;
+			float SinAngle;
+			bool Spot;
+		};
+
+		// Written by the job of the slice only
+		struct SliceData
+		{
+			std::vector<LightGroup> Groups;
+			std::vector<GPUCluster> Clusters;
+			std::vector<uint32> LightIndices;
+		};
+
+		std::vector<ViewLight> m_ViewLights;
+		std::vector<SliceData> m_Slices;
+
+		// Unit depth bounds of the tile columns and rows
+		float m_TileEdgesX[s_TileCountX + 1];
+		float m_TileEdgesY[s_TileCountY + 1];
+		float m_SliceDepths[s_SliceCount + 1];
+
+		Ref<StreamingBuffer> m_StorageBuffer;
+
+		struct BufferRange
+		{
+			uint64 Offset = 0;
+			uint64 Size = 0;
+		};
+
+		BufferRange m_LightRange;
+		BufferRange m_ClusterRange;
+		BufferRange m_LightIndexRange;
+
+		float m_SliceScale = 0.0f;
+		float m_SliceBias = 0.0f;
+		uint32 m_ViewportWidth = 0;
+		uint32 m_ViewportHeight = 0;
+
+		LightClusterGridStats m_Stats;
+	};
+
+}
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "FluxPCH.h"
 #include "Mesh.h"
 
+#include "MeshSimplifier.h"
+
+#include "Flux/Runtime/Core/JobSystem.h"
+
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/mesh.h>
@@ -22,11 +26,178 @@ namespace Flux {
 		aiProcess_ValidateDataStructure |
 		aiProcess_ConvertToLeftHanded;
 
+	namespace Utils {
+
+		// Centered on the bounding box, which is close enough for culling and level of detail selection
+		static void ComputeBoundingSphere(const Vertex* vertices, uint32 vertexCount, Vector3& outCenter, float& outRadius)
+		{
+			outCenter = Vector3(0.0f);
+			outRadius = 0.0f;
+
+			if (vertexCount == 0)
+				return;
+
+			Vector3 minBounds = vertices[0].Position;
+			Vector3 maxBounds = vertices[0].Position;
+			for (uint32 i = 1; i < vertexCount; i++)
+			{
+				const Vector3& position = vertices[i].Position;
+				minBounds = Vector3(Math::Min(minBounds.X, position.X), Math::Min(minBounds.Y, position.Y), Math::Min(minBounds.Z, position.Z));
+				maxBounds = Vector3(Math::Max(maxBounds.X, position.X), Math::Max(maxBounds.Y, position.Y), Math::Max(maxBounds.Z, position.Z));
+			}
+
+			outCenter = (minBounds + maxBounds) * 0.5f;
+
+			float radiusSquared = 0.0f;
+			for (uint32 i = 0; i < vertexCount; i++)
+				radiusSquared = Math::Max(radiusSquared, (vertices[i].Position - outCenter).LengthSquared());
+			outRadius = Math::Sqrt(radiusSquared);
+		}
+
+		static void ReadIndices(const std::vector<uint8>& indices, IndexFormat format, uint32 startIndexLocation, uint32 indexCount, std::vector<uint32>& outIndices)
+		{
+			outIndices.resize(indexCount);
+			for (uint32 i = 0; i < indexCount; i++)
+			{
+				switch (format)
+				{
+				case IndexFormat::UInt8:  outIndices[i] = indices[startIndexLocation + i]; break;
+				case IndexFormat::UInt16: outIndices[i] = *(const uint16*)&indices[startIndexLocation + i * sizeof(uint16)]; break;
+				case IndexFormat::UInt32: outIndices[i] = *(const uint32*)&indices[startIndexLocation + i * sizeof(uint32)]; break;
+				}
+			}
+		}
+
+		static void AppendIndices(std::vector<uint8>& indices, IndexFormat format, const std::vector<uint32>& values)
+		{
+			for (uint32 value : values)
+			{
+				switch (format)
+				{
+				case IndexFormat::UInt8:
+				{
+					indices.push_back((uint8)value);
+					break;
+				}
+				case IndexFormat::UInt16:
+				{
+					uint8 index[2];
+					*(uint16*)&index = (uint16)value;
+					indices.insert(indices.end(), index, index + 2);
+					break;
+				}
+				case IndexFormat::UInt32:
+				{
+					uint8 index[4];
+					*(uint32*)&index = value;
+					indices.insert(indices.end(), index, index + 4);
+					break;
+				}
+				}
+			}
+		}
+
+	}
+
 	Mesh::Mesh(const MeshProperties& properties)
 		: m_Properties(properties)
 	{
 		m_VertexBuffer = VertexBuffer::Create(properties.Vertices.data(), properties.Vertices.size() * sizeof(Vertex));
+
+		std::vector<Vector3> positions(properties.Vertices.size());
+		for (size_t i = 0; i < properties.Vertices.size(); i++)
+			positions[i] = properties.Vertices[i].Position;
+		m_PositionVertexBuffer = VertexBuffer::Create(positions.data(), positions.size() * sizeof(Vector3));
 		m_IndexBuffer = IndexBuffer::Create(properties.Indices.data(), properties.Indices.size());
+
+		for (auto& submesh : m_Properties.Submeshes)
+			Utils::ComputeBoundingSphere(m_Properties.Vertices.data() + submesh.BaseVertexLocation, submesh.VertexCount, submesh.BoundingSphereCenter, submesh.BoundingSphereRadius);
+	}
+
+	static void GenerateLODs(MeshProperties& properties, const MeshLODSettings& settings)
+	{
+		FLUX_PROFILE_FUNC();
+
+		if (settings.LODCount == 0)
+			return;
+
+		uint64 startTime = Platform::GetNanoTime();
+
+		const uint32 submeshCount = static_cast<uint32>(properties.Submeshes.size());
+
+		// Indices of every level, appended to the index buffer in submesh order once all submeshes are simplified
+		std::vector<std::vector<std::vector<uint32>>> lodIndices(submeshCount);
+
+		JobCounter counter;
+		JobSystem::Dispatch(counter, submeshCount, 1, [&properties, &settings, &lodIndices](uint32 begin, uint32 end)
+		{
+			for (uint32 submeshIndex = begin; submeshIndex < end; submeshIndex++)
+			{
+				SubmeshDescriptor& submesh = properties.Submeshes[submeshIndex];
+				if (submesh.IndexCount / 3 < settings.MinTriangleCount)
+					continue;
+
+				const Vertex* vertices = properties.Vertices.data() + submesh.BaseVertexLocation;
+
+				Vector3 center;
+				float radius;
+				Utils::ComputeBoundingSphere(vertices, submesh.VertexCount, center, radius);
+				if (radius <= 0.0f)
+					continue;
+
+				std::vector<Vector3> positions(submesh.VertexCount);
+				for (uint32 i = 0; i < submesh.VertexCount; i++)
+					positions[i] = vertices[i].Position;
+
+				std::vector<uint32> indices;
+				Utils::ReadIndices(properties.Indices, submesh.IndexFormat, submesh.StartIndexLocation, submesh.IndexCount, indices);
+
+				MeshSimplifier simplifier(positions.data(), submesh.VertexCount, indices.data(), submesh.IndexCount);
+
+				uint32 previousIndexCount = submesh.IndexCount;
+				float previousScreenSize = 1.0f;
+				for (uint32 lod = 0; lod < settings.LODCount; lod++)
+				{
+					uint32 targetIndexCount = static_cast<uint32>(static_cast<float>(previousIndexCount / 3) * settings.TriangleRatio) * 3;
+					uint32 indexCount = simplifier.Simplify(targetIndexCount, settings.MaxError * radius);
+
+					// Not worth a level if the error limit stopped the simplification early
+					if (indexCount == 0 || indexCount > previousIndexCount - previousIndexCount / 10)
+						break;
+
+					// The error is ErrorPixels pixels high at this screen size, where screen size = radius / distance * projection scale
+					float error = simplifier.GetError();
+					float screenSize = error > 0.0f ? 2.0f * settings.ErrorPixels * radius / (error * 1080.0f) : previousScreenSize;
+					screenSize = Math::Min(screenSize, previousScreenSize);
+
+					SubmeshLOD& submeshLOD = submesh.LODs.emplace_back();
+					submeshLOD.IndexCount = indexCount;
+					submeshLOD.Error = error;
+					submeshLOD.ScreenSize = screenSize;
+
+					simplifier.GetIndices(lodIndices[submeshIndex].emplace_back());
+
+					previousIndexCount = indexCount;
+					previousScreenSize = screenSize;
+				}
+			}
+		});
+		JobSystem::Wait(counter);
+
+		uint32 lodCount = 0;
+		for (uint32 submeshIndex = 0; submeshIndex < submeshCount; submeshIndex++)
+		{
+			SubmeshDescriptor& submesh = properties.Submeshes[submeshIndex];
+			for (uint32 lod = 0; lod < static_cast<uint32>(submesh.LODs.size()); lod++)
+			{
+				submesh.LODs[lod].StartIndexLocation = static_cast<uint32>(properties.Indices.size());
+				Utils::AppendIndices(properties.Indices, submesh.IndexFormat, lodIndices[submeshIndex][lod]);
+				lodCount++;
+			}
+		}
+
+		uint64 endTime = Platform::GetNanoTime();
+		FLUX_TRACE_CATEGORY("Mesh", "Generated {0} levels of detail for {1} submeshes ({2:.3f}ms)", lodCount, submeshCount, float(endTime - startTime) * 0.001f * 0.001f);
 	}
 
 	static void LoadMeshNode(const aiScene* scene, const aiNode* node, MeshProperties& properties, const Matrix4x4& parentTransform = Matrix4x4(1.0f))
@@ -145,7 +316,7 @@ namespace Flux {
 			LoadMeshNode(scene, node->mChildren[i], properties, worldTransform);
 	}
 
-	Ref<Mesh> Mesh::LoadFromFile(const std::filesystem::path& path)
+	Ref<Mesh> Mesh::LoadFromFile(const std::filesystem::path& path, const MeshLODSettings& lodSettings)
 	{
 		MeshProperties properties;
 
@@ -159,6 +330,7 @@ namespace Flux {
 		}
 
 		LoadMeshNode(scene, scene->mRootNode, properties);
+		GenerateLODs(properties, lodSettings);
 
 		if (scene->HasMaterials())
 		{
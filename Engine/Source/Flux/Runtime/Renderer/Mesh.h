@@ -20,6 +20,18 @@ namespace Flux {
 		Vector2 TexCoord;
 	};
 
+	struct SubmeshLOD
+	{
+		// Into the index buffer, like the indices of the submesh
+		uint32 StartIndexLocation;
+		uint32 IndexCount;
+
+		// Largest distance of the simplified surface from the submesh
+		float Error;
+		// Used once the bounding sphere covers less of the viewport height than this
+		float ScreenSize;
+	};
+
 	struct SubmeshDescriptor
 	{
 		uint32 BaseVertexLocation;
@@ -33,6 +45,13 @@ namespace Flux {
 		Matrix4x4 WorldTransform;
 		Matrix4x4 LocalTransform;
 
+		// Bounding sphere of the vertices, computed when the mesh is created
+		Vector3 BoundingSphereCenter = Vector3(0.0f);
+		float BoundingSphereRadius = 0.0f;
+
+		// Simplified versions of the submesh, coarser ones last. Level zero is the submesh itself.
+		std::vector<SubmeshLOD> LODs;
+
 		std::string Name;
 	};
 
@@ -51,6 +70,21 @@ namespace Flux {
 		std::string Name;
 	};
 
+	// How the levels of detail of the submeshes are generated when a mesh is imported
+	struct MeshLODSettings
+	{
+		// Generated levels per submesh, zero disables the generation
+		uint32 LODCount = 3;
+		// Triangles of a level relative to the previous one
+		float TriangleRatio = 0.5f;
+		// Smaller submeshes don't get levels of detail
+		uint32 MinTriangleCount = 256;
+		// Simplification stops once the surface moves further than this, relative to the submesh radius
+		float MaxError = 0.05f;
+		// A level is used once its error covers less than this many pixels of a 1080 pixel high viewport
+		float ErrorPixels = 1.0f;
+	};
+
 	struct MeshProperties
 	{
 		std::vector<Vertex> Vertices;
@@ -65,17 +99,20 @@ namespace Flux {
 		Mesh(const MeshProperties& properties);
 
 		Ref<VertexBuffer> GetVertexBuffer() const { return m_VertexBuffer; }
+		// Only the positions, for depth-only passes
+		Ref<VertexBuffer> GetPositionVertexBuffer() const { return m_PositionVertexBuffer; }
 		Ref<IndexBuffer> GetIndexBuffer() const { return m_IndexBuffer; }
 
 		const MeshProperties& GetProperties() const { return m_Properties; }
 
-		static Ref<Mesh> LoadFromFile(const std::filesystem::path& path);
+		static Ref<Mesh> LoadFromFile(const std::filesystem::path& path, const MeshLODSettings& lodSettings = {});
 
 		ASSET_CLASS_TYPE(Mesh)
 	private:
 		MeshProperties m_Properties;
 
 		Ref<VertexBuffer> m_VertexBuffer;
+		Ref<VertexBuffer> m_PositionVertexBuffer;
 		Ref<IndexBuffer> m_IndexBuffer;
 	};
 
@@ -0,0 +1,404 @@
+#include "FluxPCH.h"
+#include "MeshSimplifier.h"
+
+namespace Flux {
+
+	void MeshSimplifier::Quadric::AddPlane(const Vector3& normal, float distance, float weight)
+	{
+		const double a = normal.X;
+		const double b = normal.Y;
+		const double c = normal.Z;
+		const double d = distance;
+		const double w = weight;
+
+		A2 += w * a * a;
+		B2 += w * b * b;
+		C2 += w * c * c;
+		D2 += w * d * d;
+		AB += w * a * b;
+		AC += w * a * c;
+		AD += w * a * d;
+		BC += w * b * c;
+		BD += w * b * d;
+		CD += w * c * d;
+		Weight += w;
+	}
+
+	void MeshSimplifier::Quadric::Add(const Quadric& other)
+	{
+		A2 += other.A2;
+		B2 += other.B2;
+		C2 += other.C2;
+		D2 += other.D2;
+		AB += other.AB;
+		AC += other.AC;
+		AD += other.AD;
+		BC += other.BC;
+		BD += other.BD;
+		CD += other.CD;
+		Weight += other.Weight;
+	}
+
+	float MeshSimplifier::Quadric::Evaluate(const Vector3& position) const
+	{
+		if (Weight <= 0.0)
+			return 0.0f;
+
+		const double x = position.X;
+		const double y = position.Y;
+		const double z = position.Z;
+
+		double result = A2 * x * x + B2 * y * y + C2 * z * z + D2;
+		result += 2.0 * (AB * x * y + AC * x * z + BC * y * z);
+		result += 2.0 * (AD * x + BD * y + CD * z);
+		return static_cast<float>(Math::Max(result, 0.0) / Weight);
+	}
+
+	MeshSimplifier::MeshSimplifier(const Vector3* positions, uint32 vertexCount, const uint32* indices, uint32 indexCount)
+	{
+		FLUX_PROFILE_FUNC();
+
+		// Vertices that only differ in their other attributes are welded, so seams don't tear open
+		std::vector<uint32> sortedVertices(vertexCount);
+		for (uint32 i = 0; i < vertexCount; i++)
+			sortedVertices[i] = i;
+
+		std::sort(sortedVertices.begin(), sortedVertices.end(), [positions](uint32 a, uint32 b)
+		{
+			const Vector3& pa = positions[a];
+			const Vector3& pb = positions[b];
+			if (pa.X != pb.X)
+				return pa.X < pb.X;
+			if (pa.Y != pb.Y)
+				return pa.Y < pb.Y;
+			return pa.Z < pb.Z;
+		});
+
+		m_PositionIndices.resize(vertexCount);
+		for (uint32 i = 0; i < vertexCount; i++)
+		{
+			uint32 vertex = sortedVertices[i];
+			if (i == 0 || !(positions[vertex] == positions[sortedVertices[i - 1]]))
+				m_Positions.push_back(positions[vertex]);
+			m_PositionIndices[vertex] = static_cast<uint32>(m_Positions.size()) - 1;
+		}
+
+		const uint32 positionCount = static_cast<uint32>(m_Positions.size());
+		m_Quadrics.resize(positionCount);
+		m_Locked.resize(positionCount, false);
+		m_PositionTriangles.resize(positionCount);
+
+		// Edges between positions, the smaller position first
+		std::vector<std::pair<uint32, uint32>> edges;
+		edges.reserve(indexCount);
+
+		m_Triangles.reserve(indexCount / 3);
+		for (uint32 i = 0; i + 2 < indexCount; i += 3)
+		{
+			uint32 p0 = GetPosition(indices[i + 0]);
+			uint32 p1 = GetPosition(indices[i + 1]);
+			uint32 p2 = GetPosition(indices[i + 2]);
+			if (p0 == p1 || p1 == p2 || p2 == p0)
+				continue;
+
+			uint32 triangleIndex = static_cast<uint32>(m_Triangles.size());
+			auto& triangle = m_Triangles.emplace_back();
+			triangle.Corners[0] = indices[i + 0];
+			triangle.Corners[1] = indices[i + 1];
+			triangle.Corners[2] = indices[i + 2];
+
+			Vector3 normal = Vector3::Cross(m_Positions[p1] - m_Positions[p0], m_Positions[p2] - m_Positions[p0]);
+			float doubleArea = normal.Length();
+			if (doubleArea > 0.0f)
+			{
+				normal = normal * (1.0f / doubleArea);
+				float distance = -Vector3::Dot(normal, m_Positions[p0]);
+
+				for (uint32 position : { p0, p1, p2 })
+					m_Quadrics[position].AddPlane(normal, distance, doubleArea * 0.5f);
+			}
+
+			for (uint32 position : { p0, p1, p2 })
+				m_PositionTriangles[position].push_back(triangleIndex);
+
+			edges.emplace_back(Math::Min(p0, p1), Math::Max(p0, p1));
+			edges.emplace_back(Math::Min(p1, p2), Math::Max(p1, p2));
+			edges.emplace_back(Math::Min(p2, p0), Math::Max(p2, p0));
+		}
+
+		m_TriangleCount = static_cast<uint32>(m_Triangles.size());
+
+		// Edges of a single triangle lie on a border, edges of more than two aren't manifold.
+		// Moving their vertices would shrink the border or tear the mesh apart.
+		std::sort(edges.begin(), edges.end());
+		for (size_t i = 0; i < edges.size();)
+		{
+			size_t count = 1;
+			while (i + count < edges.size() && edges[i + count] == edges[i])
+				count++;
+
+			if (count != 2)
+			{
+				m_Locked[edges[i].first] = true;
+				m_Locked[edges[i].second] = true;
+			}
+
+			i += count;
+		}
+	}
+
+	uint32 MeshSimplifier::Simplify(uint32 targetIndexCount, float maxError)
+	{
+		FLUX_PROFILE_FUNC();
+
+		const float maxErrorSquared = maxError * maxError;
+		const uint32 positionCount = static_cast<uint32>(m_Positions.size());
+
+		std::vector<Collapse> bestCollapses(positionCount);
+		std::vector<bool> touched(positionCount);
+		std::vector<Collapse> collapses;
+
+		// Every pass collapses the cheapest edges around vertices that weren't changed by the pass yet,
+		// then the costs are computed again, until no edge can be collapsed anymore
+		while (GetIndexCount() > targetIndexCount)
+		{
+			for (auto& collapse : bestCollapses)
+			{
+				collapse.Target = ~0u;
+				collapse.Cost = std::numeric_limits<float>::max();
+			}
+
+			for (const Triangle& triangle : m_Triangles)
+			{
+				if (triangle.Removed)
+					continue;
+
+				for (uint32 corner = 0; corner < 3; corner++)
+				{
+					uint32 a = GetPosition(triangle.Corners[corner]);
+					uint32 b = GetPosition(triangle.Corners[(corner + 1) % 3]);
+
+					for (auto [source, target] : { std::pair(a, b), std::pair(b, a) })
+					{
+						if (m_Locked[source])
+							continue;
+
+						Quadric quadric = m_Quadrics[source];
+						quadric.Add(m_Quadrics[target]);
+
+						float cost = quadric.Evaluate(m_Positions[target]);
+						if (cost < bestCollapses[source].Cost)
+							bestCollapses[source] = { source, target, cost };
+					}
+				}
+			}
+
+			collapses.clear();
+			for (const Collapse& collapse : bestCollapses)
+			{
+				if (collapse.Target != ~0u)
+					collapses.push_back(collapse);
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+			std::fill(touched.begin(), touched.end(), false);
+
+			uint32 collapseCount = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (GetIndexCount() <= targetIndexCount || collapse.Cost > maxErrorSquared)
+					break;
+
+				if (touched[collapse.Source] || touched[collapse.Target])
+					continue;
+
+				if (!CanCollapse(collapse.Source, collapse.Target))
+					continue;
+
+				// The costs around the collapse are outdated until the next pass
+				for (uint32 triangleIndex : m_PositionTriangles[collapse.Source])
+				{
+					const Triangle& triangle = m_Triangles[triangleIndex];
+					if (triangle.Removed)
+						continue;
+
+					for (uint32 corner : triangle.Corners)
+						touched[GetPosition(corner)] = true;
+				}
+
+				PerformCollapse(collapse.Source, collapse.Target);
+				m_ErrorSquared = Math::Max(m_ErrorSquared, collapse.Cost);
+				collapseCount++;
+			}
+
+			if (collapseCount == 0)
+				break;
+		}
+
+		return GetIndexCount();
+	}
+
+	bool MeshSimplifier::CanCollapse(uint32 source, uint32 target) const
+	{
+		const Vector3& targetPosition = m_Positions[target];
+
+		for (uint32 triangleIndex : m_PositionTriangles[source])
+		{
+			const Triangle& triangle = m_Triangles[triangleIndex];
+			if (triangle.Removed)
+				continue;
+
+			uint32 positions[3];
+			bool containsTarget = false;
+			for (uint32 corner = 0; corner < 3; corner++)
+			{
+				positions[corner] = GetPosition(triangle.Corners[corner]);
+				containsTarget |= positions[corner] == target;
+			}
+
+			// Removed by the collapse
+			if (containsTarget)
+				continue;
+
+			// Every vertex at the source needs a vertex at the target with the same attributes, found through a shared triangle
+			for (uint32 corner = 0; corner < 3; corner++)
+			{
+				if (positions[corner] == source && FindReplacement(triangle.Corners[corner], target) == ~0u)
+					return false;
+			}
+
+			// The remaining triangles must not flip or collapse to a line
+			Vector3 before[3];
+			Vector3 after[3];
+			for (uint32 corner = 0; corner < 3; corner++)
+			{
+				before[corner] = m_Positions[positions[corner]];
+				after[corner] = positions[corner] == source ? targetPosition : before[corner];
+			}
+
+			Vector3 normalBefore = Vector3::Cross(before[1] - before[0], before[2] - before[0]);
+			Vector3 normalAfter = Vector3::Cross(after[1] - after[0], after[2] - after[0]);
+
+			float lengthsSquared = normalBefore.LengthSquared() * normalAfter.LengthSquared();
+			float dot = Vector3::Dot(normalBefore, normalAfter);
+			if (dot <= 0.0f || dot * dot < 0.05f * lengthsSquared)
+				return false;
+		}
+
+		return true;
+	}
+
+	void MeshSimplifier::PerformCollapse(uint32 source, uint32 target)
+	{
+		// Replacements are looked up before any triangle changes
+		std::pair<uint32, uint32> replacements[16];
+		uint32 replacementCount = 0;
+
+		auto findReplacement = [&](uint32 vertex)
+		{
+			for (uint32 i = 0; i < replacementCount; i++)
+			{
+				if (replacements[i].first == vertex)
+					return replacements[i].second;
+			}
+
+			uint32 replacement = FindReplacement(vertex, target);
+			if (replacementCount < std::size(replacements))
+				replacements[replacementCount++] = { vertex, replacement };
+			return replacement;
+		};
+
+		std::vector<uint32>& sourceTriangles = m_PositionTriangles[source];
+		std::vector<uint32>& targetTriangles = m_PositionTriangles[target];
+
+		std::vector<uint32> movedTriangles;
+		for (uint32 triangleIndex : sourceTriangles)
+		{
+			Triangle& triangle = m_Triangles[triangleIndex];
+			if (triangle.Removed)
+				continue;
+
+			bool containsTarget = false;
+			for (uint32 corner : triangle.Corners)
+				containsTarget |= GetPosition(corner) == target;
+
+			if (containsTarget)
+				continue;
+
+			for (uint32& corner : triangle.Corners)
+			{
+				if (GetPosition(corner) == source)
+					corner = findReplacement(corner);
+			}
+
+			movedTriangles.push_back(triangleIndex);
+		}
+
+		for (uint32 triangleIndex : sourceTriangles)
+		{
+			Triangle& triangle = m_Triangles[triangleIndex];
+			if (triangle.Removed)
+				continue;
+
+			bool containsSource = false;
+			for (uint32 corner : triangle.Corners)
+				containsSource |= GetPosition(corner) == source;
+
+			// Still at the source after the moves above, so it contained the collapsed edge
+			if (containsSource)
+			{
+				triangle.Removed = true;
+				m_TriangleCount--;
+			}
+		}
+
+		targetTriangles.insert(targetTriangles.end(), movedTriangles.begin(), movedTriangles.end());
+		std::erase_if(targetTriangles, [this](uint32 triangleIndex) { return m_Triangles[triangleIndex].Removed; });
+
+		sourceTriangles.clear();
+		sourceTriangles.shrink_to_fit();
+
+		m_Quadrics[target].Add(m_Quadrics[source]);
+	}
+
+	uint32 MeshSimplifier::FindReplacement(uint32 vertex, uint32 target) const
+	{
+		for (uint32 triangleIndex : m_PositionTriangles[GetPosition(vertex)])
+		{
+			const Triangle& triangle = m_Triangles[triangleIndex];
+			if (triangle.Removed)
+				continue;
+
+			bool containsVertex = false;
+			uint32 targetVertex = ~0u;
+			for (uint32 corner : triangle.Corners)
+			{
+				containsVertex |= corner == vertex;
+				if (GetPosition(corner) == target)
+					targetVertex = corner;
+			}
+
+			if (containsVertex && targetVertex != ~0u)
+				return targetVertex;
+		}
+
+		return ~0u;
+	}
+
+	void MeshSimplifier::GetIndices(std::vector<uint32>& outIndices) const
+	{
+		outIndices.clear();
+		outIndices.reserve(GetIndexCount());
+
+		for (const Triangle& triangle : m_Triangles)
+		{
+			if (triangle.Removed)
+				continue;
+
+			for (uint32 corner : triangle.Corners)
+				outIndices.push_back(corner);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+namespace Flux {
+
+	// Reduces the triangles of an indexed triangle list by collapsing edges, cheapest first,
+	// where the cost is the quadric error of Garland and Heckbert. Vertices are only ever collapsed into
+	// other existing vertices, so the simplified indices can be drawn with the original vertex buffer.
+	// Vertices at the same position are treated as one, vertices on open borders are never moved.
+	// Simplify can be called with decreasing targets to produce a chain of levels of detail.
+	class MeshSimplifier
+	{
+	public:
+		MeshSimplifier(const Vector3* positions, uint32 vertexCount, const uint32* indices, uint32 indexCount);
+
+		// Collapses edges until at most targetIndexCount indices are left, or the next collapse would move
+		// the surface further than maxError. Returns the number of indices left.
+		uint32 Simplify(uint32 targetIndexCount, float maxError);
+
+		void GetIndices(std::vector<uint32>& outIndices) const;
+		uint32 GetIndexCount() const { return m_TriangleCount * 3; }
+
+		// Largest distance the surface moved so far, in the units of the positions
+		float GetError() const { return Math::Sqrt(m_ErrorSquared); }
+	private:
+		struct Quadric
+		{
+			double A2 = 0.0, B2 = 0.0, C2 = 0.0, D2 = 0.0;
+			double AB = 0.0, AC = 0.0, AD = 0.0, BC = 0.0, BD = 0.0, CD = 0.0;
+			double Weight = 0.0;
+
+			void AddPlane(const Vector3& normal, float distance, float weight);
+			void Add(const Quadric& other);
+			// Weighted mean of the squared distances to the planes
+			float Evaluate(const Vector3& position) const;
+		};
+
+		struct Triangle
+		{
+			// Original vertex indices
+			uint32 Corners[3];
+			bool Removed = false;
+		};
+
+		struct Collapse
+		{
+			uint32 Source;
+			uint32 Target;
+			float Cost;
+		};
+
+		uint32 GetPosition(uint32 vertex) const { return m_PositionIndices[vertex]; }
+
+		bool CanCollapse(uint32 source, uint32 target) const;
+		void PerformCollapse(uint32 source, uint32 target);
+		// Original vertex at the target position that replaces a vertex at the source position, or ~0u if there is none
+		uint32 FindReplacement(uint32 vertex, uint32 target) const;
+	private:
+		// Vertices at the same position share a position index, the collapses work on positions
+		std::vector<uint32> m_PositionIndices;
+		std::vector<Vector3> m_Positions;
+		std::vector<Quadric> m_Quadrics;
+		std::vector<bool> m_Locked;
+		std::vector<std::vector<uint32>> m_PositionTriangles;
+
+		std::vector<Triangle> m_Triangles;
+		uint32 m_TriangleCount = 0;
+
+		float m_ErrorSquared = 0.0f;
+	};
+
+}
\ No newline at end of file
@@ -4,29 +4,14 @@
 #include "Flux/Runtime/Core/Engine.h"
 #include "Flux/Runtime/Renderer/Renderer.h"
 
+#include "OpenGLPipeline.h"
+
 #include <glad/glad.h>
 
 namespace Flux {
 
 	namespace Utils {
 
-		static uint32 OpenGLDepthCompareFunction(CompareFunction function)
-		{
-			switch (function)
-			{
-			case CompareFunction::Never:          return GL_NEVER;
-			case CompareFunction::Less:           return GL_LESS;
-			case CompareFunction::Equal:          return GL_EQUAL;
-			case CompareFunction::LessOrEqual:    return GL_LEQUAL;
-			case CompareFunction::Greater:        return GL_GREATER;
-			case CompareFunction::NotEqual:       return GL_NOTEQUAL;
-			case CompareFunction::GreaterOrEqual: return GL_GEQUAL;
-			case CompareFunction::Always:         return GL_ALWAYS;
-			}
-			FLUX_VERIFY(false, "Unknown compare function!");
-			return 0;
-		}
-
 		static const char* OpenGLFramebufferStatusToString(uint32 status)
 		{
 			switch (status)
@@ -56,17 +41,21 @@ namespace Flux {
 			m_Height = Engine::Get().GetMainWindow()->GetHeight();
 		}
 
-		m_Data = new OpenGLFramebufferData();
+		m_Data = ObjectPool<OpenGLFramebufferData>::Get().Create();
 
 		for (const auto& attachment : createInfo.Attachments)
 		{
-			TextureProperties properties;
-			properties.Width = m_Width;
-			properties.Height = m_Height;
-			properties.Format = attachment.Format;
-			properties.Usage = TextureUsage::Attachment;
+			Ref<Texture> texture = attachment.Texture;
+			if (!texture)
+			{
+				TextureProperties properties;
+				properties.Width = m_Width;
+				properties.Height = m_Height;
+				properties.Format = attachment.Format;
+				properties.Usage = TextureUsage::Attachment;
 
-			Ref<Texture> texture = Texture::Create(properties);
+				texture = Texture::Create(properties);
+			}
 
 			if (Utils::IsDepthFormat(attachment.Format))
 				m_DepthAttachment = texture;
@@ -85,7 +74,7 @@ namespace Flux {
 		{
 			if (data->FramebufferID)
 				glDeleteFramebuffers(1, &data->FramebufferID);
-			delete data;
+			ObjectPool<OpenGLFramebufferData>::Get().Destroy(data);
 		});
 	}
 
@@ -111,7 +100,7 @@ namespace Flux {
 			if (Utils::IsDepthFormat(attachment.Format))
 			{
 				TextureProperties properties = m_DepthAttachment->GetProperties();
-				if (properties.Width != m_Width || properties.Height != m_Height)
+				if (!attachment.Texture && (properties.Width != m_Width || properties.Height != m_Height))
 				{
 					properties.Width = m_Width;
 					properties.Height = m_Height;
@@ -119,12 +108,15 @@ namespace Flux {
 					m_DepthAttachment->Reinitialize(properties);
 				}
 
-				m_DepthAttachment->AttachToFramebuffer(attachmentIndex);
+				if (properties.Layers > 1)
+					m_DepthAttachment->AttachToFramebufferLayer(attachmentIndex, attachment.Layer);
+				else
+					m_DepthAttachment->AttachToFramebuffer(attachmentIndex);
 			}
 			else
 			{
 				TextureProperties properties = m_ColorAttachments[attachmentIndex]->GetProperties();
-				if (properties.Width != m_Width || properties.Height != m_Height)
+				if (!attachment.Texture && (properties.Width != m_Width || properties.Height != m_Height))
 				{
 					properties.Width = m_Width;
 					properties.Height = m_Height;
@@ -132,7 +124,10 @@ namespace Flux {
 					m_ColorAttachments[attachmentIndex]->Reinitialize(properties);
 				}
 
-				m_ColorAttachments[attachmentIndex]->AttachToFramebuffer(attachmentIndex);
+				if (properties.Layers > 1)
+					m_ColorAttachments[attachmentIndex]->AttachToFramebufferLayer(attachmentIndex, attachment.Layer);
+				else
+					m_ColorAttachments[attachmentIndex]->AttachToFramebuffer(attachmentIndex);
 			}
 
 			attachmentIndex++;
@@ -186,6 +181,9 @@ namespace Flux {
 
 			if ((hasColorAttachment || createInfo.SwapchainTarget) && createInfo.ClearColorBuffer)
 			{
+				// A depth-only pipeline may have masked the color writes
+				glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
 				const Vector4& clearColor = createInfo.ClearColor;
 				glClearColor(clearColor.R, clearColor.G, clearColor.B, clearColor.A);
 
@@ -195,7 +193,7 @@ namespace Flux {
 			if ((hasDepthAttachment || createInfo.SwapchainTarget) && createInfo.ClearDepthBuffer)
 			{
 				glDepthMask(GL_TRUE);
-				glDepthFunc(Utils::OpenGLDepthCompareFunction(createInfo.DepthCompareFunction));
+				glDepthFunc(Utils::OpenGLCompareFunction(createInfo.DepthCompareFunction));
 				glClearDepthf(createInfo.DepthClearValue);
 
 				clearFlags |= GL_DEPTH_BUFFER_BIT;
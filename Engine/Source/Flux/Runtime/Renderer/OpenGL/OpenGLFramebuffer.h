@@ -7,6 +7,8 @@ namespace Flux {
 	class OpenGLFramebuffer : public Framebuffer
 	{
 	public:
+		FLUX_POOLED_CLASS(OpenGLFramebuffer)
+
 		OpenGLFramebuffer(const FramebufferCreateInfo& createInfo);
 		virtual ~OpenGLFramebuffer();
 
@@ -31,7 +33,7 @@ namespace Flux {
 			uint32 FramebufferID;
 		};
 
-		OpenGLFramebufferData* m_Data = nullptr;
+		PoolHandle<OpenGLFramebufferData> m_Data;
 	};
 
 }
\ No newline at end of file
@@ -29,7 +29,7 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		m_Data = new OpenGLIndexBufferData();
+		m_Data = ObjectPool<OpenGLIndexBufferData>::Get().Create();
 
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, size, usage]() mutable
 		{
@@ -43,16 +43,16 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		m_Data = new OpenGLIndexBufferData();
+		m_Data = ObjectPool<OpenGLIndexBufferData>::Get().Create();
 
-		uint32 bufferIndex = m_Data->Storage.SetData(data, size);
+		StagingBuffer staging = Renderer::AllocateStaging(size);
+		memcpy(staging.Data, data, size);
 
-		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, bufferIndex, usage]() mutable
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, staging, usage]() mutable
 		{
-			Buffer buffer = data->Storage.GetBuffer(bufferIndex);
 			glCreateBuffers(1, &data->BufferID);
-			glNamedBufferData(data->BufferID, buffer.Size, buffer.Data, Utils::OpenGLBufferUsage(usage));
-			data->Storage.SetBufferAvailable(bufferIndex);
+			glNamedBufferData(data->BufferID, staging.Size, staging.Data, Utils::OpenGLBufferUsage(usage));
+			staging.Release();
 		});
 	}
 
@@ -64,13 +64,13 @@ namespace Flux {
 		{
 			if (data->BufferID)
 				glDeleteBuffers(1, &data->BufferID);
-			delete data;
+			ObjectPool<OpenGLIndexBufferData>::Get().Destroy(data);
 		});
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data]()
 		{
@@ -80,7 +80,7 @@ namespace Flux {
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([]()
 		{
@@ -92,13 +92,13 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		uint32 bufferIndex = m_Data->Storage.SetData(data, size);
+		StagingBuffer staging = Renderer::AllocateStaging(size);
+		memcpy(staging.Data, data, size);
 
-		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, bufferIndex, size, offset]() mutable
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, staging, offset]() mutable
 		{
-			Buffer buffer = data->Storage.GetBuffer(bufferIndex);
-			glNamedBufferSubData(data->BufferID, offset, size, buffer.GetData());
-			data->Storage.SetBufferAvailable(bufferIndex);
+			glNamedBufferSubData(data->BufferID, offset, staging.Size, staging.GetData());
+			staging.Release();
 		});
 	}
 
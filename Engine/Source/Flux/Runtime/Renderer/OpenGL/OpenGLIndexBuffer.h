@@ -7,6 +7,8 @@ namespace Flux {
 	class OpenGLIndexBuffer : public IndexBuffer
 	{
 	public:
+		FLUX_POOLED_CLASS(OpenGLIndexBuffer)
+
 		OpenGLIndexBuffer(uint64 size, IndexBufferUsage usage);
 		OpenGLIndexBuffer(const void* data, uint64 size, IndexBufferUsage usage);
 		virtual ~OpenGLIndexBuffer();
@@ -25,11 +27,10 @@ namespace Flux {
 
 		struct OpenGLIndexBufferData
 		{
-			RenderThreadStorage Storage;
 			uint32 BufferID;
 		};
 
-		OpenGLIndexBufferData* m_Data = nullptr;
+		PoolHandle<OpenGLIndexBufferData> m_Data;
 	};
 
 }
\ No newline at end of file
@@ -49,6 +49,23 @@ namespace Flux {
 			return 0;
 		}
 
+		uint32 OpenGLCompareFunction(CompareFunction function)
+		{
+			switch (function)
+			{
+			case CompareFunction::Never:          return GL_NEVER;
+			case CompareFunction::Less:           return GL_LESS;
+			case CompareFunction::Equal:          return GL_EQUAL;
+			case CompareFunction::LessOrEqual:    return GL_LEQUAL;
+			case CompareFunction::Greater:        return GL_GREATER;
+			case CompareFunction::NotEqual:       return GL_NOTEQUAL;
+			case CompareFunction::GreaterOrEqual: return GL_GEQUAL;
+			case CompareFunction::Always:         return GL_ALWAYS;
+			}
+			FLUX_VERIFY(false, "Unknown compare function!");
+			return 0;
+		}
+
 	}
 
 	OpenGLPipeline::OpenGLPipeline(const GraphicsPipelineCreateInfo& createInfo)
@@ -56,7 +73,7 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		m_Data = new OpenGLPipelineData();
+		m_Data = ObjectPool<OpenGLPipelineData>::Get().Create();
 		m_Data->CreateInfo = createInfo;
 
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data]() mutable
@@ -73,13 +90,13 @@ namespace Flux {
 		{
 			if (data->VertexArrayID)
 				glDeleteVertexArrays(1, &data->VertexArrayID);
-			delete data;
+			ObjectPool<OpenGLPipelineData>::Get().Destroy(data);
 		});
 	}
 
 	void OpenGLPipeline::Bind() const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 	
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data]()
 		{
@@ -120,9 +137,22 @@ namespace Flux {
 				}
 			}
 
-			glEnable(GL_BLEND);
-			glBlendEquation(GL_FUNC_ADD);
-			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+			switch (createInfo.BlendMode)
+			{
+			case BlendMode::None:
+				glDisable(GL_BLEND);
+				break;
+			case BlendMode::Alpha:
+				glEnable(GL_BLEND);
+				glBlendEquation(GL_FUNC_ADD);
+				glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+				break;
+			case BlendMode::Additive:
+				glEnable(GL_BLEND);
+				glBlendEquation(GL_FUNC_ADD);
+				glBlendFunc(GL_ONE, GL_ONE);
+				break;
+			}
 
 			if (createInfo.BackfaceCulling)
 			{
@@ -145,6 +175,20 @@ namespace Flux {
 				glDisable(GL_SCISSOR_TEST);
 
 			glDepthMask(createInfo.DepthWrite);
+			glDepthFunc(Utils::OpenGLCompareFunction(createInfo.DepthCompareFunction));
+
+			if (createInfo.DepthBiasConstant != 0.0f || createInfo.DepthBiasSlope != 0.0f)
+			{
+				glEnable(GL_POLYGON_OFFSET_FILL);
+				glPolygonOffset(createInfo.DepthBiasSlope, createInfo.DepthBiasConstant);
+			}
+			else
+			{
+				glDisable(GL_POLYGON_OFFSET_FILL);
+			}
+
+			GLboolean colorWrite = createInfo.ColorWrite ? GL_TRUE : GL_FALSE;
+			glColorMask(colorWrite, colorWrite, colorWrite, colorWrite);
 			// glDepthRange(1.0f, 0.0f);
 
 			glFrontFace(GL_CW);
@@ -157,7 +201,7 @@ namespace Flux {
 
 	void OpenGLPipeline::Unbind() const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data]()
 		{
@@ -174,7 +218,7 @@ namespace Flux {
 
 	void OpenGLPipeline::Scissor(int32 x, int32 y, int32 width, int32 height) const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([x, y, width, height]()
 		{
@@ -184,7 +228,7 @@ namespace Flux {
 
 	void OpenGLPipeline::DrawIndexed(IndexFormat indexFormat, uint32 indexCount, uint32 startIndexLocation, uint32 baseVertexLocation) const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, topology = m_Topology, indexFormat, indexCount, startIndexLocation, baseVertexLocation]()
 		{
@@ -7,6 +7,8 @@ namespace Flux {
 	class OpenGLPipeline : public GraphicsPipeline
 	{
 	public:
+		FLUX_POOLED_CLASS(OpenGLPipeline)
+
 		OpenGLPipeline(const GraphicsPipelineCreateInfo& createInfo);
 		virtual ~OpenGLPipeline();
 
@@ -25,7 +27,13 @@ namespace Flux {
 			uint32 VertexArrayID;
 		};
 
-		OpenGLPipelineData* m_Data = nullptr;
+		PoolHandle<OpenGLPipelineData> m_Data;
 	};
 
+	namespace Utils {
+
+		uint32 OpenGLCompareFunction(CompareFunction function);
+
+	}
+
 }
\ No newline at end of file
@@ -70,7 +70,7 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		m_Data = new OpenGLShaderData();
+		m_Data = ObjectPool<OpenGLShaderData>::Get().Create();
 
 		std::string source;
 		if (!FileHelper::LoadFileToString(source, path))
@@ -126,7 +126,7 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		m_Data = new OpenGLShaderData();
+		m_Data = ObjectPool<OpenGLShaderData>::Get().Create();
 
 		ShaderSourceMap sources;
 		sources[ShaderStage::Vertex] = vertexShaderSource;
@@ -185,13 +185,13 @@ namespace Flux {
 		{
 			if (data->ProgramID)
 				glDeleteProgram(data->ProgramID);
-			delete data;
+			ObjectPool<OpenGLShaderData>::Get().Destroy(data);
 		});
 	}
 
 	void OpenGLShader::Bind() const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data]()
 		{
@@ -201,7 +201,7 @@ namespace Flux {
 
 	void OpenGLShader::Unbind() const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([]()
 		{
@@ -213,7 +213,7 @@ namespace Flux {
 	{
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, name, value]()
 		{
-			glUniform1f(GetUniformLocation(data, name), value);
+			glUniform1f(GetUniformLocation(*data, name), value);
 		});
 	}
 
@@ -221,7 +221,7 @@ namespace Flux {
 	{
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, name, value]()
 		{
-			glUniform1i(GetUniformLocation(data, name), value);
+			glUniform1i(GetUniformLocation(*data, name), value);
 		});
 	}
 
@@ -229,7 +229,7 @@ namespace Flux {
 	{
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, name, value]()
 		{
-			glUniform1ui(GetUniformLocation(data, name), value);
+			glUniform1ui(GetUniformLocation(*data, name), value);
 		});
 	}
 
@@ -237,7 +237,7 @@ namespace Flux {
 	{
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, name, value]()
 		{
-			glUniform2fv(GetUniformLocation(data, name), 1, value.GetPointer());
+			glUniform2fv(GetUniformLocation(*data, name), 1, value.GetPointer());
 		});
 	}
 
@@ -245,7 +245,7 @@ namespace Flux {
 	{
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, name, value]()
 		{
-			glUniform3fv(GetUniformLocation(data, name), 1, value.GetPointer());
+			glUniform3fv(GetUniformLocation(*data, name), 1, value.GetPointer());
 		});
 	}
 
@@ -253,7 +253,7 @@ namespace Flux {
 	{
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, name, value]()
 		{
-			glUniform4fv(GetUniformLocation(data, name), 1, value.GetPointer());
+			glUniform4fv(GetUniformLocation(*data, name), 1, value.GetPointer());
 		});
 	}
 
@@ -261,25 +261,25 @@ namespace Flux {
 	{
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, name, value]()
 		{
-			glUniformMatrix4fv(GetUniformLocation(data, name), 1, GL_FALSE, value.GetPointer());
+			glUniformMatrix4fv(GetUniformLocation(*data, name), 1, GL_FALSE, value.GetPointer());
 		});
 	}
 
-	uint32 OpenGLShader::GetUniformLocation(OpenGLShaderData* data, const std::string& name)
+	uint32 OpenGLShader::GetUniformLocation(OpenGLShaderData& data, const std::string& name)
 	{
 		FLUX_CHECK_IS_IN_RENDER_THREAD();
 
-		auto it = data->UniformLocations.find(name);
-		if (it != data->UniformLocations.end())
+		auto it = data.UniformLocations.find(name);
+		if (it != data.UniformLocations.end())
 			return it->second;
 
-		uint32 location = glGetUniformLocation(data->ProgramID, name.c_str());
+		uint32 location = glGetUniformLocation(data.ProgramID, name.c_str());
 		if (location == -1)
 		{
 			// FLUX_VERIFY(false);
 		}
 
-		data->UniformLocations[name] = location;
+		data.UniformLocations[name] = location;
 		return location;
 	}
 
@@ -7,6 +7,8 @@ namespace Flux {
 	class OpenGLShader : public Shader
 	{
 	public:
+		FLUX_POOLED_CLASS(OpenGLShader)
+
 		OpenGLShader(const std::filesystem::path& path);
 		OpenGLShader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource);
 		virtual ~OpenGLShader();
@@ -24,7 +26,7 @@ namespace Flux {
 	private:
 		struct OpenGLShaderData;
 
-		static uint32 GetUniformLocation(OpenGLShaderData* data, const std::string& name);
+		static uint32 GetUniformLocation(OpenGLShaderData& data, const std::string& name);
 	private:
 		struct OpenGLShaderData
 		{
@@ -32,7 +34,7 @@ namespace Flux {
 			std::unordered_map<std::string, uint32> UniformLocations;
 		};
 
-		OpenGLShaderData* m_Data = nullptr;
+		PoolHandle<OpenGLShaderData> m_Data;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "FluxPCH.h"
+#include "OpenGLStreamingBuffer.h"
+
+#include "Flux/Runtime/Core/Engine.h"
+#include "Flux/Runtime/Renderer/Renderer.h"
+
+#include <glad/glad.h>
+
+namespace Flux {
+
+	namespace Utils {
+
+		static uint32 OpenGLStreamingBufferTarget(StreamingBufferType type)
+		{
+			switch (type)
+			{
+			case StreamingBufferType::Vertex: return GL_ARRAY_BUFFER;
+			case StreamingBufferType::Index:  return GL_ELEMENT_ARRAY_BUFFER;
+			case StreamingBufferType::Storage: return GL_SHADER_STORAGE_BUFFER;
+			}
+			FLUX_VERIFY(false, "Unknown streaming buffer type!");
+			return 0;
+		}
+
+		static void WaitForFence(GLsync fence)
+		{
+			while (true)
+			{
+				GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000 * 1000);
+				if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+					return;
+
+				if (result == GL_WAIT_FAILED)
+				{
+					FLUX_ERROR_CATEGORY("OpenGL", "Failed to wait for streaming buffer fence!");
+					return;
+				}
+			}
+		}
+
+	}
+
+	static constexpr GLbitfield s_StreamingBufferFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	OpenGLStreamingBuffer::OpenGLStreamingBuffer(uint64 regionSize, StreamingBufferType type)
+		: m_RegionSize(regionSize), m_Type(type)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_VERIFY(regionSize > 0);
+
+		m_Data = ObjectPool<OpenGLStreamingBufferData>::Get().Create();
+
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, size = regionSize * s_RegionCount]() mutable
+		{
+			glCreateBuffers(1, &data->BufferID);
+			glNamedBufferStorage(data->BufferID, size, nullptr, s_StreamingBufferFlags);
+			data->MappedData = static_cast<uint8*>(glMapNamedBufferRange(data->BufferID, 0, size, s_StreamingBufferFlags));
+		});
+	}
+
+	OpenGLStreamingBuffer::~OpenGLStreamingBuffer()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		FLUX_SUBMIT_RENDER_COMMAND_RELEASE([data = m_Data]() mutable
+		{
+			for (uint32 i = 0; i < s_RegionCount; i++)
+			{
+				if (data->Fences[i])
+					glDeleteSync(static_cast<GLsync>(data->Fences[i]));
+			}
+
+			if (data->BufferID)
+			{
+				glUnmapNamedBuffer(data->BufferID);
+				glDeleteBuffers(1, &data->BufferID);
+			}
+			ObjectPool<OpenGLStreamingBufferData>::Get().Destroy(data);
+		});
+	}
+
+	void OpenGLStreamingBuffer::Bind() const
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, target = Utils::OpenGLStreamingBufferTarget(m_Type)]()
+		{
+			glBindBuffer(target, data->BufferID);
+		});
+	}
+
+	void OpenGLStreamingBuffer::Unbind() const
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		FLUX_SUBMIT_RENDER_COMMAND([target = Utils::OpenGLStreamingBufferTarget(m_Type)]()
+		{
+			glBindBuffer(target, 0);
+		});
+	}
+
+	void OpenGLStreamingBuffer::BindRange(uint32 binding, uint64 offset, uint64 size) const
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_VERIFY(m_Type == StreamingBufferType::Storage);
+		FLUX_VERIFY(offset % s_StorageAlignment == 0);
+		FLUX_VERIFY(size > 0, "Empty ranges can't be bound");
+
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, binding, offset, size]()
+		{
+			glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, data->BufferID, offset, size);
+		});
+	}
+
+	uint64 OpenGLStreamingBuffer::Upload(StagingBuffer staging, uint64 alignment)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_VERIFY(alignment > 0);
+
+		uint64 frameIndex = Renderer::GetFrameIndex();
+		if (frameIndex != m_FrameIndex)
+			BeginRegion(frameIndex);
+
+		uint64 regionStart = m_RegionIndex * m_RegionSize;
+
+		// Alignments don't have to be powers of two, e.g. the vertex stride for base vertex draws
+		uint64 offset = (regionStart + m_RegionOffset + alignment - 1) / alignment * alignment;
+		if (offset + staging.Size > regionStart + m_RegionSize)
+		{
+			// Earlier uploads of this frame keep their offsets, so the first region has to cover them
+			uint64 regionSize = m_RegionSize * 2;
+			while (regionSize < offset + staging.Size)
+				regionSize *= 2;
+
+			FLUX_WARNING_CATEGORY("Renderer", "Growing streaming buffer regions from {0} bytes to {1} bytes", m_RegionSize, regionSize);
+
+			Reallocate(regionSize);
+			regionStart = 0;
+		}
+
+		m_RegionOffset = offset + staging.Size - regionStart;
+
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, staging, offset]() mutable
+		{
+			memcpy(data->MappedData + offset, staging.Data, staging.Size);
+			staging.Release();
+		});
+
+		return offset;
+	}
+
+	void OpenGLStreamingBuffer::BeginRegion(uint64 frameIndex)
+	{
+		bool firstRegion = m_FrameIndex == UINT64_MAX;
+		uint32 previousRegion = m_RegionIndex;
+
+		m_FrameIndex = frameIndex;
+		m_RegionIndex = (m_RegionIndex + 1) % s_RegionCount;
+		m_RegionOffset = 0;
+
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, firstRegion, previousRegion, region = m_RegionIndex]() mutable
+		{
+			// Every draw that reads the previous region has been submitted by now
+			if (!firstRegion)
+			{
+				if (data->Fences[previousRegion])
+					glDeleteSync(static_cast<GLsync>(data->Fences[previousRegion]));
+				data->Fences[previousRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			}
+
+			if (data->Fences[region])
+			{
+				Utils::WaitForFence(static_cast<GLsync>(data->Fences[region]));
+				glDeleteSync(static_cast<GLsync>(data->Fences[region]));
+				data->Fences[region] = nullptr;
+			}
+		});
+	}
+
+	void OpenGLStreamingBuffer::Reallocate(uint64 regionSize)
+	{
+		uint64 copyOffset = m_RegionIndex * m_RegionSize;
+		uint64 copySize = m_RegionOffset;
+
+		m_RegionSize = regionSize;
+		m_RegionIndex = 0;
+
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, size = regionSize * s_RegionCount, copyOffset, copySize]() mutable
+		{
+			uint32 bufferID = 0;
+			glCreateBuffers(1, &bufferID);
+			glNamedBufferStorage(bufferID, size, nullptr, s_StreamingBufferFlags);
+			uint8* mappedData = static_cast<uint8*>(glMapNamedBufferRange(bufferID, 0, size, s_StreamingBufferFlags));
+
+			// Mapped memory is write only, the uploads of the current frame are copied on the GPU
+			if (copySize > 0)
+				glCopyNamedBufferSubData(data->BufferID, bufferID, copyOffset, copyOffset, copySize);
+
+			// The GPU may still read the old buffer, deleting it is deferred by the driver
+			for (uint32 i = 0; i < s_RegionCount; i++)
+			{
+				if (data->Fences[i])
+					glDeleteSync(static_cast<GLsync>(data->Fences[i]));
+				data->Fences[i] = nullptr;
+			}
+
+			glUnmapNamedBuffer(data->BufferID);
+			glDeleteBuffers(1, &data->BufferID);
+
+			data->BufferID = bufferID;
+			data->MappedData = mappedData;
+		});
+	}
+
+}
\ No newline at end of file
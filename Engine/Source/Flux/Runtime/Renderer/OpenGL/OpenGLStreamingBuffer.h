@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Flux/Runtime/Renderer/StreamingBuffer.h"
+
+namespace Flux {
+
+	// Persistently and coherently mapped buffer storage, every region is guarded by a fence
+	class OpenGLStreamingBuffer : public StreamingBuffer
+	{
+	public:
+		FLUX_POOLED_CLASS(OpenGLStreamingBuffer)
+
+		OpenGLStreamingBuffer(uint64 regionSize, StreamingBufferType type);
+		virtual ~OpenGLStreamingBuffer();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+		virtual void BindRange(uint32 binding, uint64 offset, uint64 size) const override;
+
+		using StreamingBuffer::Upload;
+		virtual uint64 Upload(StagingBuffer staging, uint64 alignment = 1) override;
+
+		virtual uint64 GetRegionSize() const override { return m_RegionSize; }
+
+		virtual StreamingBufferType GetType() const override { return m_Type; }
+	private:
+		void BeginRegion(uint64 frameIndex);
+		void Reallocate(uint64 regionSize);
+	private:
+		uint64 m_RegionSize;
+		StreamingBufferType m_Type;
+
+		// Main thread
+		uint32 m_RegionIndex = 0;
+		uint64 m_RegionOffset = 0;
+		uint64 m_FrameIndex = UINT64_MAX;
+
+		struct OpenGLStreamingBufferData
+		{
+			uint32 BufferID = 0;
+			uint8* MappedData = nullptr;
+
+			// Signaled once the GPU has finished reading the region
+			void* Fences[s_RegionCount] = {};
+		};
+
+		PoolHandle<OpenGLStreamingBufferData> m_Data;
+	};
+
+}
\ No newline at end of file
@@ -91,7 +91,7 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		m_Data = new OpenGLTextureData();
+		m_Data = ObjectPool<OpenGLTextureData>::Get().Create();
 
 		Reinitialize(properties);
 
@@ -110,7 +110,7 @@ namespace Flux {
 		{
 			if (data->TextureID)
 				glDeleteTextures(1, &data->TextureID);
-			delete data;
+			ObjectPool<OpenGLTextureData>::Get().Destroy(data);
 		});
 
 		m_LocalStorage.Release();
@@ -125,7 +125,7 @@ namespace Flux {
 
 		if (properties.Usage == TextureUsage::Texture)
 		{
-			m_LocalStorage.Allocate(properties.Width * properties.Height * Utils::GetTextureFormatBPP(properties.Format));
+			m_LocalStorage.Allocate(properties.Width * properties.Height * Utils::GetTextureFormatBPP(properties.Format), MemoryTag::Renderer);
 			m_LocalStorage.FillWithZeros();
 		}
 
@@ -163,6 +163,17 @@ namespace Flux {
 				glTextureParameteri(data->TextureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 				glTextureParameteri(data->TextureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 			}
+
+			if (properties.DepthComparison)
+			{
+				// Reversed depth, the reference passes if it's at least as close as the stored depth
+				glTextureParameteri(data->TextureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTextureParameteri(data->TextureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				glTextureParameteri(data->TextureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTextureParameteri(data->TextureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				glTextureParameteri(data->TextureID, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+				glTextureParameteri(data->TextureID, GL_TEXTURE_COMPARE_FUNC, GL_GEQUAL);
+			}
 		});
 	}
 
@@ -170,11 +181,12 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
-		uint32 bufferIndex = m_Data->Storage.SetData(m_LocalStorage);
+		StagingBuffer staging = Renderer::AllocateStaging(m_LocalStorage.Size);
+		if (m_LocalStorage.Size > 0)
+			memcpy(staging.Data, m_LocalStorage.Data, m_LocalStorage.Size);
 
-		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, bufferIndex, properties = m_Properties]() mutable
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, staging, properties = m_Properties]() mutable
 		{
-			Buffer buffer = data->Storage.GetBuffer(bufferIndex);
 
 			if (properties.Layers > 1)
 			{
@@ -186,17 +198,17 @@ namespace Flux {
 					for (uint32 mip = 0; mip < properties.MipCount; mip++)
 					{
 						auto [width, height] = Utils::ComputeTextureMipSize(properties.Width, properties.Height, mip);
-						glTextureSubImage3D(data->TextureID, mip, 0, 0, 0, width, height, layer, data->Format, data->DataType, buffer.GetData(offset));
+						glTextureSubImage3D(data->TextureID, mip, 0, 0, 0, width, height, layer, data->Format, data->DataType, staging.GetData(offset));
 						offset += width * height * bytesPerPixel;
 					}
 				}
 			}
 			else
 			{
-				glTextureSubImage2D(data->TextureID, 0, 0, 0, properties.Width, properties.Height, data->Format, data->DataType, buffer.Data);
+				glTextureSubImage2D(data->TextureID, 0, 0, 0, properties.Width, properties.Height, data->Format, data->DataType, staging.Data);
 			}
 
-			data->Storage.SetBufferAvailable(bufferIndex);
+			staging.Release();
 
 			if (properties.MipCount > 1)
 				glGenerateTextureMipmap(data->TextureID);
@@ -225,9 +237,30 @@ namespace Flux {
 		});
 	}
 
+	void OpenGLTexture::CopyLayerTo(Ref<Texture> destination, uint32 layer) const
+	{
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
+
+		const auto& destinationProperties = destination->GetProperties();
+		FLUX_VERIFY(destinationProperties.Format == m_Properties.Format);
+		FLUX_VERIFY(destinationProperties.Width == m_Properties.Width && destinationProperties.Height == m_Properties.Height);
+		FLUX_VERIFY(layer < m_Properties.Layers && layer < destinationProperties.Layers);
+
+		Ref<OpenGLTexture> openGLDestination = destination.As<OpenGLTexture>();
+
+		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, destinationData = openGLDestination->m_Data, layer, width = m_Properties.Width, height = m_Properties.Height]()
+		{
+			glCopyImageSubData(
+				data->TextureID, data->TextureTarget, 0, 0, 0, layer,
+				destinationData->TextureID, destinationData->TextureTarget, 0, 0, 0, layer,
+				width, height, 1
+			);
+		});
+	}
+
 	void OpenGLTexture::Bind(uint32 slot) const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([data = m_Data, slot]()
 		{
@@ -237,7 +270,7 @@ namespace Flux {
 
 	void OpenGLTexture::Unbind(uint32 slot) const
 	{
-		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
 
 		FLUX_SUBMIT_RENDER_COMMAND([slot]()
 		{
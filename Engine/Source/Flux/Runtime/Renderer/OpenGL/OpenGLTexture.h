@@ -7,6 +7,8 @@ namespace Flux {
 	class OpenGLTexture : public Texture
 	{
 	public:
+		FLUX_POOLED_CLASS(OpenGLTexture)
+
 		OpenGLTexture(const TextureProperties& properties, const void* data);
 		virtual ~OpenGLTexture();
 
@@ -15,6 +17,8 @@ namespace Flux {
 		virtual void AttachToFramebuffer(uint32 attachmentIndex) override;
 		virtual void AttachToFramebufferLayer(uint32 attachmentIndex, uint32 layer) override;
 
+		virtual void CopyLayerTo(Ref<Texture> destination, uint32 layer) const override;
+
 		virtual void Bind(uint32 slot) const override;
 		virtual void Unbind(uint32 slot) const override;
 
@@ -28,8 +32,6 @@ namespace Flux {
 
 		struct OpenGLTextureData
 		{
-			RenderThreadStorage Storage;
-
 			uint32 TextureID;
 			uint32 TextureTarget;
 			uint32 Format;
@@ -37,7 +39,7 @@ namespace Flux {
 			uint32 DataType;
 		};
 
-		OpenGLTextureData* m_Data = nullptr;
+		PoolHandle<OpenGLTextureData> m_Data;
 	};
 
 }
\ No newline at end of file
@@ -7,6 +7,8 @@ namespace Flux {
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
 	public:
+		FLUX_POOLED_CLASS(OpenGLVertexBuffer)
+
 		OpenGLVertexBuffer(uint64 size, VertexBufferUsage usage);
 		OpenGLVertexBuffer(const void* data, uint64 size, VertexBufferUsage usage);
 		virtual ~OpenGLVertexBuffer();
@@ -25,11 +27,10 @@ namespace Flux {
 
 		struct OpenGLVertexBufferData
 		{
-			RenderThreadStorage Storage;
 			uint32 BufferID;
 		};
 
-		OpenGLVertexBufferData* m_Data = nullptr;
+		PoolHandle<OpenGLVertexBufferData> m_Data;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,602 @@
+#include "FluxPCH.h"
+#include "RenderGraph.h"
+
+#include "Flux/Runtime/Core/Engine.h"
+#include "Flux/Runtime/Core/Hash.h"
+#include "Flux/Runtime/Utils/FileHelper.h"
+#include "Flux/Runtime/Utils/StringUtils.h"
+
+namespace Flux {
+
+	namespace Utils {
+
+		static uint64 GetRenderGraphTextureSize(const RenderGraphTextureDesc& desc)
+		{
+			uint64 bytesPerPixel = desc.Format == TextureFormat::Depth24Stencil8 ? 4 : Utils::GetTextureFormatBPP(desc.Format);
+			return bytesPerPixel * desc.Width * desc.Height;
+		}
+
+		static const char* TextureFormatToString(TextureFormat format)
+		{
+			switch (format)
+			{
+			case TextureFormat::None:            return "None";
+			case TextureFormat::R8:              return "R8";
+			case TextureFormat::RG16:            return "RG16";
+			case TextureFormat::RGB24:           return "RGB24";
+			case TextureFormat::RGBA32:          return "RGBA32";
+			case TextureFormat::RFloat:          return "RFloat";
+			case TextureFormat::RGFloat:         return "RGFloat";
+			case TextureFormat::RGBFloat:        return "RGBFloat";
+			case TextureFormat::RGBAFloat:       return "RGBAFloat";
+			case TextureFormat::Depth24Stencil8: return "Depth24Stencil8";
+			}
+			FLUX_VERIFY(false, "Unknown texture format!");
+			return "";
+		}
+
+	}
+
+	RenderGraphResource RenderGraphBuilder::CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc)
+	{
+		FLUX_ASSERT(desc.Width > 0 && desc.Height > 0, "Transient texture '{0}' has no size", name);
+
+		RenderGraphResource resource;
+		resource.Index = static_cast<uint32>(m_Graph.m_Resources.size());
+
+		auto& node = m_Graph.m_Resources.emplace_back();
+		node.Name = name;
+		node.Desc = desc;
+		return resource;
+	}
+
+	void RenderGraphBuilder::Read(RenderGraphResource resource)
+	{
+		FLUX_ASSERT(resource.Index < m_Graph.m_Resources.size());
+
+		auto& pass = m_Graph.m_Passes[m_PassIndex];
+		FLUX_ASSERT(std::none_of(pass.Writes.begin(), pass.Writes.end(), [&](const auto& write) { return write.Resource == resource.Index; }),
+			"Pass '{0}' can't read and write '{1}'", pass.Name, m_Graph.m_Resources[resource.Index].Name);
+		FLUX_ASSERT(!m_Graph.m_Resources[resource.Index].Backbuffer, "The backbuffer can't be read");
+
+		pass.Reads.push_back(resource.Index);
+	}
+
+	void RenderGraphBuilder::Write(RenderGraphResource resource, const RenderGraphWriteInfo& writeInfo)
+	{
+		FLUX_ASSERT(resource.Index < m_Graph.m_Resources.size());
+
+		auto& pass = m_Graph.m_Passes[m_PassIndex];
+		FLUX_ASSERT(std::find(pass.Reads.begin(), pass.Reads.end(), resource.Index) == pass.Reads.end(),
+			"Pass '{0}' can't read and write '{1}'", pass.Name, m_Graph.m_Resources[resource.Index].Name);
+
+		auto& write = pass.Writes.emplace_back();
+		write.Resource = resource.Index;
+		write.Info = writeInfo;
+	}
+
+	void RenderGraphBuilder::SetSideEffect()
+	{
+		m_Graph.m_Passes[m_PassIndex].SideEffect = true;
+	}
+
+	Ref<Texture> RenderGraphPassContext::GetTexture(RenderGraphResource resource) const
+	{
+		FLUX_ASSERT(resource.Index < m_Graph.m_Resources.size());
+
+		auto& node = m_Graph.m_Resources[resource.Index];
+		if (node.ImportedTexture)
+			return node.ImportedTexture;
+		if (node.Backbuffer)
+			return nullptr;
+
+		uint32 physicalIndex = m_Graph.m_CompiledResources[resource.Index].PhysicalIndex;
+		FLUX_ASSERT(physicalIndex < m_Graph.m_PhysicalTextures.size(), "Texture '{0}' isn't used by any pass", node.Name);
+		return m_Graph.m_PhysicalTextures[physicalIndex].Texture;
+	}
+
+	uint32 RenderGraphPassContext::GetWidth() const
+	{
+		return m_Graph.m_CompiledPasses[m_PassIndex].Width;
+	}
+
+	uint32 RenderGraphPassContext::GetHeight() const
+	{
+		return m_Graph.m_CompiledPasses[m_PassIndex].Height;
+	}
+
+	RenderGraph::RenderGraph(const std::string& debugName)
+		: m_DebugName(debugName)
+	{
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+	}
+
+	void RenderGraph::Reset()
+	{
+		m_Passes.clear();
+		m_Resources.clear();
+	}
+
+	RenderGraphResource RenderGraph::ImportTexture(const std::string& name, Ref<Texture> texture)
+	{
+		FLUX_ASSERT(texture);
+
+		const auto& properties = texture->GetProperties();
+
+		RenderGraphResource resource;
+		resource.Index = static_cast<uint32>(m_Resources.size());
+
+		auto& node = m_Resources.emplace_back();
+		node.Name = name;
+		node.Desc.Format = properties.Format;
+		node.Desc.Width = properties.Width;
+		node.Desc.Height = properties.Height;
+		node.ImportedTexture = texture;
+		return resource;
+	}
+
+	RenderGraphResource RenderGraph::ImportBackbuffer(const std::string& name, const RenderGraphTextureDesc& desc)
+	{
+		RenderGraphResource resource;
+		resource.Index = static_cast<uint32>(m_Resources.size());
+
+		auto& node = m_Resources.emplace_back();
+		node.Name = name;
+		node.Desc = desc;
+		node.Backbuffer = true;
+		return resource;
+	}
+
+	void RenderGraph::AddPass(const std::string& name, const RenderGraphSetupFunction& setup, const RenderGraphExecuteFunction& execute)
+	{
+		uint32 passIndex = static_cast<uint32>(m_Passes.size());
+
+		auto& pass = m_Passes.emplace_back();
+		pass.Name = name;
+		pass.Execute = execute;
+
+		RenderGraphBuilder builder(*this, passIndex);
+		setup(builder);
+	}
+
+	void RenderGraph::Execute()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_PROFILE_FUNC();
+
+		uint64 hash = ComputeTopologyHash();
+		if (!m_Compiled || hash != m_CompiledHash)
+		{
+			Compile();
+
+			m_CompiledHash = hash;
+			m_Compiled = true;
+		}
+
+		for (uint32 passIndex = 0; passIndex < static_cast<uint32>(m_Passes.size()); passIndex++)
+		{
+			auto& pass = m_Passes[passIndex];
+			auto& compiledPass = m_CompiledPasses[passIndex];
+			if (compiledPass.Culled)
+				continue;
+
+			FLUX_PROFILE_SCOPE("RenderGraph::ExecutePass");
+
+			// OpenGL orders attachment writes and texture reads by itself,
+			// the barriers only have to be issued on explicit APIs
+			if (compiledPass.Framebuffer)
+				compiledPass.Framebuffer->Bind();
+
+			if (pass.Execute)
+				pass.Execute(RenderGraphPassContext(*this, passIndex));
+
+			if (compiledPass.Framebuffer)
+				compiledPass.Framebuffer->Unbind();
+		}
+	}
+
+	uint64 RenderGraph::ComputeTopologyHash() const
+	{
+		uint64 hash = 0;
+
+		for (auto& resource : m_Resources)
+		{
+			Utils::HashCombine(hash, resource.Name.data(), resource.Name.size());
+			Utils::HashCombine(hash, resource.Desc.Format);
+			Utils::HashCombine(hash, resource.Desc.Width);
+			Utils::HashCombine(hash, resource.Desc.Height);
+			Utils::HashCombine(hash, resource.ImportedTexture.Get());
+			Utils::HashCombine(hash, resource.Backbuffer);
+		}
+
+		for (auto& pass : m_Passes)
+		{
+			Utils::HashCombine(hash, pass.Name.data(), pass.Name.size());
+			Utils::HashCombine(hash, pass.Reads.data(), pass.Reads.size() * sizeof(uint32));
+			for (auto& write : pass.Writes)
+			{
+				Utils::HashCombine(hash, write.Resource);
+				Utils::HashCombine(hash, write.Info.Clear);
+				Utils::HashCombine(hash, write.Info.ClearColor.R);
+				Utils::HashCombine(hash, write.Info.ClearColor.G);
+				Utils::HashCombine(hash, write.Info.ClearColor.B);
+				Utils::HashCombine(hash, write.Info.ClearColor.A);
+				Utils::HashCombine(hash, write.Info.DepthClearValue);
+				Utils::HashCombine(hash, write.Info.DepthCompareFunction);
+				Utils::HashCombine(hash, write.Info.Layer);
+			}
+			Utils::HashCombine(hash, pass.SideEffect);
+		}
+
+		return hash;
+	}
+
+	void RenderGraph::Compile()
+	{
+		FLUX_PROFILE_FUNC();
+
+		uint64 startTime = Platform::GetNanoTime();
+
+		m_CompiledPasses.clear();
+		m_CompiledPasses.resize(m_Passes.size());
+		m_CompiledResources.clear();
+		m_CompiledResources.resize(m_Resources.size());
+
+		CullPasses();
+		ComputeLifetimes();
+		AssignPhysicalTextures();
+		ComputeBarriers();
+		CreateFramebuffers();
+
+		m_Stats.PassCount = static_cast<uint32>(m_Passes.size());
+		m_Stats.CulledPassCount = static_cast<uint32>(std::count_if(m_CompiledPasses.begin(), m_CompiledPasses.end(), [](const auto& pass) { return pass.Culled; }));
+		m_Stats.CompileCount++;
+
+		uint64 endTime = Platform::GetNanoTime();
+		m_Stats.CompileTime = float(endTime - startTime) * 0.001f * 0.001f;
+
+		FLUX_TRACE_CATEGORY("Renderer", "Compiled render graph '{0}': {1} passes ({2} culled), {3} transient textures in {4} textures ({5:.3f}ms)",
+			m_DebugName, m_Stats.PassCount, m_Stats.CulledPassCount, m_Stats.TransientTextureCount, m_Stats.PhysicalTextureCount, m_Stats.CompileTime);
+	}
+
+	void RenderGraph::CullPasses()
+	{
+		// Walks the passes backwards from the sinks. A transient texture is needed
+		// from the point an alive pass reads it, or keeps its contents, back to its last clear.
+		std::vector<bool> neededResources(m_Resources.size(), false);
+
+		for (int32 passIndex = static_cast<int32>(m_Passes.size()) - 1; passIndex >= 0; passIndex--)
+		{
+			auto& pass = m_Passes[passIndex];
+
+			bool alive = pass.SideEffect;
+			for (auto& write : pass.Writes)
+			{
+				if (!m_Resources[write.Resource].IsTransient() || neededResources[write.Resource])
+					alive = true;
+			}
+
+			m_CompiledPasses[passIndex].Culled = !alive;
+			if (!alive)
+				continue;
+
+			for (auto& write : pass.Writes)
+				neededResources[write.Resource] = !write.Info.Clear;
+			for (uint32 read : pass.Reads)
+				neededResources[read] = true;
+		}
+	}
+
+	void RenderGraph::ComputeLifetimes()
+	{
+		std::vector<bool> writtenResources(m_Resources.size(), false);
+
+		for (uint32 passIndex = 0; passIndex < static_cast<uint32>(m_Passes.size()); passIndex++)
+		{
+			if (m_CompiledPasses[passIndex].Culled)
+				continue;
+
+			auto& pass = m_Passes[passIndex];
+
+			auto useResource = [&](uint32 resourceIndex)
+			{
+				auto& compiledResource = m_CompiledResources[resourceIndex];
+				compiledResource.FirstPass = Math::Min(compiledResource.FirstPass, passIndex);
+				compiledResource.LastPass = passIndex;
+			};
+
+			for (uint32 read : pass.Reads)
+			{
+				if (m_Resources[read].IsTransient() && !writtenResources[read])
+					FLUX_ERROR_CATEGORY("Renderer", "Render graph '{0}': pass '{1}' reads '{2}' before it's written", m_DebugName, pass.Name, m_Resources[read].Name);
+
+				useResource(read);
+			}
+
+			for (auto& write : pass.Writes)
+			{
+				writtenResources[write.Resource] = true;
+				useResource(write.Resource);
+			}
+		}
+	}
+
+	void RenderGraph::AssignPhysicalTextures()
+	{
+		std::vector<uint32> transientResources;
+		for (uint32 resourceIndex = 0; resourceIndex < static_cast<uint32>(m_Resources.size()); resourceIndex++)
+		{
+			if (m_Resources[resourceIndex].IsTransient() && m_CompiledResources[resourceIndex].FirstPass != ~0u)
+				transientResources.push_back(resourceIndex);
+		}
+
+		std::sort(transientResources.begin(), transientResources.end(), [this](uint32 a, uint32 b)
+		{
+			return m_CompiledResources[a].FirstPass < m_CompiledResources[b].FirstPass;
+		});
+
+		m_Stats.TransientTextureCount = static_cast<uint32>(transientResources.size());
+		m_Stats.TransientMemory = 0;
+		m_Stats.AliasedMemory = 0;
+
+		// A texture is reused by the first transient texture of the same description that starts after its last use
+		std::vector<PhysicalTexture> physicalTextures;
+		for (uint32 resourceIndex : transientResources)
+		{
+			auto& resource = m_Resources[resourceIndex];
+			auto& compiledResource = m_CompiledResources[resourceIndex];
+
+			uint32 physicalIndex = 0;
+			for (; physicalIndex < static_cast<uint32>(physicalTextures.size()); physicalIndex++)
+			{
+				auto& physicalTexture = physicalTextures[physicalIndex];
+				if (physicalTexture.Desc == resource.Desc && physicalTexture.LastPass < compiledResource.FirstPass)
+					break;
+			}
+
+			if (physicalIndex == physicalTextures.size())
+			{
+				physicalTextures.emplace_back().Desc = resource.Desc;
+				m_Stats.AliasedMemory += Utils::GetRenderGraphTextureSize(resource.Desc);
+			}
+
+			physicalTextures[physicalIndex].LastPass = compiledResource.LastPass;
+			compiledResource.PhysicalIndex = physicalIndex;
+
+			m_Stats.TransientMemory += Utils::GetRenderGraphTextureSize(resource.Desc);
+		}
+
+		// Keeps the textures of the previous compilation, matching ones are taken as they are,
+		// the rest is reinitialized with the new size before any texture is created
+		std::vector<PhysicalTexture> previousTextures = std::move(m_PhysicalTextures);
+
+		for (auto& physicalTexture : physicalTextures)
+		{
+			auto it = std::find_if(previousTextures.begin(), previousTextures.end(), [&](const PhysicalTexture& previousTexture)
+			{
+				return previousTexture.Texture && previousTexture.Desc == physicalTexture.Desc;
+			});
+
+			if (it != previousTextures.end())
+				physicalTexture.Texture = std::move(it->Texture);
+		}
+
+		for (auto& physicalTexture : physicalTextures)
+		{
+			if (physicalTexture.Texture)
+				continue;
+
+			TextureProperties properties;
+			properties.Format = physicalTexture.Desc.Format;
+			properties.Usage = TextureUsage::Attachment;
+			properties.Width = physicalTexture.Desc.Width;
+			properties.Height = physicalTexture.Desc.Height;
+
+			auto it = std::find_if(previousTextures.begin(), previousTextures.end(), [&](const PhysicalTexture& previousTexture)
+			{
+				return previousTexture.Texture && previousTexture.Desc.Format == physicalTexture.Desc.Format;
+			});
+
+			if (it != previousTextures.end())
+			{
+				physicalTexture.Texture = std::move(it->Texture);
+				physicalTexture.Texture->Reinitialize(properties);
+			}
+			else
+			{
+				physicalTexture.Texture = Texture::Create(properties);
+			}
+		}
+
+		m_PhysicalTextures = std::move(physicalTextures);
+		m_Stats.PhysicalTextureCount = static_cast<uint32>(m_PhysicalTextures.size());
+	}
+
+	void RenderGraph::ComputeBarriers()
+	{
+		// Every resource starts the frame undefined, imported textures included
+		std::vector<RenderGraphResourceState> states(m_Resources.size(), RenderGraphResourceState::Undefined);
+
+		m_Stats.BarrierCount = 0;
+
+		for (uint32 passIndex = 0; passIndex < static_cast<uint32>(m_Passes.size()); passIndex++)
+		{
+			auto& compiledPass = m_CompiledPasses[passIndex];
+			if (compiledPass.Culled)
+				continue;
+
+			auto& pass = m_Passes[passIndex];
+
+			auto transition = [&](uint32 resourceIndex, RenderGraphResourceState state)
+			{
+				if (states[resourceIndex] == state)
+					return;
+
+				auto& barrier = compiledPass.Barriers.emplace_back();
+				barrier.Resource.Index = resourceIndex;
+				barrier.Before = states[resourceIndex];
+				barrier.After = state;
+
+				states[resourceIndex] = state;
+			};
+
+			for (uint32 read : pass.Reads)
+				transition(read, RenderGraphResourceState::ShaderRead);
+
+			for (auto& write : pass.Writes)
+			{
+				bool depth = Utils::IsDepthFormat(m_Resources[write.Resource].Desc.Format);
+				transition(write.Resource, depth ? RenderGraphResourceState::DepthAttachment : RenderGraphResourceState::ColorAttachment);
+			}
+
+			m_Stats.BarrierCount += static_cast<uint32>(compiledPass.Barriers.size());
+		}
+	}
+
+	void RenderGraph::CreateFramebuffers()
+	{
+		for (uint32 passIndex = 0; passIndex < static_cast<uint32>(m_Passes.size()); passIndex++)
+		{
+			auto& compiledPass = m_CompiledPasses[passIndex];
+			auto& pass = m_Passes[passIndex];
+			if (compiledPass.Culled || pass.Writes.empty())
+				continue;
+
+			FramebufferCreateInfo createInfo;
+			createInfo.ClearColorBuffer = false;
+			createInfo.ClearDepthBuffer = false;
+			createInfo.DebugLabel = fmt::format("{0} - {1}", m_DebugName, pass.Name);
+
+			// Color attachments come first, as the framebuffer numbers its color attachments in order
+			std::vector<const PassWrite*> writes;
+			for (auto& write : pass.Writes)
+			{
+				if (!Utils::IsDepthFormat(m_Resources[write.Resource].Desc.Format))
+					writes.push_back(&write);
+			}
+			for (auto& write : pass.Writes)
+			{
+				if (Utils::IsDepthFormat(m_Resources[write.Resource].Desc.Format))
+					writes.push_back(&write);
+			}
+
+			bool backbuffer = false;
+			for (const PassWrite* write : writes)
+			{
+				auto& resource = m_Resources[write->Resource];
+
+				if (write == writes.front())
+				{
+					createInfo.Width = resource.Desc.Width;
+					createInfo.Height = resource.Desc.Height;
+				}
+
+				FLUX_VERIFY(resource.Desc.Width == createInfo.Width && resource.Desc.Height == createInfo.Height,
+					"Render graph '{0}': the attachments of pass '{1}' differ in size", m_DebugName, pass.Name);
+
+				if (resource.Backbuffer)
+				{
+					backbuffer = true;
+				}
+				else
+				{
+					auto& attachment = createInfo.Attachments.emplace_back(resource.Desc.Format);
+					attachment.Texture = resource.ImportedTexture ? resource.ImportedTexture : m_PhysicalTextures[m_CompiledResources[write->Resource].PhysicalIndex].Texture;
+					attachment.Layer = write->Info.Layer;
+				}
+
+				if (Utils::IsDepthFormat(resource.Desc.Format))
+				{
+					createInfo.ClearDepthBuffer = write->Info.Clear;
+					createInfo.DepthClearValue = write->Info.DepthClearValue;
+					createInfo.DepthCompareFunction = write->Info.DepthCompareFunction;
+				}
+				else if (write->Info.Clear && !createInfo.ClearColorBuffer)
+				{
+					createInfo.ClearColorBuffer = true;
+					createInfo.ClearColor = write->Info.ClearColor;
+				}
+			}
+
+			FLUX_VERIFY(!backbuffer || createInfo.Attachments.empty(), "Render graph '{0}': pass '{1}' writes the backbuffer and textures", m_DebugName, pass.Name);
+			createInfo.SwapchainTarget = backbuffer;
+
+			compiledPass.Framebuffer = Framebuffer::Create(createInfo);
+			compiledPass.Width = createInfo.Width;
+			compiledPass.Height = createInfo.Height;
+		}
+	}
+
+	std::string RenderGraph::Dump() const
+	{
+		std::string result;
+		auto out = std::back_inserter(result);
+
+		fmt::format_to(out, "Render graph '{0}' (compiled {1} times, last compilation {2:.3f}ms)\n", m_DebugName, m_Stats.CompileCount, m_Stats.CompileTime);
+		if (!m_Compiled)
+			return result;
+
+		fmt::format_to(out, "\nPasses ({0}, {1} culled):\n", m_Stats.PassCount, m_Stats.CulledPassCount);
+		for (uint32 passIndex = 0; passIndex < static_cast<uint32>(m_Passes.size()); passIndex++)
+		{
+			auto& pass = m_Passes[passIndex];
+			auto& compiledPass = m_CompiledPasses[passIndex];
+
+			fmt::format_to(out, "  [{0}] {1}{2}{3}\n", passIndex, pass.Name, pass.SideEffect ? " (side effect)" : "", compiledPass.Culled ? " (culled)" : "");
+			if (compiledPass.Framebuffer)
+				fmt::format_to(out, "      framebuffer {0}x{1}\n", compiledPass.Width, compiledPass.Height);
+
+			for (uint32 read : pass.Reads)
+				fmt::format_to(out, "      reads  {0}\n", m_Resources[read].Name);
+			for (auto& write : pass.Writes)
+			{
+				fmt::format_to(out, "      writes {0}{1}{2}\n", m_Resources[write.Resource].Name,
+					write.Info.Layer > 0 ? fmt::format(" layer {0}", write.Info.Layer) : "", write.Info.Clear ? " (clear)" : " (load)");
+			}
+
+			for (auto& barrier : compiledPass.Barriers)
+			{
+				fmt::format_to(out, "      barrier {0}: {1} -> {2}\n", m_Resources[barrier.Resource.Index].Name,
+					Utils::RenderGraphResourceStateToString(barrier.Before), Utils::RenderGraphResourceStateToString(barrier.After));
+			}
+		}
+
+		fmt::format_to(out, "\nResources ({0}):\n", m_Resources.size());
+		for (uint32 resourceIndex = 0; resourceIndex < static_cast<uint32>(m_Resources.size()); resourceIndex++)
+		{
+			auto& resource = m_Resources[resourceIndex];
+			auto& compiledResource = m_CompiledResources[resourceIndex];
+
+			const char* kind = resource.Backbuffer ? "backbuffer" : resource.ImportedTexture ? "imported" : "transient";
+			fmt::format_to(out, "  [{0}] {1}: {2} {3} {4}x{5}", resourceIndex, resource.Name, kind,
+				Utils::TextureFormatToString(resource.Desc.Format), resource.Desc.Width, resource.Desc.Height);
+
+			if (compiledResource.FirstPass == ~0u)
+				fmt::format_to(out, ", unused");
+			else
+				fmt::format_to(out, ", passes {0}-{1}", compiledResource.FirstPass, compiledResource.LastPass);
+
+			if (compiledResource.PhysicalIndex != ~0u)
+				fmt::format_to(out, ", texture #{0}", compiledResource.PhysicalIndex);
+
+			fmt::format_to(out, "\n");
+		}
+
+		fmt::format_to(out, "\nTransient textures: {0} in {1} textures, {2} ({3} without aliasing)\n",
+			m_Stats.TransientTextureCount, m_Stats.PhysicalTextureCount,
+			StringUtils::FormatBytes(m_Stats.AliasedMemory), StringUtils::FormatBytes(m_Stats.TransientMemory));
+		fmt::format_to(out, "Barriers: {0}\n", m_Stats.BarrierCount);
+
+		return result;
+	}
+
+	bool RenderGraph::DumpToFile(const std::filesystem::path& path) const
+	{
+		return FileHelper::SaveStringToFile(Dump(), path);
+	}
+
+}
\ No newline at end of file
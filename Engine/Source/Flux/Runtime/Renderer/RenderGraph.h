@@ -0,0 +1,244 @@
+#pragma once
+
+#include "Framebuffer.h"
+
+namespace Flux {
+
+	struct RenderGraphResource
+	{
+		uint32 Index = ~0u;
+
+		bool IsValid() const { return Index != ~0u; }
+		operator bool() const { return IsValid(); }
+	};
+
+	enum class RenderGraphResourceState : uint8
+	{
+		Undefined = 0,
+
+		ColorAttachment,
+		DepthAttachment,
+		ShaderRead
+	};
+
+	struct RenderGraphTextureDesc
+	{
+		TextureFormat Format = TextureFormat::RGBA32;
+		uint32 Width = 0;
+		uint32 Height = 0;
+
+		bool operator==(const RenderGraphTextureDesc& other) const = default;
+	};
+
+	// How a pass writes one of its attachments
+	struct RenderGraphWriteInfo
+	{
+		// Otherwise the previous contents are kept, which makes the pass depend on the previous writer
+		bool Clear = true;
+
+		Vector4 ClearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+		float DepthClearValue = 0.0f;
+		CompareFunction DepthCompareFunction = CompareFunction::GreaterOrEqual;
+
+		// Layer of a layered texture the pass renders to
+		uint32 Layer = 0;
+	};
+
+	struct RenderGraphBarrier
+	{
+		RenderGraphResource Resource;
+		RenderGraphResourceState Before;
+		RenderGraphResourceState After;
+	};
+
+	struct RenderGraphStats
+	{
+		uint32 PassCount = 0;
+		uint32 CulledPassCount = 0;
+		uint32 TransientTextureCount = 0;
+		uint32 PhysicalTextureCount = 0;
+		uint32 BarrierCount = 0;
+
+		// Bytes of the transient textures with and without aliasing
+		uint64 TransientMemory = 0;
+		uint64 AliasedMemory = 0;
+
+		uint32 CompileCount = 0;
+		float CompileTime = 0.0f;
+	};
+
+	class RenderGraph;
+
+	class RenderGraphBuilder
+	{
+	public:
+		// Transient textures only live as long as the passes using them, their memory is shared with other transient textures
+		RenderGraphResource CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+
+		// The pass samples the texture
+		void Read(RenderGraphResource resource);
+		// The pass renders to the texture
+		void Write(RenderGraphResource resource, const RenderGraphWriteInfo& writeInfo = {});
+
+		// The pass is never culled, even if nothing reads its results
+		void SetSideEffect();
+	private:
+		RenderGraphBuilder(RenderGraph& graph, uint32 passIndex)
+			: m_Graph(graph), m_PassIndex(passIndex) {}
+	private:
+		RenderGraph& m_Graph;
+		uint32 m_PassIndex;
+
+		friend class RenderGraph;
+	};
+
+	class RenderGraphPassContext
+	{
+	public:
+		Ref<Texture> GetTexture(RenderGraphResource resource) const;
+		uint32 GetWidth() const;
+		uint32 GetHeight() const;
+	private:
+		RenderGraphPassContext(const RenderGraph& graph, uint32 passIndex)
+			: m_Graph(graph), m_PassIndex(passIndex) {}
+	private:
+		const RenderGraph& m_Graph;
+		uint32 m_PassIndex;
+
+		friend class RenderGraph;
+	};
+
+	using RenderGraphSetupFunction = std::function<void(RenderGraphBuilder&)>;
+	using RenderGraphExecuteFunction = std::function<void(const RenderGraphPassContext&)>;
+
+	// Passes and resources are declared every frame. The graph is only compiled again if the declared
+	// topology changed: passes whose results are never used are culled, the state transitions between
+	// the passes are computed, transient textures with non-overlapping lifetimes share the same texture,
+	// and the framebuffers of the passes are created.
+	// Writing to an imported texture or the backbuffer, or setting a side effect, keeps a pass alive.
+	class RenderGraph : public ReferenceCounted
+	{
+	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
+		RenderGraph(const std::string& debugName);
+		~RenderGraph();
+
+		// Clears the declarations of the previous frame, the compiled graph is kept
+		void Reset();
+
+		// The texture outlives the graph
+		RenderGraphResource ImportTexture(const std::string& name, Ref<Texture> texture);
+		// The default framebuffer of the main window
+		RenderGraphResource ImportBackbuffer(const std::string& name, const RenderGraphTextureDesc& desc);
+
+		// Passes are executed in the order they are added, so a pass can only read results of earlier passes
+		void AddPass(const std::string& name, const RenderGraphSetupFunction& setup, const RenderGraphExecuteFunction& execute);
+
+		// Compiles the graph if its topology changed, and executes the passes that weren't culled
+		void Execute();
+
+		// Human readable description of the compiled graph
+		std::string Dump() const;
+		bool DumpToFile(const std::filesystem::path& path) const;
+
+		const RenderGraphStats& GetStats() const { return m_Stats; }
+		const std::string& GetDebugName() const { return m_DebugName; }
+	private:
+		uint64 ComputeTopologyHash() const;
+		void Compile();
+
+		void CullPasses();
+		void ComputeLifetimes();
+		void AssignPhysicalTextures();
+		void ComputeBarriers();
+		void CreateFramebuffers();
+	private:
+		struct ResourceNode
+		{
+			std::string Name;
+			RenderGraphTextureDesc Desc;
+
+			Ref<Texture> ImportedTexture;
+			bool Backbuffer = false;
+
+			bool IsTransient() const { return !ImportedTexture && !Backbuffer; }
+		};
+
+		struct PassWrite
+		{
+			uint32 Resource;
+			RenderGraphWriteInfo Info;
+		};
+
+		struct PassNode
+		{
+			std::string Name;
+			std::vector<uint32> Reads;
+			std::vector<PassWrite> Writes;
+			bool SideEffect = false;
+			RenderGraphExecuteFunction Execute;
+		};
+
+		// Compiled data is indexed like the declarations, which match as long as the topology hash does
+		struct CompiledResource
+		{
+			uint32 FirstPass = ~0u;
+			uint32 LastPass = 0;
+			uint32 PhysicalIndex = ~0u;
+		};
+
+		struct CompiledPass
+		{
+			bool Culled = false;
+			std::vector<RenderGraphBarrier> Barriers;
+			Ref<Framebuffer> Framebuffer;
+			uint32 Width = 0;
+			uint32 Height = 0;
+		};
+
+		struct PhysicalTexture
+		{
+			RenderGraphTextureDesc Desc;
+			Ref<Texture> Texture;
+			uint32 LastPass = 0;
+		};
+
+		std::string m_DebugName;
+
+		std::vector<PassNode> m_Passes;
+		std::vector<ResourceNode> m_Resources;
+
+		std::vector<CompiledPass> m_CompiledPasses;
+		std::vector<CompiledResource> m_CompiledResources;
+
+		// Kept between compilations, so a resize only reinitializes the textures
+		std::vector<PhysicalTexture> m_PhysicalTextures;
+
+		uint64 m_CompiledHash = 0;
+		bool m_Compiled = false;
+
+		RenderGraphStats m_Stats;
+
+		friend class RenderGraphBuilder;
+		friend class RenderGraphPassContext;
+	};
+
+	namespace Utils {
+
+		inline static const char* RenderGraphResourceStateToString(RenderGraphResourceState state)
+		{
+			switch (state)
+			{
+			case RenderGraphResourceState::Undefined:       return "Undefined";
+			case RenderGraphResourceState::ColorAttachment: return "ColorAttachment";
+			case RenderGraphResourceState::DepthAttachment: return "DepthAttachment";
+			case RenderGraphResourceState::ShaderRead:      return "ShaderRead";
+			}
+			FLUX_VERIFY(false, "Unknown render graph resource state!");
+			return "";
+		}
+
+	}
+
+}
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "FluxPCH.h"
 #include "RenderPipeline.h"
 
+#include "Renderer.h"
+
 #include "Flux/Runtime/Core/Engine.h"
+#include "Flux/Runtime/Core/Hash.h"
+#include "Flux/Runtime/Core/JobSystem.h"
 
 namespace Flux {
 
@@ -27,11 +31,58 @@ namespace Flux {
 		pipelineCreateInfo.BackfaceCulling = true;
 		m_Pipeline = GraphicsPipeline::Create(pipelineCreateInfo);
 
-		FramebufferCreateInfo framebufferCreateInfo;
-		framebufferCreateInfo.Attachments = { TextureFormat::RGBA32, TextureFormat::Depth24Stencil8 };
-		framebufferCreateInfo.DepthCompareFunction = CompareFunction::GreaterOrEqual;
-		framebufferCreateInfo.SwapchainTarget = swapchainTarget;
-		m_Framebuffer = Framebuffer::Create(framebufferCreateInfo);
+		// Shades the fragments left by the depth prepass
+		pipelineCreateInfo.DepthWrite = false;
+		pipelineCreateInfo.DepthCompareFunction = CompareFunction::Equal;
+		m_EqualDepthPipeline = GraphicsPipeline::Create(pipelineCreateInfo);
+
+		m_DepthOnlyShader = Shader::Create("Resources/Shaders/DepthOnly.glsl");
+		m_OverdrawShader = Shader::Create("Resources/Shaders/Overdraw.glsl");
+
+		GraphicsPipelineCreateInfo positionPipelineCreateInfo;
+		positionPipelineCreateInfo.VertexDeclaration = {
+			{ "a_Position", VertexElementFormat::Float3 }
+		};
+		positionPipelineCreateInfo.DepthTest = true;
+		positionPipelineCreateInfo.DepthWrite = true;
+		positionPipelineCreateInfo.ColorWrite = false;
+		positionPipelineCreateInfo.BlendMode = BlendMode::None;
+		positionPipelineCreateInfo.BackfaceCulling = true;
+		m_DepthPrepassPipeline = GraphicsPipeline::Create(positionPipelineCreateInfo);
+
+		// Same depth state as the shading pipelines, so the same fragments are counted as shaded
+		positionPipelineCreateInfo.ColorWrite = true;
+		positionPipelineCreateInfo.BlendMode = BlendMode::Additive;
+		m_OverdrawPipeline = GraphicsPipeline::Create(positionPipelineCreateInfo);
+
+		positionPipelineCreateInfo.DepthWrite = false;
+		positionPipelineCreateInfo.DepthCompareFunction = CompareFunction::Equal;
+		m_OverdrawEqualDepthPipeline = GraphicsPipeline::Create(positionPipelineCreateInfo);
+
+		// Both faces cast shadows, pushed away from the light against shadow acne
+		positionPipelineCreateInfo.DepthWrite = true;
+		positionPipelineCreateInfo.DepthCompareFunction = CompareFunction::GreaterOrEqual;
+		positionPipelineCreateInfo.ColorWrite = false;
+		positionPipelineCreateInfo.BlendMode = BlendMode::None;
+		positionPipelineCreateInfo.BackfaceCulling = false;
+		positionPipelineCreateInfo.DepthBiasConstant = -2.0f;
+		positionPipelineCreateInfo.DepthBiasSlope = -2.0f;
+		m_ShadowPipeline = GraphicsPipeline::Create(positionPipelineCreateInfo);
+
+		m_SwapchainTarget = swapchainTarget;
+		m_RenderGraph = Ref<RenderGraph>::Create(swapchainTarget ? "Forward Render Pipeline (Swapchain)" : "Forward Render Pipeline");
+		m_LightClusterGrid = Ref<LightClusterGrid>::Create();
+		m_CascadedShadowMap = Ref<CascadedShadowMap>::Create();
+
+		if (!swapchainTarget)
+		{
+			TextureProperties properties;
+			properties.Width = m_ViewportWidth;
+			properties.Height = m_ViewportHeight;
+			properties.Format = TextureFormat::RGBA32;
+			properties.Usage = TextureUsage::Attachment;
+			m_ColorTexture = Texture::Create(properties);
+		}
 
 		// White texture
 		{
@@ -67,35 +118,396 @@ namespace Flux {
 	void ForwardRenderPipeline::BeginRendering()
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_DrawCommandQueue.reserve(m_LastDrawCommandCount);
+		m_LightQueue.reserve(m_LastLightCount);
 	}
 
 	void ForwardRenderPipeline::EndRendering()
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_PROFILE_FUNC();
+
+		const bool depthPrepass = m_RenderSettings.DepthPrepass;
+		const bool frontToBack = m_RenderSettings.FrontToBackSorting;
+		const bool overdrawView = m_RenderSettings.OverdrawView;
+		const bool shadows = m_RenderSettings.Shadows && m_EnvironmentSettings.LightDirection.LengthSquared() > 0.0001f;
+		const bool cacheStaticShadows = m_RenderSettings.CacheStaticShadows;
+
+		if (frontToBack)
+		{
+			for (auto& drawCommand : m_DrawCommandQueue)
+			{
+				const Vector4& translation = drawCommand.Transform[3];
+				drawCommand.Distance = (Vector3(translation.X, translation.Y, translation.Z) - m_CameraSettings.CameraPosition).LengthSquared();
+			}
+		}
+
+		m_PreviousLODs.swap(m_CurrentLODs);
+		m_CurrentLODs.clear();
+
+		m_MeshLODStats = {};
+		for (const auto& drawCommand : m_DrawCommandQueue)
+		{
+			const SubmeshDescriptor& submesh = drawCommand.Mesh->GetProperties().Submeshes[drawCommand.SubmeshIndex];
+			uint32 indexCount = drawCommand.LOD > 0 ? submesh.LODs[drawCommand.LOD - 1].IndexCount : submesh.IndexCount;
+
+			m_MeshLODStats.DrawCounts[Math::Min(drawCommand.LOD, MeshLODStats::s_MaxLODCount - 1)]++;
+			m_MeshLODStats.TriangleCount += indexCount / 3;
+			m_MeshLODStats.FullDetailTriangleCount += submesh.IndexCount / 3;
+		}
+
+		SortDrawCommands(frontToBack);
+
+		if (m_ViewportWidth > 0 && m_ViewportHeight > 0)
+		{
+			LightClusterGridViewInfo viewInfo;
+			viewInfo.ViewMatrix = m_CameraSettings.ViewMatrix;
+			viewInfo.ProjectionMatrix = m_CameraSettings.ProjectionMatrix;
+			viewInfo.NearClip = m_CameraSettings.NearClip;
+			viewInfo.FarClip = m_CameraSettings.FarClip;
+			viewInfo.ViewportWidth = m_ViewportWidth;
+			viewInfo.ViewportHeight = m_ViewportHeight;
+			m_LightClusterGrid->Build(m_LightQueue.data(), static_cast<uint32>(m_LightQueue.size()), viewInfo);
+
+			if (shadows)
+			{
+				CascadedShadowMapViewInfo shadowViewInfo;
+				shadowViewInfo.ViewMatrix = m_CameraSettings.ViewMatrix;
+				shadowViewInfo.ProjectionMatrix = m_CameraSettings.ProjectionMatrix;
+				shadowViewInfo.NearClip = m_CameraSettings.NearClip;
+				shadowViewInfo.FarClip = m_CameraSettings.FarClip;
+				shadowViewInfo.LightDirection = m_EnvironmentSettings.LightDirection;
+				shadowViewInfo.ShadowDistance = m_RenderSettings.ShadowDistance;
+				m_CascadedShadowMap->Update(shadowViewInfo);
+
+				if (!cacheStaticShadows)
+					m_CascadedShadowMap->InvalidateStaticCache();
+
+				JobCounter counter;
+				JobSystem::Dispatch(counter, CascadedShadowMap::s_CascadeCount, 1, [this, cacheStaticShadows](uint32 begin, uint32 end)
+				{
+					for (uint32 cascadeIndex = begin; cascadeIndex < end; cascadeIndex++)
+						CullShadowCasters(cascadeIndex, cacheStaticShadows);
+				});
+				JobSystem::Wait(counter);
+
+				for (uint32 cascadeIndex = 0; cascadeIndex < CascadedShadowMap::s_CascadeCount; cascadeIndex++)
+				{
+					auto& casters = m_ShadowCasters[cascadeIndex];
+					if (cacheStaticShadows)
+					{
+						casters.RenderStatic = m_CascadedShadowMap->UpdateStaticCache(cascadeIndex, static_cast<uint32>(casters.StaticDraws.size()),
+							static_cast<uint32>(casters.DynamicDraws.size()), casters.StaticHash);
+					}
+					else
+					{
+						m_CascadedShadowMap->SetUncachedCasters(cascadeIndex, static_cast<uint32>(casters.DynamicDraws.size()));
+						casters.RenderStatic = false;
+					}
+				}
+			}
+
+			m_RenderGraph->Reset();
+
+			RenderGraphTextureDesc colorDesc = { TextureFormat::RGBA32, m_ViewportWidth, m_ViewportHeight };
+			RenderGraphTextureDesc depthDesc = { TextureFormat::Depth24Stencil8, m_ViewportWidth, m_ViewportHeight };
+
+			RenderGraphResource sceneColor;
+			RenderGraphResource sceneDepth;
+			if (m_SwapchainTarget)
+			{
+				sceneColor = m_RenderGraph->ImportBackbuffer("Backbuffer", colorDesc);
+				sceneDepth = m_RenderGraph->ImportBackbuffer("Backbuffer Depth", depthDesc);
+			}
+			else
+			{
+				sceneColor = m_RenderGraph->ImportTexture("Scene Color", m_ColorTexture);
+			}
+
+			RenderGraphWriteInfo depthWriteInfo;
+			depthWriteInfo.DepthCompareFunction = CompareFunction::GreaterOrEqual;
+
+			RenderGraphResource shadowMap;
+			if (shadows)
+			{
+				shadowMap = m_RenderGraph->ImportTexture("Shadow Map", m_CascadedShadowMap->GetShadowMap());
+
+				for (uint32 cascadeIndex = 0; cascadeIndex < CascadedShadowMap::s_CascadeCount; cascadeIndex++)
+				{
+					m_RenderGraph->AddPass(fmt::format("Shadow Cascade {0}", cascadeIndex), [&](RenderGraphBuilder& builder)
+					{
+						RenderGraphWriteInfo shadowWriteInfo = depthWriteInfo;
+						shadowWriteInfo.Layer = cascadeIndex;
+						builder.Write(shadowMap, shadowWriteInfo);
+					},
+					[this, cascadeIndex, cacheStaticShadows](const RenderGraphPassContext&)
+					{
+						auto& casters = m_ShadowCasters[cascadeIndex];
+						const Matrix4x4& viewProjectionMatrix = m_CascadedShadowMap->GetCascade(cascadeIndex).ViewProjectionMatrix;
+
+						// The cache is kept outside of the graph, as its contents outlive the frame
+						Ref<Texture> shadowMapTexture = m_CascadedShadowMap->GetShadowMap();
+						Ref<Texture> staticCache = m_CascadedShadowMap->GetStaticCache();
+
+						// The cached static depth is drawn at full detail, as it has to stay valid while the camera moves
+						if (casters.RenderStatic)
+						{
+							ExecuteDrawPass(DrawPass::Shadow, viewProjectionMatrix, &casters.StaticDraws, true);
+							shadowMapTexture->CopyLayerTo(staticCache, cascadeIndex);
+						}
+						else if (cacheStaticShadows)
+						{
+							staticCache->CopyLayerTo(shadowMapTexture, cascadeIndex);
+						}
+
+						ExecuteDrawPass(DrawPass::Shadow, viewProjectionMatrix, &casters.DynamicDraws);
+					});
+				}
+			}
+
+			if (depthPrepass)
+			{
+				m_RenderGraph->AddPass("Depth Prepass", [&](RenderGraphBuilder& builder)
+				{
+					if (!sceneDepth)
+						sceneDepth = builder.CreateTexture("Scene Depth", depthDesc);
+
+					builder.Write(sceneDepth, depthWriteInfo);
+				},
+				[this](const RenderGraphPassContext&)
+				{
+					ExecuteDrawPass(DrawPass::DepthPrepass, m_CameraSettings.ViewProjectionMatrix);
+				});
+			}
+
+			m_RenderGraph->AddPass(overdrawView ? "Overdraw" : "Forward", [&](RenderGraphBuilder& builder)
+			{
+				if (!sceneDepth)
+					sceneDepth = builder.CreateTexture("Scene Depth", depthDesc);
+
+				builder.Write(sceneColor);
+
+				if (shadowMap)
+					builder.Read(shadowMap);
+
+				// Keeps the depth of the prepass
+				RenderGraphWriteInfo shadingDepthWriteInfo = depthWriteInfo;
+				shadingDepthWriteInfo.Clear = !depthPrepass;
+				builder.Write(sceneDepth, shadingDepthWriteInfo);
+			},
+			[this, depthPrepass, frontToBack, overdrawView](const RenderGraphPassContext&)
+			{
+				// Only the visible fragments pass the Equal depth test, whatever the order,
+				// so the draws are sorted to share state instead
+				if (depthPrepass && frontToBack)
+					SortDrawCommands(false);
+
+				ExecuteDrawPass(overdrawView ? DrawPass::Overdraw : DrawPass::Shading, m_CameraSettings.ViewProjectionMatrix);
+			});
+
+			m_RenderGraph->Execute();
+		}
+
+		// Don't keep the storage, it belongs to this frame
+		m_LastDrawCommandCount = static_cast<uint32>(m_DrawCommandQueue.size());
+		m_DrawCommandQueue = FrameVector<DrawCommand>();
+
+		m_LastLightCount = static_cast<uint32>(m_LightQueue.size());
+		m_LightQueue = FrameVector<ClusterLight>();
+
+		for (auto& casters : m_ShadowCasters)
+		{
+			casters.StaticDraws = FrameVector<uint32>();
+			casters.DynamicDraws = FrameVector<uint32>();
+		}
+	}
+
+	void ForwardRenderPipeline::SortDrawCommands(bool frontToBack)
+	{
+		FLUX_PROFILE_FUNC();
+
+		// Draws of the same mesh end up next to each other, so its buffers are bound once per run
+		std::sort(m_DrawCommandQueue.begin(), m_DrawCommandQueue.end(), [frontToBack](const DrawCommand& a, const DrawCommand& b)
+		{
+			if (frontToBack && a.Distance != b.Distance)
+				return a.Distance < b.Distance;
+			if (a.Mesh.Get() != b.Mesh.Get())
+				return a.Mesh.Get() < b.Mesh.Get();
+			return a.SubmeshIndex < b.SubmeshIndex;
+		});
+	}
+
+	void ForwardRenderPipeline::CullShadowCasters(uint32 cascadeIndex, bool cacheStaticShadows)
+	{
+		FLUX_PROFILE_FUNC();
+
+		auto& casters = m_ShadowCasters[cascadeIndex];
+		casters.StaticDraws.clear();
+		casters.DynamicDraws.clear();
+		casters.StaticHash = 0;
+
+		for (uint32 i = 0; i < static_cast<uint32>(m_DrawCommandQueue.size()); i++)
+		{
+			const DrawCommand& drawCommand = m_DrawCommandQueue[i];
+			const SubmeshDescriptor& submesh = drawCommand.Mesh->GetProperties().Submeshes[drawCommand.SubmeshIndex];
+
+			const Matrix4x4& transform = drawCommand.Transform;
+			Vector4 center = transform * Vector4(submesh.BoundingSphereCenter, 1.0f);
+
+			float scaleSquared = 0.0f;
+			for (uint32 axis = 0; axis < 3; axis++)
+				scaleSquared = Math::Max(scaleSquared, Vector3(transform[axis].X, transform[axis].Y, transform[axis].Z).LengthSquared());
 
-		m_Framebuffer->Bind();
+			float radius = submesh.BoundingSphereRadius * Math::Sqrt(scaleSquared);
+			if (!m_CascadedShadowMap->IntersectsCascade(cascadeIndex, Vector3(center.X, center.Y, center.Z), radius))
+				continue;
 
-		m_Shader->Bind();
-		m_Shader->SetUniform("u_LightColor", m_EnvironmentSettings.LightColor);
-		m_Shader->SetUniform("u_AmbientMultiplier", m_AmbientMultiplier);
-		m_Shader->SetUniform("u_ViewMatrix", m_CameraSettings.ViewMatrix);
-		m_Shader->SetUniform("u_ViewProjectionMatrix", m_CameraSettings.ViewProjectionMatrix);
-		m_Shader->SetUniform("u_CameraPosition", m_CameraSettings.CameraPosition);
-		m_Shader->SetUniform("u_LightDirection", m_EnvironmentSettings.LightDirection);
+			if (!cacheStaticShadows || !drawCommand.Static)
+			{
+				casters.DynamicDraws.push_back(i);
+				continue;
+			}
+
+			casters.StaticDraws.push_back(i);
+
+			// The cached depth is only valid for the same static draws. The draw hashes are summed,
+			// as the order of the queue changes with the camera when sorting front to back.
+			const Mesh* mesh = drawCommand.Mesh.Get();
+			uint64 drawHash = 0;
+			Utils::HashCombine(drawHash, mesh);
+			Utils::HashCombine(drawHash, drawCommand.SubmeshIndex);
+			Utils::HashCombine(drawHash, &transform, sizeof(Matrix4x4));
+			casters.StaticHash += drawHash;
+		}
+	}
+
+	void ForwardRenderPipeline::ExecuteDrawPass(DrawPass pass, const Matrix4x4& viewProjectionMatrix, const FrameVector<uint32>* drawIndices, bool fullDetail)
+	{
+		FLUX_PROFILE_FUNC();
+
+		Ref<Shader> shader = GetDrawPassState(pass).Shader;
+		shader->Bind();
+		shader->SetUniform("u_ViewProjectionMatrix", viewProjectionMatrix);
+
+		if (pass == DrawPass::Shading)
+		{
+			shader->SetUniform("u_LightColor", m_EnvironmentSettings.LightColor);
+			shader->SetUniform("u_AmbientMultiplier", m_AmbientMultiplier);
+			shader->SetUniform("u_ViewMatrix", m_CameraSettings.ViewMatrix);
+			shader->SetUniform("u_CameraPosition", m_CameraSettings.CameraPosition);
+			shader->SetUniform("u_LightDirection", m_EnvironmentSettings.LightDirection);
+			shader->SetUniform("u_LightHeatmap", uint32(m_RenderSettings.LightHeatmapView ? 1 : 0));
+
+			m_LightClusterGrid->Bind(shader);
+
+			// Always bound, as the sampler can't share its slot with the material textures
+			bool shadows = m_RenderSettings.Shadows && m_EnvironmentSettings.LightDirection.LengthSquared() > 0.0001f;
+			shader->SetUniform("u_ShadowsEnabled", uint32(shadows ? 1 : 0));
+			shader->SetUniform("u_ShadowCascadeView", uint32(m_RenderSettings.ShadowCascadeView ? 1 : 0));
+			m_CascadedShadowMap->Bind(shader, 4);
+		}
+
+		const uint32 drawCount = drawIndices ? static_cast<uint32>(drawIndices->size()) : static_cast<uint32>(m_DrawCommandQueue.size());
+		const uint32 commandListCount = (drawCount + s_DrawsPerCommandList - 1) / s_DrawsPerCommandList;
+
+		if (commandListCount > 1 && JobSystem::GetWorkerCount() > 0)
+		{
+			// Every chunk is recorded into its own command list by a job. The lists are executed
+			// in chunk order, so the render thread sees the same commands as with serial recording.
+			FrameVector<CommandQueue*> commandLists(commandListCount);
+			for (auto& commandList : commandLists)
+				commandList = Renderer::AllocateCommandList();
+
+			JobCounter counter;
+			JobSystem::Dispatch(counter, drawCount, s_DrawsPerCommandList, [this, pass, drawIndices, fullDetail, &commandLists](uint32 begin, uint32 end)
+			{
+				FLUX_PROFILE_SCOPE("ForwardRenderPipeline::RecordDrawCommands");
+
+				Renderer::BeginCommandList(commandLists[begin / s_DrawsPerCommandList]);
+				RecordDrawCommands(pass, begin, end, drawIndices, fullDetail);
+				Renderer::EndCommandList();
+			});
+			JobSystem::Wait(counter);
+
+			for (CommandQueue* commandList : commandLists)
+				Renderer::SubmitCommandList(commandList);
+		}
+		else
+		{
+			RecordDrawCommands(pass, 0, drawCount, drawIndices, fullDetail);
+		}
+
+		if (pass == DrawPass::Shading)
+			m_CascadedShadowMap->Unbind(4);
+	}
+
+	ForwardRenderPipeline::DrawPassState ForwardRenderPipeline::GetDrawPassState(DrawPass pass) const
+	{
+		const bool depthPrepass = m_RenderSettings.DepthPrepass;
+
+		switch (pass)
+		{
+		case DrawPass::DepthPrepass: return { m_DepthPrepassPipeline, m_DepthOnlyShader, true };
+		case DrawPass::Shading:      return { depthPrepass ? m_EqualDepthPipeline : m_Pipeline, m_Shader, false };
+		case DrawPass::Overdraw:     return { depthPrepass ? m_OverdrawEqualDepthPipeline : m_OverdrawPipeline, m_OverdrawShader, true };
+		case DrawPass::Shadow:       return { m_ShadowPipeline, m_DepthOnlyShader, true };
+		}
+		FLUX_VERIFY(false, "Unknown draw pass!");
+		return {};
+	}
+
+	void ForwardRenderPipeline::RecordDrawCommands(DrawPass pass, uint32 begin, uint32 end, const FrameVector<uint32>* drawIndices, bool fullDetail)
+	{
+		FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS();
+
+		const DrawPassState state = GetDrawPassState(pass);
+
+		const uint32 targetWidth = pass == DrawPass::Shadow ? CascadedShadowMap::s_Resolution : m_ViewportWidth;
+		const uint32 targetHeight = pass == DrawPass::Shadow ? CascadedShadowMap::s_Resolution : m_ViewportHeight;
 
-		for (auto it = m_DrawCommandQueue.begin(); it != m_DrawCommandQueue.end(); it++)
+		const Mesh* boundMesh = nullptr;
+
+		for (uint32 i = begin; i < end; i++)
 		{
-			it->Mesh->GetVertexBuffer()->Bind();
-			m_Pipeline->Bind();
-			m_Pipeline->Scissor(0, 0, m_ViewportWidth, m_ViewportHeight);
-			it->Mesh->GetIndexBuffer()->Bind();
+			auto& drawCommand = m_DrawCommandQueue[drawIndices ? (*drawIndices)[i] : i];
+
+			// Every command list starts with its own binds, as the lists may be recorded in any order
+			if (drawCommand.Mesh.Get() != boundMesh)
+			{
+				if (state.PositionOnly)
+					drawCommand.Mesh->GetPositionVertexBuffer()->Bind();
+				else
+					drawCommand.Mesh->GetVertexBuffer()->Bind();
 
-			m_Shader->Bind();
+				state.Pipeline->Bind();
+				state.Pipeline->Scissor(0, 0, targetWidth, targetHeight);
+				drawCommand.Mesh->GetIndexBuffer()->Bind();
 
-			auto& properties = it->Mesh->GetProperties();
-			auto& submesh = properties.Submeshes[it->SubmeshIndex];
+				state.Shader->Bind();
+
+				boundMesh = drawCommand.Mesh.Get();
+			}
+
+			auto& properties = drawCommand.Mesh->GetProperties();
+			auto& submesh = properties.Submeshes[drawCommand.SubmeshIndex];
+
+			uint32 indexCount = submesh.IndexCount;
+			uint32 startIndexLocation = submesh.StartIndexLocation;
+			if (drawCommand.LOD > 0 && !fullDetail)
+			{
+				const SubmeshLOD& lod = submesh.LODs[drawCommand.LOD - 1];
+				indexCount = lod.IndexCount;
+				startIndexLocation = lod.StartIndexLocation;
+			}
 
-			m_Shader->SetUniform("u_Transform", it->Transform);
+			state.Shader->SetUniform("u_Transform", drawCommand.Transform);
+
+			if (pass != DrawPass::Shading)
+			{
+				state.Pipeline->DrawIndexed(submesh.IndexFormat, indexCount, startIndexLocation, submesh.BaseVertexLocation);
+				continue;
+			}
 
 			// TODO: replace
 			auto& material = m_Material;
@@ -132,10 +544,10 @@ namespace Flux {
 				m_Shader->SetUniform("u_MetalnessMap", 3);
 			}
 
-			m_Pipeline->DrawIndexed(
+			state.Pipeline->DrawIndexed(
 				submesh.IndexFormat,
-				submesh.IndexCount,
-				submesh.StartIndexLocation,
+				indexCount,
+				startIndexLocation,
 				submesh.BaseVertexLocation
 			);
 
@@ -148,9 +560,6 @@ namespace Flux {
 			if (material.MetalnessMap)
 				material.MetalnessMap->Unbind(3);
 		}
-		m_Framebuffer->Unbind();
-
-		m_DrawCommandQueue.clear();
 	}
 
 	void ForwardRenderPipeline::SubmitDynamicMesh(const DynamicMeshSubmitInfo& submitInfo)
@@ -161,6 +570,19 @@ namespace Flux {
 		drawCommand.Mesh = submitInfo.Mesh;
 		drawCommand.SubmeshIndex = submitInfo.SubmeshIndex;
 		drawCommand.Transform = submitInfo.Transform;
+		drawCommand.Static = submitInfo.Static;
+
+		const SubmeshDescriptor& submesh = submitInfo.Mesh->GetProperties().Submeshes[submitInfo.SubmeshIndex];
+		if (submitInfo.LODStateID != 0)
+		{
+			auto it = m_PreviousLODs.find(submitInfo.LODStateID);
+			drawCommand.LOD = SelectLOD(submesh, drawCommand.Transform, it != m_PreviousLODs.end() ? it->second : ~0u);
+			m_CurrentLODs[submitInfo.LODStateID] = drawCommand.LOD;
+		}
+		else
+		{
+			drawCommand.LOD = SelectLOD(submesh, drawCommand.Transform, ~0u);
+		}
 	}
 
 	void ForwardRenderPipeline::SubmitStaticMesh(const StaticMeshSubmitInfo& submitInfo)
@@ -174,9 +596,73 @@ namespace Flux {
 			drawCommand.Mesh = submitInfo.Mesh;
 			drawCommand.SubmeshIndex = i;
 			drawCommand.Transform = submitInfo.Transform * properties.Submeshes[i].WorldTransform;
+			drawCommand.Static = true;
+			drawCommand.LOD = SelectLOD(properties.Submeshes[i], drawCommand.Transform, ~0u);
 		}
 	}
 
+	uint32 ForwardRenderPipeline::SelectLOD(const SubmeshDescriptor& submesh, const Matrix4x4& transform, uint32 previousLOD) const
+	{
+		const uint32 lodCount = static_cast<uint32>(submesh.LODs.size());
+		if (!m_RenderSettings.MeshLODs || lodCount == 0)
+			return 0;
+
+		float scaleSquared = 0.0f;
+		for (uint32 i = 0; i < 3; i++)
+			scaleSquared = Math::Max(scaleSquared, Vector3(transform[i][0], transform[i][1], transform[i][2]).LengthSquared());
+
+		Vector4 center = transform * Vector4(submesh.BoundingSphereCenter.X, submesh.BoundingSphereCenter.Y, submesh.BoundingSphereCenter.Z, 1.0f);
+		float radius = submesh.BoundingSphereRadius * Math::Sqrt(scaleSquared);
+		float distance = (Vector3(center.X, center.Y, center.Z) - m_CameraSettings.CameraPosition).Length();
+		if (distance <= radius)
+			return 0;
+
+		// Fraction of the viewport height covered by the bounding sphere
+		float screenSize = radius * m_CameraSettings.ProjectionMatrix[1][1] / distance * m_RenderSettings.LODBias;
+
+		uint32 lod = 0;
+		while (lod < lodCount && screenSize < submesh.LODs[lod].ScreenSize)
+			lod++;
+
+		// Without a previous level, the selected one is used as is
+		if (previousLOD > lodCount)
+			return lod;
+
+		// The level only changes once the size on screen is past the threshold by the hysteresis,
+		// so submeshes close to a threshold don't switch back and forth every frame
+		const float hysteresis = m_RenderSettings.LODHysteresis;
+		while (lod > previousLOD && screenSize >= submesh.LODs[lod - 1].ScreenSize * (1.0f - hysteresis))
+			lod--;
+		while (lod < previousLOD && screenSize <= submesh.LODs[lod].ScreenSize * (1.0f + hysteresis))
+			lod++;
+
+		return lod;
+	}
+
+	void ForwardRenderPipeline::SubmitPointLight(const PointLightSubmitInfo& submitInfo)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		auto& light = m_LightQueue.emplace_back();
+		light.Position = submitInfo.Position;
+		light.Color = submitInfo.Color;
+		light.Range = submitInfo.Range;
+	}
+
+	void ForwardRenderPipeline::SubmitSpotLight(const SpotLightSubmitInfo& submitInfo)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		auto& light = m_LightQueue.emplace_back();
+		light.Position = submitInfo.Position;
+		light.Color = submitInfo.Color;
+		light.Range = submitInfo.Range;
+		light.Spot = true;
+		light.Direction = submitInfo.Direction;
+		light.InnerConeAngle = submitInfo.InnerConeAngle;
+		light.OuterConeAngle = submitInfo.OuterConeAngle;
+	}
+
 	void ForwardRenderPipeline::BeginRendering2D()
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
@@ -196,7 +682,13 @@ namespace Flux {
 			m_ViewportWidth = width;
 			m_ViewportHeight = height;
 
-			m_Framebuffer->Resize(width, height);
+			if (m_ColorTexture)
+			{
+				TextureProperties properties = m_ColorTexture->GetProperties();
+				properties.Width = width;
+				properties.Height = height;
+				m_ColorTexture->Reinitialize(properties);
+			}
 		}
 	}
 
@@ -4,6 +4,9 @@
 #include "Shader.h"
 #include "Texture.h"
 #include "Framebuffer.h"
+#include "RenderGraph.h"
+#include "LightClusterGrid.h"
+#include "CascadedShadowMap.h"
 
 namespace Flux {
 
@@ -12,6 +15,11 @@ namespace Flux {
 		Ref<Mesh> Mesh;
 		uint32 SubmeshIndex;
 		Matrix4x4 Transform;
+		// Never moves, so its shadows can be cached
+		bool Static = false;
+		// Identifies the submitter across frames, so the pipeline can keep the level of detail it drew last frame
+		// for the hysteresis. Zero selects the level without hysteresis.
+		uint64 LODStateID = 0;
 	};
 
 	struct StaticMeshSubmitInfo
@@ -20,9 +28,42 @@ namespace Flux {
 		Matrix4x4 Transform;
 	};
 
+	struct MeshLODStats
+	{
+		static constexpr uint32 s_MaxLODCount = 8;
+
+		// Draws per level of detail, the last one also counts the coarser levels
+		uint32 DrawCounts[s_MaxLODCount] = {};
+		uint64 TriangleCount = 0;
+		// Triangles of the same draws with every submesh at full detail
+		uint64 FullDetailTriangleCount = 0;
+	};
+
+	struct PointLightSubmitInfo
+	{
+		Vector3 Position;
+		// Premultiplied by the intensity
+		Vector3 Color;
+		float Range;
+	};
+
+	struct SpotLightSubmitInfo
+	{
+		Vector3 Position;
+		Vector3 Direction;
+		// Premultiplied by the intensity
+		Vector3 Color;
+		float Range;
+		// Half angles in degrees
+		float InnerConeAngle;
+		float OuterConeAngle;
+	};
+
 	class RenderPipeline : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		struct CameraSettings
 		{
 			Matrix4x4 ViewMatrix = Matrix4x4(1.0f);
@@ -40,15 +81,43 @@ namespace Flux {
 			Vector3 LightColor = Vector3(1.0f);
 
 			// TODO:
-			// - Directional lights
-			// - Point lights
+			// - Multiple directional lights
 			// - Skybox (LOD, intensity)
 		};
+
+		struct RenderSettings
+		{
+			// Lays down the depth of the opaque draws first, so the shading pass only shades visible fragments
+			bool DepthPrepass = true;
+			// Opaque draws are sorted by their distance to the camera, nearest first
+			bool FrontToBackSorting = true;
+			// Shows how many fragments are shaded per pixel instead of the lit scene
+			bool OverdrawView = false;
+			// Shows how many point and spot lights are evaluated per pixel instead of the lit scene
+			bool LightHeatmapView = false;
+
+			// Cascaded shadows of the directional light
+			bool Shadows = true;
+			// Static meshes are only rendered into the shadow map again when their cascade changes
+			bool CacheStaticShadows = true;
+			float ShadowDistance = 150.0f;
+			// Tints the scene with the color of the cascade it's shadowed by
+			bool ShadowCascadeView = false;
+
+			// Submeshes with levels of detail are drawn with the coarsest one made for their size on screen
+			bool MeshLODs = true;
+			// Scales the size on screen, higher values keep the detailed levels for longer
+			float LODBias = 1.0f;
+			// How far past a threshold the size on screen has to be before the level changes again
+			float LODHysteresis = 0.15f;
+		};
 	public:
 		virtual void BeginRendering() = 0;
 		virtual void EndRendering() = 0;
 		virtual void SubmitDynamicMesh(const DynamicMeshSubmitInfo& submitInfo) = 0;
 		virtual void SubmitStaticMesh(const StaticMeshSubmitInfo& submitInfo) = 0;
+		virtual void SubmitPointLight(const PointLightSubmitInfo& submitInfo) = 0;
+		virtual void SubmitSpotLight(const SpotLightSubmitInfo& submitInfo) = 0;
 
 		virtual void BeginRendering2D() = 0;
 		virtual void EndRendering2D() = 0;
@@ -59,12 +128,19 @@ namespace Flux {
 		virtual uint32 GetViewportHeight() const = 0;
 
 		virtual Ref<Texture> GetComposedTexture() const = 0;
+		virtual Ref<RenderGraph> GetRenderGraph() const = 0;
+		virtual const LightClusterGridStats& GetLightClusterStats() const = 0;
+		virtual const CascadedShadowMapStats& GetShadowStats() const = 0;
+		virtual const MeshLODStats& GetMeshLODStats() const = 0;
 
 		virtual CameraSettings& GetCameraSettings() = 0;
 		virtual const CameraSettings& GetCameraSettings() const = 0;
 
 		virtual EnvironmentSettings& GetEnvironmentSettings() = 0;
 		virtual const EnvironmentSettings& GetEnvironmentSettings() const = 0;
+
+		virtual RenderSettings& GetRenderSettings() = 0;
+		virtual const RenderSettings& GetRenderSettings() const = 0;
 	};
 
 	class ForwardRenderPipeline : public RenderPipeline
@@ -77,6 +153,8 @@ namespace Flux {
 		virtual void EndRendering() override;
 		virtual void SubmitDynamicMesh(const DynamicMeshSubmitInfo& submitInfo) override;
 		virtual void SubmitStaticMesh(const StaticMeshSubmitInfo& submitInfo) override;
+		virtual void SubmitPointLight(const PointLightSubmitInfo& submitInfo) override;
+		virtual void SubmitSpotLight(const SpotLightSubmitInfo& submitInfo) override;
 
 		virtual void BeginRendering2D() override;
 		virtual void EndRendering2D() override;
@@ -86,23 +164,77 @@ namespace Flux {
 		virtual uint32 GetViewportWidth() const override { return m_ViewportWidth; }
 		virtual uint32 GetViewportHeight() const override { return m_ViewportHeight; }
 
-		virtual Ref<Texture> GetComposedTexture() const override { return m_Framebuffer->GetColorAttachment(); }
+		virtual Ref<Texture> GetComposedTexture() const override { return m_ColorTexture; }
+		virtual Ref<RenderGraph> GetRenderGraph() const override { return m_RenderGraph; }
+		virtual const LightClusterGridStats& GetLightClusterStats() const override { return m_LightClusterGrid->GetStats(); }
+		virtual const CascadedShadowMapStats& GetShadowStats() const override { return m_CascadedShadowMap->GetStats(); }
+		virtual const MeshLODStats& GetMeshLODStats() const override { return m_MeshLODStats; }
 
 		virtual CameraSettings& GetCameraSettings() override { return m_CameraSettings; }
 		virtual const CameraSettings& GetCameraSettings() const override { return m_CameraSettings; }
 
 		virtual EnvironmentSettings& GetEnvironmentSettings() override { return m_EnvironmentSettings; }
 		virtual const EnvironmentSettings& GetEnvironmentSettings() const override { return m_EnvironmentSettings; }
+
+		virtual RenderSettings& GetRenderSettings() override { return m_RenderSettings; }
+		virtual const RenderSettings& GetRenderSettings() const override { return m_RenderSettings; }
 	private:
+		enum class DrawPass : uint8
+		{
+			DepthPrepass = 0,
+			Shading,
+			Overdraw,
+			Shadow
+		};
+
+		struct DrawPassState
+		{
+			Ref<GraphicsPipeline> Pipeline;
+			Ref<Flux::Shader> Shader;
+			// Binds the position-only vertex buffers of the meshes
+			bool PositionOnly = false;
+		};
+
+		void SortDrawCommands(bool frontToBack);
+		// Draws the whole draw command queue, or the draws of the given indices into it.
+		// Full detail ignores the levels of detail selected for the camera.
+		void ExecuteDrawPass(DrawPass pass, const Matrix4x4& viewProjectionMatrix, const FrameVector<uint32>* drawIndices = nullptr, bool fullDetail = false);
+		DrawPassState GetDrawPassState(DrawPass pass) const;
+
+		// Records the draws in [begin, end) of the sorted draw command queue, or of the draw indices
+		void RecordDrawCommands(DrawPass pass, uint32 begin, uint32 end, const FrameVector<uint32>* drawIndices, bool fullDetail);
+
+		// Finds the draws that cast shadows into the cascade, runs on a worker thread
+		void CullShadowCasters(uint32 cascadeIndex, bool cacheStaticShadows);
+
+		// Level of detail for the size of the submesh on screen, zero is full detail
+		uint32 SelectLOD(const SubmeshDescriptor& submesh, const Matrix4x4& transform, uint32 previousLOD) const;
+	private:
+		// Draws per command list when recording on worker threads, smaller frames are recorded on the main thread
+		static constexpr uint32 s_DrawsPerCommandList = 512;
+
 		uint32 m_ViewportWidth = 0;
 		uint32 m_ViewportHeight = 0;
+		bool m_SwapchainTarget = false;
 
 		CameraSettings m_CameraSettings;
 		EnvironmentSettings m_EnvironmentSettings;
+		RenderSettings m_RenderSettings;
 
 		Ref<Shader> m_Shader;
+		Ref<Shader> m_DepthOnlyShader;
+		Ref<Shader> m_OverdrawShader;
 		Ref<GraphicsPipeline> m_Pipeline;
-		Ref<Framebuffer> m_Framebuffer;
+		Ref<GraphicsPipeline> m_EqualDepthPipeline;
+		Ref<GraphicsPipeline> m_DepthPrepassPipeline;
+		Ref<GraphicsPipeline> m_OverdrawPipeline;
+		Ref<GraphicsPipeline> m_OverdrawEqualDepthPipeline;
+		Ref<GraphicsPipeline> m_ShadowPipeline;
+		Ref<RenderGraph> m_RenderGraph;
+		Ref<LightClusterGrid> m_LightClusterGrid;
+		Ref<CascadedShadowMap> m_CascadedShadowMap;
+		// Not used when rendering to the swapchain
+		Ref<Texture> m_ColorTexture;
 		Ref<Texture> m_WhiteTexture;
 		MaterialDescriptor m_Material;
 
@@ -113,9 +245,38 @@ namespace Flux {
 			Ref<Mesh> Mesh;
 			uint32 SubmeshIndex;
 			Matrix4x4 Transform;
+			// Squared distance to the camera, only set when sorting front to back
+			float Distance = 0.0f;
+			bool Static = false;
+			// Zero is the submesh itself, otherwise one past the index into its LODs
+			uint32 LOD = 0;
 		};
 
-		std::vector<DrawCommand> m_DrawCommandQueue;
+		// Lives in frame memory between BeginRendering and EndRendering
+		FrameVector<DrawCommand> m_DrawCommandQueue;
+		uint32 m_LastDrawCommandCount = 0;
+
+		FrameVector<ClusterLight> m_LightQueue;
+		uint32 m_LastLightCount = 0;
+
+		// Indices into the draw command queue, valid until the queue is sorted again
+		struct ShadowCasterList
+		{
+			FrameVector<uint32> StaticDraws;
+			FrameVector<uint32> DynamicDraws;
+			uint64 StaticHash = 0;
+			// The static depth of the cascade is rendered and cached this frame
+			bool RenderStatic = false;
+		};
+
+		ShadowCasterList m_ShadowCasters[CascadedShadowMap::s_CascadeCount];
+
+		MeshLODStats m_MeshLODStats;
+
+		// Levels of detail drawn last frame and this frame by LOD state ID, swapped every frame
+		// so the submitters that are gone are dropped
+		std::unordered_map<uint64, uint32> m_PreviousLODs;
+		std::unordered_map<uint64, uint32> m_CurrentLODs;
 	};
 
 }
\ No newline at end of file
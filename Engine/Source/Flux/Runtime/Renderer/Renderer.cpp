@@ -9,6 +9,16 @@ namespace Flux {
 	{
 		uint32 CurrentQueueCount = 0;
 		uint32 CurrentQueueIndex = 0;
+
+		uint64 FrameIndex = 0;
+		// Frame that was recorded into each render command queue
+		std::vector<uint64> QueueFrameIndices;
+
+		Unique<StagingRing> Staging;
+
+		// Command lists handed out per render command queue, reused once the queue was flushed
+		std::vector<std::vector<Unique<CommandQueue>>> CommandLists;
+		std::vector<uint32> UsedCommandListCounts;
 	};
 
 	static RendererData* s_Data = nullptr;
@@ -26,6 +36,11 @@ namespace Flux {
 			s_RenderCommandQueue[i] = new CommandQueue(fmt::format("Renderer - Render Command Queue [{0}]", i), 1024 * 1024);
 
 		s_ReleaseCommandQueue = new CommandQueue("Renderer - Release Command Queue", 1024);
+
+		s_Data->QueueFrameIndices.resize(commandQueueCount, 0);
+		s_Data->CommandLists.resize(commandQueueCount);
+		s_Data->UsedCommandListCounts.resize(commandQueueCount, 0);
+		s_Data->Staging = CreateUnique<StagingRing>(s_StagingRingCapacity, commandQueueCount);
 	}
 
 	void Renderer::Shutdown()
@@ -49,6 +64,10 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
+		s_Data->QueueFrameIndices[s_Data->CurrentQueueIndex] = s_Data->FrameIndex;
+		s_Data->UsedCommandListCounts[s_Data->CurrentQueueIndex] = 0;
+		s_Data->Staging->BeginFrame(s_Data->FrameIndex);
+
 		// Flush release queue
 		FLUX_SUBMIT_RENDER_COMMAND([]()
 		{
@@ -60,12 +79,16 @@ namespace Flux {
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
 
+		s_Data->Staging->EndFrame(s_Data->FrameIndex);
+		s_Data->FrameIndex++;
+
 		s_Data->CurrentQueueIndex = (s_Data->CurrentQueueIndex + 1) % s_Data->CurrentQueueCount;
 	}
 
 	void Renderer::FlushRenderCommands(uint32 queueIndex)
 	{
 		FLUX_CHECK_IS_IN_RENDER_THREAD();
+		FLUX_PROFILE_FUNC();
 
 #ifndef FLUX_BUILD_SHIPPING
 		if (s_RenderCommandQueueLocked[queueIndex])
@@ -82,6 +105,9 @@ namespace Flux {
 #ifndef FLUX_BUILD_SHIPPING
 		s_RenderCommandQueueLocked[queueIndex] = false;
 #endif
+
+		// Staging memory of the frame can be reused from now on
+		s_Data->Staging->SignalFrame(s_Data->QueueFrameIndices[queueIndex]);
 	}
 
 	void Renderer::FlushReleaseQueue()
@@ -105,6 +131,90 @@ namespace Flux {
 #endif
 	}
 
+	CommandQueue* Renderer::AllocateCommandList()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		uint32 queueIndex = s_Data->CurrentQueueIndex;
+		auto& commandLists = s_Data->CommandLists[queueIndex];
+		uint32& usedCount = s_Data->UsedCommandListCounts[queueIndex];
+
+		if (usedCount == commandLists.size())
+			commandLists.push_back(CreateUnique<CommandQueue>(fmt::format("Renderer - Command List [{0}, {1}]", queueIndex, usedCount), 256 * 1024));
+
+		CommandQueue* commandList = commandLists[usedCount++].get();
+#ifndef FLUX_BUILD_SHIPPING
+		commandList->SetTimingEnabled(s_RenderCommandQueue[queueIndex]->IsTimingEnabled());
+#endif
+		return commandList;
+	}
+
+	void Renderer::BeginCommandList(CommandQueue* commandList)
+	{
+		FLUX_VERIFY(!s_RecordingCommandList, "A command list is already being recorded on this thread!");
+		s_RecordingCommandList = commandList;
+	}
+
+	void Renderer::EndCommandList()
+	{
+		FLUX_VERIFY(s_RecordingCommandList);
+		s_RecordingCommandList = nullptr;
+	}
+
+	void Renderer::SubmitCommandList(CommandQueue* commandList)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+		FLUX_VERIFY(!s_RecordingCommandList);
+
+		CommandQueue* parentQueue = s_RenderCommandQueue[GetCurrentQueueIndex()];
+		FLUX_SUBMIT_RENDER_COMMAND([commandList, parentQueue]()
+		{
+			commandList->Flush(parentQueue);
+		});
+	}
+
+#ifndef FLUX_BUILD_SHIPPING
+	void Renderer::SetCommandTimingEnabled(bool enabled)
+	{
+		for (uint32 i = 0; i < s_Data->CurrentQueueCount; i++)
+			s_RenderCommandQueue[i]->SetTimingEnabled(enabled);
+		s_ReleaseCommandQueue->SetTimingEnabled(enabled);
+	}
+
+	bool Renderer::IsCommandTimingEnabled()
+	{
+		return s_RenderCommandQueue[0]->IsTimingEnabled();
+	}
+
+	std::vector<CommandQueueStats> Renderer::GetRenderCommandStats()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		// Queue of the previous frame, which is the one that was flushed last
+		uint32 queueIndex = (s_Data->CurrentQueueIndex + s_Data->CurrentQueueCount - 1) % s_Data->CurrentQueueCount;
+		return s_RenderCommandQueue[queueIndex]->GetLastFlushStats();
+	}
+
+	bool Renderer::DumpRenderCommandStats(const std::filesystem::path& path)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		std::ofstream stream(path);
+		if (!stream)
+		{
+			FLUX_ERROR_CATEGORY("Renderer", "Failed to open '{0}'", path.string());
+			return false;
+		}
+
+		stream << "Function,Count,Bytes,TimeMs\n";
+		for (auto& stats : GetRenderCommandStats())
+			stream << fmt::format("\"{0}\",{1},{2},{3:.4f}\n", stats.Name, stats.Count, stats.Bytes, stats.Time);
+
+		FLUX_INFO_CATEGORY("Renderer", "Render command stats written to '{0}'", path.string());
+		return true;
+	}
+#endif
+
 	uint32 Renderer::GetCurrentQueueIndex()
 	{
 		FLUX_CHECK_IS_IN_MAIN_THREAD();
@@ -119,4 +229,23 @@ namespace Flux {
 		return s_Data->CurrentQueueCount;
 	}
 
+	uint64 Renderer::GetFrameIndex()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		return s_Data->FrameIndex;
+	}
+
+	StagingBuffer Renderer::AllocateStaging(uint64 size)
+	{
+		return s_Data->Staging->Allocate(size);
+	}
+
+	StagingRingStats Renderer::GetStagingStats()
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		return s_Data->Staging->GetStats();
+	}
+
 }
\ No newline at end of file
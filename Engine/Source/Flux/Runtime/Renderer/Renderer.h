@@ -2,6 +2,8 @@
 
 #include "Flux/Runtime/Core/CommandQueue.h"
 
+#include "StagingRing.h"
+
 namespace Flux {
 
 	class Renderer
@@ -17,6 +19,12 @@ namespace Flux {
 		template<typename TFunc>
 		static void SubmitRenderCommand(const char* functionName, TFunc&& func)
 		{
+			if (s_RecordingCommandList)
+			{
+				s_RecordingCommandList->Push(std::forward<TFunc>(func), functionName);
+				return;
+			}
+
 			uint32 queueIndex = GetCurrentQueueIndex();
 
 			if (s_RenderCommandQueueLocked[queueIndex])
@@ -25,7 +33,7 @@ namespace Flux {
 				FLUX_VERIFY(false);
 			}
 
-			s_RenderCommandQueue[queueIndex]->Push(std::forward<TFunc>(func));
+			s_RenderCommandQueue[queueIndex]->Push(std::forward<TFunc>(func), functionName);
 		}
 
 		template<typename TFunc>
@@ -39,13 +47,19 @@ namespace Flux {
 					FLUX_VERIFY(false);
 				}
 
-				s_ReleaseCommandQueue->Push(std::forward<TFunc>((TFunc&&)func));
+				s_ReleaseCommandQueue->Push(std::forward<TFunc>((TFunc&&)func), functionName);
 			});
 		}
 #else
 		template<typename TFunc>
 		static void SubmitRenderCommand(TFunc&& func)
 		{
+			if (s_RecordingCommandList)
+			{
+				s_RecordingCommandList->Push(std::forward<TFunc>(func));
+				return;
+			}
+
 			uint32 queueIndex = GetCurrentQueueIndex();
 
 			s_RenderCommandQueue[queueIndex]->Push(std::forward<TFunc>(func));
@@ -63,14 +77,44 @@ namespace Flux {
 		static void FlushRenderCommands(uint32 queueIndex = 0);
 		static void FlushReleaseQueue();
 
+		// Command lists are secondary command queues that can be recorded on any thread, e.g. by jobs.
+		// Every list records into its own memory, so threads never contend while recording.
+		// Lists belong to the current frame and must be submitted in it.
+		static CommandQueue* AllocateCommandList();
+		// Render commands submitted by the calling thread go into the list until EndCommandList
+		static void BeginCommandList(CommandQueue* commandList);
+		static void EndCommandList();
+		static bool IsRecordingCommandList() { return s_RecordingCommandList != nullptr; }
+		// Executes the list on the render thread at this point of the current render command queue
+		static void SubmitCommandList(CommandQueue* commandList);
+
 		static uint32 GetCurrentQueueIndex();
 		static uint32 GetQueueCount();
+		// Incremented by EndFrame
+		static uint64 GetFrameIndex();
+
+		// Upload memory for render commands of the current frame, the command must call Release on it
+		static StagingBuffer AllocateStaging(uint64 size);
+		static StagingRingStats GetStagingStats();
+
+#ifndef FLUX_BUILD_SHIPPING
+		// Measures the render thread time of every command, per call site
+		static void SetCommandTimingEnabled(bool enabled);
+		static bool IsCommandTimingEnabled();
+
+		// Per call site stats of the last flushed render command queue
+		static std::vector<CommandQueueStats> GetRenderCommandStats();
+		static bool DumpRenderCommandStats(const std::filesystem::path& path);
+#endif
 	private:
 		inline static constexpr uint32 s_MaxRenderCommandQueueCount = 2;
+		inline static constexpr uint64 s_StagingRingCapacity = 16 * 1024 * 1024;
 
 		inline static CommandQueue* s_RenderCommandQueue[s_MaxRenderCommandQueueCount];
 		inline static CommandQueue* s_ReleaseCommandQueue = nullptr;
 
+		inline static thread_local CommandQueue* s_RecordingCommandList = nullptr;
+
 #ifndef FLUX_BUILD_SHIPPING
 		inline static std::atomic<bool> s_RenderCommandQueueLocked[s_MaxRenderCommandQueueCount];
 		inline static std::atomic<bool> s_ReleaseQueueLocked;
@@ -83,6 +127,13 @@ namespace Flux {
 	#define FLUX_SUBMIT_RENDER_COMMAND(...) Renderer::SubmitRenderCommand(__VA_ARGS__);
 #endif
 
+#ifndef FLUX_BUILD_SHIPPING
+	// For functions that only submit render commands, which may also happen while recording a command list
+	#define FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS() (::Flux::Renderer::IsRecordingCommandList() ? (void)0 : FLUX_CHECK_IS_IN_MAIN_THREAD())
+#else
+	#define FLUX_CHECK_CAN_SUBMIT_RENDER_COMMANDS() (void)0
+#endif
+
 #ifndef FLUX_BUILD_SHIPPING
 	#define FLUX_SUBMIT_RENDER_COMMAND_RELEASE(...) Renderer::SubmitRenderCommandRelease(__FUNCTION__, __VA_ARGS__);
 #else
@@ -0,0 +1,68 @@
+#include "FluxPCH.h"
+#include "RendererBenchmark.h"
+
+#include "Flux/Runtime/Core/Engine.h"
+
+namespace Flux {
+
+	struct ResourceChurnBlock
+	{
+		uint8 Data[128];
+	};
+
+	ResourceChurnBenchmarkResult RendererBenchmark::RunResourceChurn(uint32 iterations, uint32 vertexBufferCount)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		ResourceChurnBenchmarkResult result;
+		result.Iterations = iterations;
+		result.VertexBufferCount = vertexBufferCount;
+
+		uint64 start = Platform::GetNanoTime();
+		for (uint32 i = 0; i < iterations; i++)
+		{
+			ResourceChurnBlock* block = new ResourceChurnBlock();
+			block->Data[0] = static_cast<uint8>(i);
+			delete block;
+		}
+		uint64 end = Platform::GetNanoTime();
+		result.HeapTime = float(end - start) * 0.001f * 0.001f;
+
+		auto& pool = ObjectPool<ResourceChurnBlock>::Get();
+
+		start = Platform::GetNanoTime();
+		for (uint32 i = 0; i < iterations; i++)
+		{
+			PoolHandle<ResourceChurnBlock> block = pool.Create();
+			block->Data[0] = static_cast<uint8>(i);
+			pool.Destroy(block);
+		}
+		end = Platform::GetNanoTime();
+		result.PoolTime = float(end - start) * 0.001f * 0.001f;
+
+		uint64 heapAllocations = Memory::GetHeapAllocationCount();
+
+		start = Platform::GetNanoTime();
+		{
+			Ref<VertexBuffer> vertexBuffer;
+			uint64 size = 1024;
+			for (uint32 i = 0; i < vertexBufferCount; i++)
+			{
+				// Grow and wrap around, every iteration replaces the buffer
+				size = size < 64 * 1024 ? size * 2 : 1024;
+				vertexBuffer = VertexBuffer::Create(size, VertexBufferUsage::Dynamic);
+			}
+		}
+		end = Platform::GetNanoTime();
+		result.VertexBufferTime = float(end - start) * 0.001f * 0.001f;
+		result.VertexBufferHeapAllocations = Memory::GetHeapAllocationCount() - heapAllocations;
+
+		FLUX_INFO_CATEGORY("Renderer Benchmark", "Resource churn ({0} iterations, {1} vertex buffers)", iterations, vertexBufferCount);
+		FLUX_INFO_CATEGORY("Renderer Benchmark", "  Heap block: {0}ms", result.HeapTime);
+		FLUX_INFO_CATEGORY("Renderer Benchmark", "  Pool block: {0}ms", result.PoolTime);
+		FLUX_INFO_CATEGORY("Renderer Benchmark", "  Vertex buffers: {0}ms ({1} heap allocations)", result.VertexBufferTime, result.VertexBufferHeapAllocations);
+
+		return result;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "VertexBuffer.h"
+
+namespace Flux {
+
+	struct ResourceChurnBenchmarkResult
+	{
+		uint32 Iterations = 0;
+		uint32 VertexBufferCount = 0;
+
+		// Create/destroy of a block the size of the largest backend data struct
+		float HeapTime = 0.0f;
+		float PoolTime = 0.0f;
+
+		// Create/destroy of growing vertex buffers, like ImGuiRenderer does when its geometry grows
+		float VertexBufferTime = 0.0f;
+		uint64 VertexBufferHeapAllocations = 0;
+	};
+
+	class RendererBenchmark
+	{
+	public:
+		// Must be called on the main thread, the GPU work of the vertex buffers is submitted with the current frame
+		static ResourceChurnBenchmarkResult RunResourceChurn(uint32 iterations = 100000, uint32 vertexBufferCount = 1000);
+	};
+
+}
\ No newline at end of file
@@ -16,6 +16,8 @@ namespace Flux {
 	class Shader : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		virtual ~Shader() {}
 
 		virtual void Bind() const = 0;
@@ -0,0 +1,94 @@
+#include "FluxPCH.h"
+#include "StagingRing.h"
+
+#include "Flux/Runtime/Core/Engine.h"
+
+namespace Flux {
+
+	StagingRing::StagingRing(uint64 capacity, uint32 frameCount)
+		: m_Capacity(capacity)
+	{
+		FLUX_VERIFY(frameCount > 0);
+
+		m_Data = static_cast<uint8*>(Memory::Allocate(m_Capacity, MemoryTag::Renderer));
+		m_FrameHeads.resize(frameCount, 0);
+
+		m_Stats.Capacity = m_Capacity;
+	}
+
+	StagingRing::~StagingRing()
+	{
+		Memory::Free(m_Data);
+		m_Data = nullptr;
+	}
+
+	StagingBuffer StagingRing::Allocate(uint64 size)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		StagingBuffer buffer;
+		buffer.Size = size;
+
+		if (size == 0)
+			return buffer;
+
+		const uint64 alignedSize = (size + s_Alignment - 1) & ~(s_Alignment - 1);
+
+		// Allocations never wrap, the rest of the ring is skipped instead
+		uint64 head = m_Head;
+		uint64 offset = head % m_Capacity;
+		if (offset + alignedSize > m_Capacity)
+			head += m_Capacity - offset;
+
+		if (head + alignedSize - m_Tail > m_Capacity)
+		{
+			buffer.Data = Memory::Allocate(size, MemoryTag::Renderer);
+			buffer.HeapAllocated = true;
+			m_FrameHeapFallbacks++;
+			return buffer;
+		}
+
+		buffer.Data = m_Data + head % m_Capacity;
+		m_Head = head + alignedSize;
+		return buffer;
+	}
+
+	void StagingRing::BeginFrame(uint64 frameIndex)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		const uint64 frameCount = m_FrameHeads.size();
+		if (frameIndex < frameCount)
+			return;
+
+		// Wait for the frame that last used this slot, normally it has long been executed
+		const uint64 retiredFrame = frameIndex - frameCount;
+		while (m_CompletedFrames.load(std::memory_order_acquire) <= retiredFrame)
+			Platform::Sleep(0.0f);
+
+		m_Tail = Math::Max(m_Tail, m_FrameHeads[frameIndex % frameCount]);
+	}
+
+	void StagingRing::EndFrame(uint64 frameIndex)
+	{
+		FLUX_CHECK_IS_IN_MAIN_THREAD();
+
+		m_FrameHeads[frameIndex % m_FrameHeads.size()] = m_Head;
+
+		m_Stats.FrameBytes = m_Head - m_FrameStartHead;
+		m_Stats.FrameHeapFallbacks = m_FrameHeapFallbacks;
+
+		m_FrameStartHead = m_Head;
+		m_FrameHeapFallbacks = 0;
+	}
+
+	void StagingRing::SignalFrame(uint64 frameIndex)
+	{
+		FLUX_CHECK_IS_IN_RENDER_THREAD();
+
+		// Queues can be flushed again on shutdown, the fence never goes backwards
+		if (frameIndex + 1 > m_CompletedFrames.load(std::memory_order_relaxed))
+			m_CompletedFrames.store(frameIndex + 1, std::memory_order_release);
+	}
+
+}
\ No newline at end of file
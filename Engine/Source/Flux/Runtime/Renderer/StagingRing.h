@@ -0,0 +1,81 @@
+#pragma once
+
+namespace Flux {
+
+	// Upload memory handed from the main thread to a render command
+	struct StagingBuffer
+	{
+		void* Data = nullptr;
+		uint64 Size = 0;
+
+		// The ring was full, the memory is freed by Release
+		bool HeapAllocated = false;
+
+		template<typename T = const void>
+		T* GetData(uint64 offset = 0) const
+		{
+			return (T*)((uint8*)Data + offset);
+		}
+
+		// Called by the render command once the data has been consumed
+		void Release()
+		{
+			if (HeapAllocated)
+				Memory::Free(Data);
+
+			Data = nullptr;
+			Size = 0;
+			HeapAllocated = false;
+		}
+	};
+
+	struct StagingRingStats
+	{
+		uint64 Capacity = 0;
+		// Of the last completed frame
+		uint64 FrameBytes = 0;
+		uint32 FrameHeapFallbacks = 0;
+	};
+
+	// Ring buffer for render thread uploads. Allocations are a pointer bump on the main thread
+	// and are retired per frame: each frame in flight has a fence that the render thread signals
+	// once the render commands of that frame have been executed.
+	class StagingRing
+	{
+	public:
+		StagingRing(uint64 capacity, uint32 frameCount);
+		~StagingRing();
+
+		StagingRing(const StagingRing&) = delete;
+		StagingRing& operator=(const StagingRing&) = delete;
+
+		// Main thread
+		StagingBuffer Allocate(uint64 size);
+		void BeginFrame(uint64 frameIndex);
+		void EndFrame(uint64 frameIndex);
+
+		// Render thread, after every render command of the frame has been executed
+		void SignalFrame(uint64 frameIndex);
+
+		const StagingRingStats& GetStats() const { return m_Stats; }
+
+		static constexpr uint64 s_Alignment = 16;
+	private:
+		uint8* m_Data = nullptr;
+		uint64 m_Capacity = 0;
+
+		// Monotonic offsets, the position in the ring is offset % capacity
+		uint64 m_Head = 0;
+		uint64 m_Tail = 0;
+
+		// Head at the end of each frame in flight, becomes the tail once the frame is retired
+		std::vector<uint64> m_FrameHeads;
+		// Last frame + 1 whose render commands were executed
+		std::atomic<uint64> m_CompletedFrames = 0;
+
+		uint64 m_FrameStartHead = 0;
+		uint32 m_FrameHeapFallbacks = 0;
+		StagingRingStats m_Stats;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "FluxPCH.h"
+#include "StreamingBuffer.h"
+
+#include "Flux/Runtime/Core/Engine.h"
+
+#include "Renderer.h"
+
+#include "OpenGL/OpenGLStreamingBuffer.h"
+
+namespace Flux {
+
+	uint64 StreamingBuffer::Upload(const void* data, uint64 size, uint64 alignment)
+	{
+		StagingBuffer staging = Renderer::AllocateStaging(size);
+		if (size > 0)
+			memcpy(staging.Data, data, size);
+		return Upload(staging, alignment);
+	}
+
+	Ref<StreamingBuffer> StreamingBuffer::Create(uint64 regionSize, StreamingBufferType type)
+	{
+		switch (Engine::Get().GetGraphicsAPI())
+		{
+		case GraphicsAPI::OpenGL: return Ref<OpenGLStreamingBuffer>::Create(regionSize, type);
+		}
+		FLUX_ASSERT(false, "Unknown Graphics API.");
+		return nullptr;
+	}
+
+}
\ No newline at end of file
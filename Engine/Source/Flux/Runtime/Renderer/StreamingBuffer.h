@@ -0,0 +1,48 @@
+#pragma once
+
+#include "StagingRing.h"
+
+namespace Flux {
+
+	enum class StreamingBufferType : uint8
+	{
+		Vertex = 0,
+		Index,
+		// Shader storage buffer, ranges are bound to binding points with BindRange
+		Storage
+	};
+
+	// Buffer for geometry that is rewritten every frame. The buffer is split into one region per
+	// frame in flight, each frame writes into the next region once the GPU has finished reading it.
+	// Offsets returned by Upload are only valid for render commands of the same frame,
+	// and the buffer has to be bound after the uploads since it may be reallocated when a region overflows.
+	class StreamingBuffer : public ReferenceCounted
+	{
+	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
+		virtual ~StreamingBuffer() {}
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		// Binds [offset, offset + size) of a storage buffer to a shader binding point,
+		// the offset has to be a multiple of s_StorageAlignment
+		virtual void BindRange(uint32 binding, uint64 offset, uint64 size) const = 0;
+
+		// Takes ownership of the staging buffer, returns the offset of the data in the buffer
+		virtual uint64 Upload(StagingBuffer staging, uint64 alignment = 1) = 0;
+		uint64 Upload(const void* data, uint64 size, uint64 alignment = 1);
+
+		virtual uint64 GetRegionSize() const = 0;
+
+		virtual StreamingBufferType GetType() const = 0;
+
+		static constexpr uint32 s_RegionCount = 3;
+		// Largest storage buffer offset alignment required by desktop drivers
+		static constexpr uint64 s_StorageAlignment = 256;
+
+		static Ref<StreamingBuffer> Create(uint64 regionSize, StreamingBufferType type);
+	};
+
+}
\ No newline at end of file
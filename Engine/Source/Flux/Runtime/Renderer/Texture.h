@@ -36,6 +36,9 @@ namespace Flux {
 		uint32 MipCount = 1;
 		uint32 Samples = 1;
 
+		// Depth textures are sampled with a shadow sampler, which compares a reference depth to the texture
+		bool DepthComparison = false;
+
 		bool IsValid() const
 		{
 			return Format != TextureFormat::None && Width > 0 && Height > 0 && Layers > 0 && MipCount > 0 && Samples > 0;
@@ -45,6 +48,8 @@ namespace Flux {
 	class Texture : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		virtual ~Texture() {}
 
 		virtual void Reinitialize(const TextureProperties& properties) = 0;
@@ -52,6 +57,9 @@ namespace Flux {
 		virtual void AttachToFramebuffer(uint32 attachmentIndex) = 0;
 		virtual void AttachToFramebufferLayer(uint32 attachmentIndex, uint32 layer) = 0;
 
+		// Copies a layer into the same layer of a texture with the same size and format
+		virtual void CopyLayerTo(Ref<Texture> destination, uint32 layer) const = 0;
+
 		virtual void Bind(uint32 slot = 0) const = 0;
 		virtual void Unbind(uint32 slot = 0) const = 0;
 
@@ -12,6 +12,8 @@ namespace Flux {
 	class VertexBuffer : public ReferenceCounted
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Renderer;
+
 		virtual ~VertexBuffer() {}
 
 		virtual void Bind() const = 0;
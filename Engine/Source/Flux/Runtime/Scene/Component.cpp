@@ -7,6 +7,12 @@
 
 namespace Flux {
 
+	void Component::OnChanged()
+	{
+		if (m_Scene)
+			m_Scene->GetChangeTracker().MarkChanged(GetType(), m_Entity);
+	}
+
 #pragma region Name
 	void NameComponent::SetName(const std::string& name)
 	{
@@ -27,6 +33,42 @@ namespace Flux {
 	void TransformComponent::OnInit()
 	{
 		RecalculateTransform();
+		StorePreviousWorld();
+	}
+
+	Matrix4x4 TransformComponent::GetInterpolatedWorldTransform() const
+	{
+		if (!m_Scene->IsTransformInterpolated(m_Entity))
+			return m_WorldTransform;
+
+		Vector3 position;
+		Quaternion rotation;
+		Vector3 scale;
+		GetInterpolatedWorld(position, rotation, scale);
+		return Math::BuildTransformationMatrix(position, rotation, scale);
+	}
+
+	void TransformComponent::GetInterpolatedWorld(Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const
+	{
+		if (!m_Scene->IsTransformInterpolated(m_Entity))
+		{
+			outPosition = m_WorldPosition;
+			outRotation = m_WorldRotation;
+			outScale = m_WorldScale;
+			return;
+		}
+
+		float alpha = m_Scene->GetInterpolationAlpha();
+		outPosition = Vector3::Lerp(m_PreviousWorldPosition, m_WorldPosition, alpha);
+		outRotation = Quaternion::Slerp(m_PreviousWorldRotation, m_WorldRotation, alpha);
+		outScale = Vector3::Lerp(m_PreviousWorldScale, m_WorldScale, alpha);
+	}
+
+	void TransformComponent::StorePreviousWorld()
+	{
+		m_PreviousWorldPosition = m_WorldPosition;
+		m_PreviousWorldRotation = m_WorldRotation;
+		m_PreviousWorldScale = m_WorldScale;
 	}
 
 	void TransformComponent::OnImGuiRender()
@@ -129,16 +171,14 @@ namespace Flux {
 
 		if (entity.HasComponent<TransformComponent>())
 		{
-			auto& transformComponent = entity.GetComponent<TransformComponent>();
-
-			auto& worldTransform = transformComponent.GetWorldTransform();
-
-			uint64 hashCode = worldTransform.GetHashCode();
-			if (m_LastTransformHashCode != hashCode)
+			auto& changeTracker = m_Scene->GetChangeTracker();
+			if (changeTracker.HasChangedSince(ComponentType::Transform, m_Entity, m_LastTransformVersion))
 			{
+				auto& transformComponent = entity.GetComponent<TransformComponent>();
+
 				m_ViewMatrix = Matrix4x4::Inverse(Math::BuildTransformationMatrix(transformComponent.GetWorldPosition(), transformComponent.GetWorldRotation()));
 				RecalculateViewProjectionMatrix();
-				m_LastTransformHashCode = hashCode;
+				m_LastTransformVersion = changeTracker.GetEntityVersion(ComponentType::Transform, m_Entity);
 			}
 		}
 	}
@@ -151,7 +191,9 @@ namespace Flux {
 
 	void CameraComponent::RecalculateProjectionMatrix()
 	{
-		FLUX_VERIFY(m_AspectRatio > 0.0f);
+		// Recalculated on the first viewport resize
+		if (!(m_AspectRatio > 0.0f))
+			return;
 
 		switch (m_ProjectionType)
 		{
@@ -250,22 +292,78 @@ namespace Flux {
 			auto& submeshComponent = entity.GetComponent<SubmeshComponent>();
 			auto& transformComponent = entity.GetComponent<TransformComponent>();
 
-			auto& meshAssetID = submeshComponent.GetMeshAssetID();
-			Ref<Mesh> mesh = AssetDatabase::GetAssetFromID<Mesh>(meshAssetID);
-			if (mesh)
+			// Meshes that are not loaded yet are looked up again every frame
+			auto& changeTracker = m_Scene->GetChangeTracker();
+			if (!m_CachedMesh || changeTracker.HasChangedSince(ComponentType::Submesh, m_Entity, m_CachedSubmeshVersion))
+			{
+				m_CachedMesh = AssetDatabase::GetAssetFromID<Mesh>(submeshComponent.GetMeshAssetID());
+				m_CachedSubmeshVersion = changeTracker.GetEntityVersion(ComponentType::Submesh, m_Entity);
+			}
+
+			if (m_CachedMesh)
 			{
 				DynamicMeshSubmitInfo submitInfo;
-				submitInfo.Mesh = mesh;
+				submitInfo.Mesh = m_CachedMesh;
 				submitInfo.SubmeshIndex = submeshComponent.GetSubmeshIndex();
-				submitInfo.Transform = transformComponent.GetWorldTransform();
+				submitInfo.Transform = transformComponent.GetInterpolatedWorldTransform();
+				submitInfo.Static = m_Static;
+				// Every pipeline that renders the scene keeps its own previous level of detail
+				submitInfo.LODStateID = static_cast<uint64>(m_Entity) + 1;
 
 				pipeline->SubmitDynamicMesh(submitInfo);
 			}
 		}
 	}
+
+	void MeshRendererComponent::SetStatic(bool isStatic)
+	{
+		if (m_Static != isStatic)
+		{
+			m_Static = isStatic;
+			OnChanged();
+		}
+	}
 #pragma endregion MeshRenderer
 
 #pragma region Light
+	void LightComponent::OnRender(Ref<RenderPipeline> pipeline)
+	{
+		if (m_Type == LightType::Directional || m_Intensity <= 0.0f)
+			return;
+
+		Entity entity = { m_Entity, m_Scene };
+		auto& transformComponent = entity.GetComponent<TransformComponent>();
+
+		Matrix4x4 transform = transformComponent.GetInterpolatedWorldTransform();
+		const Vector4& translation = transform[3];
+		const Vector3 position = Vector3(translation.X, translation.Y, translation.Z);
+
+		if (m_Type == LightType::Point)
+		{
+			PointLightSubmitInfo submitInfo;
+			submitInfo.Position = position;
+			submitInfo.Color = m_Color * m_Intensity;
+			submitInfo.Range = m_Range;
+
+			pipeline->SubmitPointLight(submitInfo);
+		}
+		else
+		{
+			// Lights point along their local Z axis, like the directional light
+			Vector4 direction = transform * Vector4(0.0f, 0.0f, 1.0f, 0.0f);
+
+			SpotLightSubmitInfo submitInfo;
+			submitInfo.Position = position;
+			submitInfo.Direction = Vector3(direction.X, direction.Y, direction.Z).Normalized();
+			submitInfo.Color = m_Color * m_Intensity;
+			submitInfo.Range = m_Range;
+			submitInfo.InnerConeAngle = Math::Min(m_InnerConeAngle, m_OuterConeAngle);
+			submitInfo.OuterConeAngle = m_OuterConeAngle;
+
+			pipeline->SubmitSpotLight(submitInfo);
+		}
+	}
+
 	void LightComponent::SetLightType(LightType type)
 	{
 		if (m_Type != type)
@@ -283,6 +381,42 @@ namespace Flux {
 			OnChanged();
 		}
 	}
+
+	void LightComponent::SetIntensity(float intensity)
+	{
+		if (m_Intensity != intensity)
+		{
+			m_Intensity = intensity;
+			OnChanged();
+		}
+	}
+
+	void LightComponent::SetRange(float range)
+	{
+		if (m_Range != range)
+		{
+			m_Range = range;
+			OnChanged();
+		}
+	}
+
+	void LightComponent::SetInnerConeAngle(float angle)
+	{
+		if (m_InnerConeAngle != angle)
+		{
+			m_InnerConeAngle = angle;
+			OnChanged();
+		}
+	}
+
+	void LightComponent::SetOuterConeAngle(float angle)
+	{
+		if (m_OuterConeAngle != angle)
+		{
+			m_OuterConeAngle = angle;
+			OnChanged();
+		}
+	}
 #pragma endregion Light
 
 }
\ No newline at end of file
@@ -19,7 +19,9 @@ namespace Flux {
 		Camera,
 		Submesh,
 		MeshRenderer,
-		Light
+		Light,
+
+		Count
 	};
 
 	namespace Utils {
@@ -43,13 +45,21 @@ namespace Flux {
 
 	}
 
+	using ComponentMask = uint32;
+
+	namespace Utils {
+
+		inline constexpr ComponentMask ComponentTypeToMask(ComponentType type)
+		{
+			return 1u << static_cast<uint32>(type);
+		}
+
+	}
+
 #define COMPONENT_CLASS_TYPE(type) \
 	static ComponentType GetStaticType() { return ComponentType::type; } \
 	ComponentType GetType() const { return GetStaticType(); }
 
-	class Component;
-	using ComponentChangedCallback = std::function<void(Component*)>;
-
 	class Scene;
 
 	class Component
@@ -57,12 +67,17 @@ namespace Flux {
 	public:
 		virtual void OnInit() {}
 		virtual void OnUpdate() {}
+		// Runs at the fixed delta time of the engine, see Scene::OnFixedUpdate
+		virtual void OnFixedUpdate() {}
 		virtual void OnRender(Ref<RenderPipeline> pipeline) {}
 		virtual void OnImGuiRender() {}
 		virtual void OnViewportResize(uint32 width, uint32 height) {}
-		virtual void SetChangedCallback(const ComponentChangedCallback& callback) { m_Callback = callback; }
 
 		virtual ComponentType GetType() const = 0;
+
+		// Other component types the scene systems of this type read from.
+		// Defaults to all components, which serializes the system against every writer.
+		static constexpr ComponentMask SystemReadMask = ~ComponentMask(0);
 	private:
 		void SetEntity(entt::entity entity, Scene* scene)
 		{
@@ -72,16 +87,11 @@ namespace Flux {
 
 		friend class Scene;
 	protected:
-		void OnChanged()
-		{
-			if (m_Callback)
-				m_Callback(this);
-		}
+		// Marks the component as changed in the change tracker of the scene
+		void OnChanged();
 	protected:
-		entt::entity m_Entity;
-		Scene* m_Scene;
-
-		ComponentChangedCallback m_Callback;
+		entt::entity m_Entity = entt::null;
+		Scene* m_Scene = nullptr;
 	};
 
 	class IDComponent : public Component
@@ -109,21 +119,21 @@ namespace Flux {
 	class RelationshipComponent : public Component
 	{
 	public:
-		void SetChildCount(uint32 childCount) { m_ChildCount = childCount; }
-		void IncrementChildCount() { m_ChildCount++; }
-		void DecrementChildCount() { FLUX_ASSERT(m_ChildCount > 0); m_ChildCount--; }
+		void SetChildCount(uint32 childCount) { m_ChildCount = childCount; OnChanged(); }
+		void IncrementChildCount() { m_ChildCount++; OnChanged(); }
+		void DecrementChildCount() { FLUX_ASSERT(m_ChildCount > 0); m_ChildCount--; OnChanged(); }
 		uint32 GetChildCount() const { return m_ChildCount; }
 
-		void SetFirstChild(const Guid& guid) { m_FirstChild = guid; }
+		void SetFirstChild(const Guid& guid) { m_FirstChild = guid; OnChanged(); }
 		const Guid& GetFirstChild() const { return m_FirstChild; }
 
-		void SetPrevious(const Guid& guid) { m_Previous = guid; }
+		void SetPrevious(const Guid& guid) { m_Previous = guid; OnChanged(); }
 		const Guid& GetPrevious() const { return m_Previous; }
 
-		void SetNext(const Guid& guid) { m_Next = guid; }
+		void SetNext(const Guid& guid) { m_Next = guid; OnChanged(); }
 		const Guid& GetNext() const { return m_Next; }
 
-		void SetParent(const Guid& guid) { m_Parent = guid; }
+		void SetParent(const Guid& guid) { m_Parent = guid; OnChanged(); }
 		const Guid& GetParent() const { return m_Parent; }
 
 		COMPONENT_CLASS_TYPE(Relationship)
@@ -166,13 +176,22 @@ namespace Flux {
 		const Matrix4x4& GetLocalTransform() const { return m_LocalTransform; }
 		const Matrix4x4& GetWorldTransform() const { return m_WorldTransform; }
 
+		// World transform to render with. Transforms moved by the last fixed update step are interpolated
+		// between the state before and after that step, all others are returned as they are.
+		Matrix4x4 GetInterpolatedWorldTransform() const;
+		void GetInterpolatedWorld(Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const;
+
 		virtual void OnImGuiRender() override;
 
 		COMPONENT_CLASS_TYPE(Transform)
 	private:
 		void RecalculateTransform();
 
+		// Called by the scene before a fixed update step
+		void StorePreviousWorld();
+
 		friend class Entity;
+		friend class Scene;
 	private:
 		Vector3 m_LocalPosition;
 		Quaternion m_LocalRotation;
@@ -185,6 +204,11 @@ namespace Flux {
 
 		Matrix4x4 m_LocalTransform;
 		Matrix4x4 m_WorldTransform;
+
+		// World state before the last fixed update step that moved the transform
+		Vector3 m_PreviousWorldPosition;
+		Quaternion m_PreviousWorldRotation;
+		Vector3 m_PreviousWorldScale;
 	};
 
 	class CameraComponent : public Component
@@ -217,6 +241,8 @@ namespace Flux {
 		float GetFieldOfView() const { return m_FieldOfView; }
 
 		COMPONENT_CLASS_TYPE(Camera)
+
+		static constexpr ComponentMask SystemReadMask = Utils::ComponentTypeToMask(ComponentType::Transform);
 	private:
 		void RecalculateProjectionMatrix();
 		void RecalculateViewProjectionMatrix();
@@ -226,7 +252,8 @@ namespace Flux {
 		Matrix4x4 m_ViewProjectionMatrix = Matrix4x4(1.0f);
 		Matrix4x4 m_InverseViewProjectionMatrix = Matrix4x4(1.0f);
 
-		uint64 m_LastTransformHashCode = 0;
+		// Transform version the view matrix was built from
+		uint64 m_LastTransformVersion = 0;
 
 		ProjectionType m_ProjectionType = ProjectionType::Perspective;
 		float m_NearClip = 0.1f;
@@ -257,7 +284,21 @@ namespace Flux {
 	public:
 		virtual void OnRender(Ref<RenderPipeline> pipeline) override;
 
+		// Static meshes never move, so the render pipeline caches their shadows
+		void SetStatic(bool isStatic);
+		bool IsStatic() const { return m_Static; }
+
 		COMPONENT_CLASS_TYPE(MeshRenderer)
+
+		static constexpr ComponentMask SystemReadMask =
+			Utils::ComponentTypeToMask(ComponentType::Transform) |
+			Utils::ComponentTypeToMask(ComponentType::Submesh);
+	private:
+		// Mesh of the submesh component, resolved again when the submesh component changes
+		Ref<Mesh> m_CachedMesh;
+		uint64 m_CachedSubmeshVersion = 0;
+
+		bool m_Static = false;
 	};
 
 	class LightComponent : public Component
@@ -265,19 +306,44 @@ namespace Flux {
 	public:
 		enum class LightType : uint8
 		{
-			Directional = 0
+			Directional = 0,
+			Point,
+			Spot
 		};
 	public:
+		// Point and spot lights are submitted to the render pipeline, the directional light is set by the scene
+		virtual void OnRender(Ref<RenderPipeline> pipeline) override;
+
 		void SetLightType(LightType type);
 		LightType GetLightType() const { return m_Type; }
 		
 		void SetColor(const Vector3& color);
 		const Vector3& GetColor() const { return m_Color; }
 
+		void SetIntensity(float intensity);
+		float GetIntensity() const { return m_Intensity; }
+
+		// Distance at which point and spot lights fade out completely
+		void SetRange(float range);
+		float GetRange() const { return m_Range; }
+
+		// Full intensity inside the inner cone, fades out towards the outer cone. Half angles in degrees.
+		void SetInnerConeAngle(float angle);
+		float GetInnerConeAngle() const { return m_InnerConeAngle; }
+
+		void SetOuterConeAngle(float angle);
+		float GetOuterConeAngle() const { return m_OuterConeAngle; }
+
 		COMPONENT_CLASS_TYPE(Light)
+
+		static constexpr ComponentMask SystemReadMask = Utils::ComponentTypeToMask(ComponentType::Transform);
 	private:
 		LightType m_Type = LightType::Directional;
 		Vector3 m_Color = Vector3(1.0f);
+		float m_Intensity = 1.0f;
+		float m_Range = 10.0f;
+		float m_InnerConeAngle = 20.0f;
+		float m_OuterConeAngle = 30.0f;
 	};
 
 	template<typename... Component>
@@ -0,0 +1,91 @@
+#include "FluxPCH.h"
+#include "ComponentChangeTracker.h"
+
+namespace Flux {
+
+	void ComponentChangeTracker::Reserve(entt::entity entity)
+	{
+		size_t index = static_cast<size_t>(entt::to_entity(entity));
+		if (index >= m_Entities.size())
+		{
+			size_t entityCount = index + 1;
+			size_t blockCount = (entityCount + s_BlockSize - 1) / s_BlockSize;
+
+			m_Entities.resize(entityCount, entt::null);
+			for (auto& storage : m_Storages)
+			{
+				storage.EntityVersions.resize(entityCount, 0);
+				storage.BlockVersions.resize(blockCount, 0);
+				storage.DirtyBits.resize(blockCount, 0);
+			}
+		}
+
+		m_Entities[index] = entity;
+	}
+
+	void ComponentChangeTracker::Clear()
+	{
+		// Type versions keep counting up, so versions stored by
+		// the users of the tracker never compare as up to date
+		for (auto& storage : m_Storages)
+		{
+			storage.EntityVersions.clear();
+			storage.BlockVersions.clear();
+			storage.DirtyBits.clear();
+		}
+		m_Entities.clear();
+	}
+
+	void ComponentChangeTracker::MarkChanged(ComponentType type, entt::entity entity)
+	{
+		size_t index = static_cast<size_t>(entt::to_entity(entity));
+		FLUX_ASSERT(index < m_Entities.size(), "Entity was not reserved in the change tracker!");
+
+		auto& storage = m_Storages[static_cast<size_t>(type)];
+		size_t blockIndex = index / s_BlockSize;
+
+		uint64 version = std::atomic_ref<uint64>(storage.Version).fetch_add(1, std::memory_order_relaxed) + 1;
+
+		std::atomic_ref<uint64>(storage.EntityVersions[index]).store(version, std::memory_order_relaxed);
+
+		std::atomic_ref<uint64> blockVersion(storage.BlockVersions[blockIndex]);
+		uint64 currentBlockVersion = blockVersion.load(std::memory_order_relaxed);
+		while (currentBlockVersion < version && !blockVersion.compare_exchange_weak(currentBlockVersion, version, std::memory_order_relaxed))
+			;
+
+		std::atomic_ref<uint64>(storage.DirtyBits[blockIndex]).fetch_or(1ull << (index % s_BlockSize), std::memory_order_relaxed);
+	}
+
+	uint64 ComponentChangeTracker::GetVersion(ComponentType type) const
+	{
+		auto& storage = m_Storages[static_cast<size_t>(type)];
+		return std::atomic_ref<uint64>(const_cast<uint64&>(storage.Version)).load(std::memory_order_relaxed);
+	}
+
+	uint64 ComponentChangeTracker::GetEntityVersion(ComponentType type, entt::entity entity) const
+	{
+		size_t index = static_cast<size_t>(entt::to_entity(entity));
+		if (index >= m_Entities.size())
+			return 0;
+
+		auto& storage = m_Storages[static_cast<size_t>(type)];
+		return std::atomic_ref<uint64>(const_cast<uint64&>(storage.EntityVersions[index])).load(std::memory_order_relaxed);
+	}
+
+	bool ComponentChangeTracker::IsDirty(ComponentType type, entt::entity entity) const
+	{
+		size_t index = static_cast<size_t>(entt::to_entity(entity));
+		if (index >= m_Entities.size())
+			return false;
+
+		auto& storage = m_Storages[static_cast<size_t>(type)];
+		return (storage.DirtyBits[index / s_BlockSize] >> (index % s_BlockSize)) & 1;
+	}
+
+	void ComponentChangeTracker::ClearDirty()
+	{
+		for (auto& storage : m_Storages)
+			std::fill(storage.DirtyBits.begin(), storage.DirtyBits.end(), 0);
+	}
+
+}
\ No newline at end of file
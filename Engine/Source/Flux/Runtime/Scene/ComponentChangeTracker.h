@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Component.h"
+
+namespace Flux {
+
+	// Tracks component changes per component type without per-component callbacks.
+	// Every change bumps the version of its type and stamps the entity with it,
+	// so "changed since version N" is a compare instead of a hash or a callback.
+	// Entities are also flagged in a dirty bitset that is cleared once per scene update.
+	class ComponentChangeTracker
+	{
+	public:
+		// Grows the per-entity storage to fit the entity.
+		// Must not be called while components are being changed on other threads.
+		void Reserve(entt::entity entity);
+		void Clear();
+
+		// Thread-safe for entities that have been reserved
+		void MarkChanged(ComponentType type, entt::entity entity);
+
+		// Latest version handed out for the component type, 0 if it never changed
+		uint64 GetVersion(ComponentType type) const;
+		uint64 GetEntityVersion(ComponentType type, entt::entity entity) const;
+
+		bool HasChangedSince(ComponentType type, entt::entity entity, uint64 version) const
+		{
+			return GetEntityVersion(type, entity) > version;
+		}
+
+		bool IsDirty(ComponentType type, entt::entity entity) const;
+		void ClearDirty();
+
+		// Calls func(entity) for every entity whose component of the given type changed after version.
+		// Blocks of entities that have not changed since then are skipped as a whole.
+		template<typename Func>
+		void EachChangedSince(ComponentType type, uint64 version, Func func) const
+		{
+			const auto& storage = m_Storages[static_cast<size_t>(type)];
+			for (size_t blockIndex = 0; blockIndex < storage.BlockVersions.size(); blockIndex++)
+			{
+				if (storage.BlockVersions[blockIndex] <= version)
+					continue;
+
+				size_t end = Math::Min((blockIndex + 1) * s_BlockSize, m_Entities.size());
+				for (size_t index = blockIndex * s_BlockSize; index < end; index++)
+				{
+					if (storage.EntityVersions[index] > version)
+						func(m_Entities[index]);
+				}
+			}
+		}
+
+		// Calls func(entity) for every entity whose component of the given type changed since the last ClearDirty
+		template<typename Func>
+		void EachDirty(ComponentType type, Func func) const
+		{
+			const auto& storage = m_Storages[static_cast<size_t>(type)];
+			for (size_t blockIndex = 0; blockIndex < storage.DirtyBits.size(); blockIndex++)
+			{
+				uint64 bits = storage.DirtyBits[blockIndex];
+				while (bits)
+				{
+					size_t index = blockIndex * s_BlockSize + std::countr_zero(bits);
+					func(m_Entities[index]);
+					bits &= bits - 1;
+				}
+			}
+		}
+	private:
+		static constexpr size_t s_BlockSize = 64;
+
+		struct TypeStorage
+		{
+			uint64 Version = 0;
+
+			// Indexed by entity index
+			std::vector<uint64> EntityVersions;
+			// Highest entity version of each block of s_BlockSize entities
+			std::vector<uint64> BlockVersions;
+			// One bit per entity
+			std::vector<uint64> DirtyBits;
+		};
+
+		std::array<TypeStorage, static_cast<size_t>(ComponentType::Count)> m_Storages;
+		std::vector<entt::entity> m_Entities;
+	};
+
+}
\ No newline at end of file
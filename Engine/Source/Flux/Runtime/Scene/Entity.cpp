@@ -117,7 +117,7 @@ namespace Flux {
 
 	bool Entity::IsParentOf(Entity entity)
 	{
-		std::vector<Entity> children = GetChildren();
+		FrameVector<Entity> children = GetChildren();
 		if (children.empty())
 			return false;
 
@@ -141,10 +141,10 @@ namespace Flux {
 		return entity.IsParentOf(*this);
 	}
 
-	std::vector<Guid> Entity::GetChildrenGUIDs() const
+	FrameVector<Guid> Entity::GetChildrenGUIDs() const
 	{
 		auto& relationshipComponent = GetComponent<RelationshipComponent>();
-		std::vector<Guid> result(relationshipComponent.GetChildCount());
+		FrameVector<Guid> result(relationshipComponent.GetChildCount());
 		Guid currentGuid = relationshipComponent.GetFirstChild();
 		for (uint32 i = 0; i < relationshipComponent.GetChildCount(); i++)
 		{
@@ -154,11 +154,11 @@ namespace Flux {
 		return result;
 	}
 
-	std::vector<Entity> Entity::GetChildren()
+	FrameVector<Entity> Entity::GetChildren()
 	{
-		std::vector<Guid> childrenGUIDs = GetChildrenGUIDs();
+		FrameVector<Guid> childrenGUIDs = GetChildrenGUIDs();
 
-		std::vector<Entity> result(childrenGUIDs.size());
+		FrameVector<Entity> result(childrenGUIDs.size());
 		for (size_t i = 0; i < childrenGUIDs.size(); i++)
 			result[i] = m_Scene->GetEntityFromGUID(childrenGUIDs[i]);
 		return result;
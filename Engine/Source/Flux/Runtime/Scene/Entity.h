@@ -76,8 +76,10 @@ namespace Flux {
 
 		void SetParent(Entity parent);
 
-		std::vector<Guid> GetChildrenGUIDs() const;
-		std::vector<Entity> GetChildren();
+		// Both are allocated from frame memory and only valid until the frame memory of the current frame is reused.
+		// Don't store the result in anything that outlives the frame, copy it into a regular container instead.
+		FrameVector<Guid> GetChildrenGUIDs() const;
+		FrameVector<Entity> GetChildren();
 
 		Scene* GetScene() const { return m_Scene; }
 	private:
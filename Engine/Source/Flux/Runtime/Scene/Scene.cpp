@@ -14,6 +14,7 @@ namespace Flux {
 
 		CreateSceneEntity();
 		RegisterComponentCallbacks(m_Registry);
+		RegisterComponentSystems();
 	}
 
 	Scene::~Scene()
@@ -23,8 +24,37 @@ namespace Flux {
 
 	void Scene::OnUpdate()
 	{
-		for (auto entity : m_Registry.view<entt::entity>())
-			OnUpdate(entity);
+		FLUX_PROFILE_FUNC();
+
+		m_ChangeTracker.ClearDirty();
+
+		SceneSystemContext context;
+		context.ViewportWidth = m_ViewportWidth;
+		context.ViewportHeight = m_ViewportHeight;
+
+		m_SystemScheduler.Run(SceneSystemPhase::Update, *this, context);
+	}
+
+	void Scene::OnFixedUpdate()
+	{
+		FLUX_PROFILE_FUNC();
+
+		// Transforms moved since the start of the previous step interpolate from their current state,
+		// all others still hold it from an earlier step
+		EachChangedSince<TransformComponent>(m_FixedUpdateTransformVersion, [](entt::entity entity, TransformComponent& transformComponent)
+		{
+			transformComponent.StorePreviousWorld();
+		});
+
+		m_FixedUpdateTransformVersion = m_ChangeTracker.GetVersion(ComponentType::Transform);
+
+		SceneSystemContext context;
+		context.ViewportWidth = m_ViewportWidth;
+		context.ViewportHeight = m_ViewportHeight;
+
+		m_SystemScheduler.Run(SceneSystemPhase::FixedUpdate, *this, context);
+
+		m_FixedUpdateEndTransformVersion = m_ChangeTracker.GetVersion(ComponentType::Transform);
 	}
 
 	void Scene::OnRender(Ref<RenderPipeline> pipeline)
@@ -33,6 +63,8 @@ namespace Flux {
 		if (!mainCameraEntity)
 			return;
 
+		m_InterpolationAlpha = Engine::Get().GetFixedUpdateAlpha();
+
 		auto& transformComponent = mainCameraEntity.GetComponent<TransformComponent>();
 		auto& cameraComponent = mainCameraEntity.GetComponent<CameraComponent>();
 
@@ -42,14 +74,37 @@ namespace Flux {
 		cameraData.ViewProjectionMatrix = cameraComponent.GetViewProjectionMatrix();
 		cameraData.InverseViewProjectionMatrix = cameraComponent.GetInverseViewProjectionMatrix();
 		cameraData.Position = transformComponent.GetWorldPosition();
+
+		// A camera moved by the fixed update has to be interpolated like everything it looks at
+		if (IsTransformInterpolated(mainCameraEntity))
+		{
+			Vector3 position;
+			Quaternion rotation;
+			Vector3 scale;
+			transformComponent.GetInterpolatedWorld(position, rotation, scale);
+
+			cameraData.ViewMatrix = Matrix4x4::Inverse(Math::BuildTransformationMatrix(position, rotation));
+			cameraData.ViewProjectionMatrix = cameraData.ProjectionMatrix * cameraData.ViewMatrix;
+			cameraData.InverseViewProjectionMatrix = Matrix4x4::Inverse(cameraData.ViewProjectionMatrix);
+			cameraData.Position = position;
+		}
 		cameraData.NearClip = cameraComponent.GetNearClip();
 		cameraData.FarClip = cameraComponent.GetFarClip();
 
-		OnRender(pipeline, cameraData);
+		RenderFromCamera(pipeline, cameraData);
 	}
 
 	void Scene::OnRender(Ref<RenderPipeline> pipeline, const SceneCameraData& cameraData)
 	{
+		m_InterpolationAlpha = Engine::Get().GetFixedUpdateAlpha();
+
+		RenderFromCamera(pipeline, cameraData);
+	}
+
+	void Scene::RenderFromCamera(Ref<RenderPipeline> pipeline, const SceneCameraData& cameraData)
+	{
+		FLUX_PROFILE_FUNC();
+
 		auto& cameraSettings = pipeline->GetCameraSettings();
 		cameraSettings.ViewMatrix = cameraData.ViewMatrix;
 		cameraSettings.ProjectionMatrix = cameraData.ProjectionMatrix;
@@ -59,29 +114,64 @@ namespace Flux {
 		cameraSettings.NearClip = cameraData.NearClip;
 		cameraSettings.FarClip = cameraData.FarClip;
 
-		auto& environmentSettings = pipeline->GetEnvironmentSettings();
+		UpdateDirectionalLight();
 
-		auto view = m_Registry.view<const TransformComponent, const LightComponent>();
-		for (auto [entity, transformComponent, lightComponent] : view.each())
+		if (m_DirectionalLight.Entity != entt::null)
 		{
-			auto lightType = lightComponent.GetLightType();
-			if (lightType == LightComponent::LightType::Directional)
-			{
-				environmentSettings.LightDirection = transformComponent.GetWorldRotation() * Vector3(0.0f, 0.0f, 1.0f);
-				environmentSettings.LightColor = lightComponent.GetColor();
-				break;
-			}
+			auto& environmentSettings = pipeline->GetEnvironmentSettings();
+			environmentSettings.LightDirection = m_DirectionalLight.Direction;
+			environmentSettings.LightColor = m_DirectionalLight.Color;
 		}
 
 		pipeline->BeginRendering();
 
-		for (auto entity : m_Registry.view<entt::entity>())
-			OnRender(entity, pipeline);
+		SceneSystemContext context;
+		context.Pipeline = pipeline;
+		context.ViewportWidth = m_ViewportWidth;
+		context.ViewportHeight = m_ViewportHeight;
+
+		m_SystemScheduler.Run(SceneSystemPhase::Render, *this, context);
 
 		// Render all entities
 		pipeline->EndRendering();
 	}
 
+	void Scene::UpdateDirectionalLight()
+	{
+		uint64 lightVersion = m_ChangeTracker.GetVersion(ComponentType::Light);
+		if (m_DirectionalLight.LightVersion != lightVersion)
+		{
+			m_DirectionalLight.Entity = entt::null;
+			m_DirectionalLight.TransformVersion = 0;
+
+			auto view = m_Registry.view<const TransformComponent, const LightComponent>();
+			for (auto [entity, transformComponent, lightComponent] : view.each())
+			{
+				auto lightType = lightComponent.GetLightType();
+				if (lightType == LightComponent::LightType::Directional)
+				{
+					m_DirectionalLight.Entity = entity;
+					m_DirectionalLight.Color = lightComponent.GetColor() * lightComponent.GetIntensity();
+					break;
+				}
+			}
+
+			m_DirectionalLight.LightVersion = lightVersion;
+		}
+
+		if (m_DirectionalLight.Entity == entt::null)
+			return;
+
+		FLUX_ASSERT(m_Registry.all_of<LightComponent>(m_DirectionalLight.Entity));
+
+		if (m_ChangeTracker.HasChangedSince(ComponentType::Transform, m_DirectionalLight.Entity, m_DirectionalLight.TransformVersion))
+		{
+			auto& transformComponent = m_Registry.get<TransformComponent>(m_DirectionalLight.Entity);
+			m_DirectionalLight.Direction = transformComponent.GetWorldRotation() * Vector3(0.0f, 0.0f, 1.0f);
+			m_DirectionalLight.TransformVersion = m_ChangeTracker.GetEntityVersion(ComponentType::Transform, m_DirectionalLight.Entity);
+		}
+	}
+
 	void Scene::SetViewportSize(uint32 width, uint32 height)
 	{
 		if (m_ViewportWidth != width || m_ViewportHeight != height)
@@ -89,8 +179,11 @@ namespace Flux {
 			m_ViewportWidth = width;
 			m_ViewportHeight = height;
 
-			for (auto entity : m_Registry.view<entt::entity>())
-				OnViewportResize(entity, width, height);
+			SceneSystemContext context;
+			context.ViewportWidth = width;
+			context.ViewportHeight = height;
+
+			m_SystemScheduler.Run(SceneSystemPhase::ViewportResize, *this, context);
 		}
 	}
 
@@ -129,6 +222,28 @@ namespace Flux {
 		return entity;
 	}
 
+	Entity Scene::CreatePointLight(const std::string& name, const Vector3& position, float range)
+	{
+		Entity entity = CreateEmpty(name);
+		auto& lightComponent = entity.AddComponent<LightComponent>();
+		lightComponent.SetLightType(LightComponent::LightType::Point);
+		lightComponent.SetRange(range);
+		entity.GetComponent<TransformComponent>().SetLocalPosition(position);
+		return entity;
+	}
+
+	Entity Scene::CreateSpotLight(const std::string& name, const Vector3& position, const Vector3& rotation, float range)
+	{
+		Entity entity = CreateEmpty(name);
+		auto& lightComponent = entity.AddComponent<LightComponent>();
+		lightComponent.SetLightType(LightComponent::LightType::Spot);
+		lightComponent.SetRange(range);
+		auto& transformComponent = entity.GetComponent<TransformComponent>();
+		transformComponent.SetLocalPosition(position);
+		transformComponent.SetLocalRotation(Quaternion(rotation * Math::DegToRad));
+		return entity;
+	}
+
 	void Scene::CreateSceneEntity()
 	{		
 		Guid rootEntityGUID = Guid::NewGuid();
@@ -163,17 +278,42 @@ namespace Flux {
 		return {};
 	}
 
+	void Scene::CreateEntities(const std::vector<Guid>& guids, uint32 count, std::vector<entt::entity>& outEntities)
+	{
+		FLUX_VERIFY(count > 0 && count <= guids.size());
+
+		m_Registry.clear();
+		m_EntityMap.clear();
+		m_ChangeTracker.Clear();
+		m_DirectionalLight = {};
+
+		outEntities.resize(count);
+		m_Registry.storage<entt::entity>().reserve(count);
+		m_Registry.create(outEntities.begin(), outEntities.end());
+
+		m_EntityMap.reserve(count);
+
+		std::vector<IDComponent> idComponents(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			idComponents[i].SetGUID(guids[i]);
+			m_EntityMap[guids[i]] = { outEntities[i], this };
+		}
+		InsertComponents(outEntities, idComponents);
+
+		*m_SceneEntity = { outEntities[0], this };
+	}
+
 	void Scene::OnComponentAdded(Entity entity, Component& component)
 	{
+		m_ChangeTracker.Reserve(entity);
+
 		component.SetEntity(entity, this);
 		component.OnInit();
 		component.OnViewportResize(m_ViewportWidth, m_ViewportHeight);
-#if 0
-		component.SetChangedCallback([entity](auto component)
-		{
-			FLUX_WARNING("{0} Component in entity '{1}' was modified!", Utils::ComponentTypeToString(component->GetType()), entity.GetComponent<NameComponent>().GetName());
-		});
-#endif
+
+		// Components that don't change in OnInit are new to the tracker as well
+		m_ChangeTracker.MarkChanged(component.GetType(), entity);
 	}
 
 }
\ No newline at end of file
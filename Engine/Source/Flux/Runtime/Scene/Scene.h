@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Component.h"
+#include "SceneSystem.h"
+#include "ComponentChangeTracker.h"
+
+#include "Flux/Runtime/Core/JobSystem.h"
 
 #include "Flux/Runtime/Asset/Asset.h"
 #include "Flux/Runtime/Renderer/RenderPipeline.h"
@@ -26,10 +30,14 @@ namespace Flux {
 	class Scene : public Asset
 	{
 	public:
+		static constexpr MemoryTag AllocationTag = MemoryTag::Scene;
+
 		Scene();
 		virtual ~Scene();
 
 		void OnUpdate();
+		// One fixed update step, called by the engine at its fixed delta time
+		void OnFixedUpdate();
 		void OnRender(Ref<RenderPipeline> pipeline);
 		void OnRender(Ref<RenderPipeline> pipeline, const SceneCameraData& cameraData);
 		void SetViewportSize(uint32 width, uint32 height);
@@ -38,6 +46,8 @@ namespace Flux {
 		Entity CreateEmpty(const std::string& name, const Guid& guid);
 		Entity CreateCamera(const std::string& name);
 		Entity CreateDirectionalLight(const std::string& name, const Vector3& rotation);
+		Entity CreatePointLight(const std::string& name, const Vector3& position, float range);
+		Entity CreateSpotLight(const std::string& name, const Vector3& position, const Vector3& rotation, float range);
 		Entity GetEntityFromGUID(const Guid& guid);
 		const Entity& GetRootEntity() const { return *m_SceneEntity; }
 
@@ -46,6 +56,94 @@ namespace Flux {
 		entt::registry& GetRegistry() { return m_Registry; }
 		const entt::registry& GetRegistry() const { return m_Registry; }
 
+		SceneSystemScheduler& GetSystemScheduler() { return m_SystemScheduler; }
+		const SceneSystemScheduler& GetSystemScheduler() const { return m_SystemScheduler; }
+
+		ComponentChangeTracker& GetChangeTracker() { return m_ChangeTracker; }
+		const ComponentChangeTracker& GetChangeTracker() const { return m_ChangeTracker; }
+
+		// True if the transform was moved by the last fixed update step and not since
+		bool IsTransformInterpolated(entt::entity entity) const
+		{
+			uint64 version = m_ChangeTracker.GetEntityVersion(ComponentType::Transform, entity);
+			return version > m_FixedUpdateTransformVersion && version <= m_FixedUpdateEndTransformVersion;
+		}
+
+		// Set when the scene is rendered
+		float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+
+		// Calls func(entity, component) for every entity whose component of type T
+		// changed after version, e.g. the Transform version a cache was built from.
+		template<typename T, typename Func>
+		void EachChangedSince(uint64 version, Func func)
+		{
+			auto& storage = m_Registry.storage<T>();
+			m_ChangeTracker.EachChangedSince(T::GetStaticType(), version, [&storage, &func](entt::entity entity)
+			{
+				if (storage.contains(entity))
+					func(entity, storage.get(entity));
+			});
+		}
+
+		// Calls func(entity, components...) for every entity that has all of the components,
+		// split into chunks of grainSize entities that are processed by the job system.
+		// func may only write to the components of the entity it is called with. Transform components
+		// can only be read, as changing one recalculates the transforms of its parent's hierarchy,
+		// use ParallelEachDeferred to change them.
+		template<typename... Components, typename Func>
+		void ParallelEach(Func func, uint32 grainSize = s_DefaultParallelGrainSize)
+		{
+			static_assert(!(std::is_same_v<Components, TransformComponent> || ...), "Transform components can only be read in parallel");
+
+			auto view = m_Registry.view<Components...>();
+
+			ParallelEachChunk(view, grainSize, [&view, &func](const entt::entity* entities, uint32 begin, uint32 end)
+			{
+				for (uint32 i = begin; i < end; i++)
+				{
+					entt::entity entity = entities[i];
+					if (view.contains(entity))
+						func(entity, view.template get<Components>(entity)...);
+				}
+			});
+		}
+
+		// Same as ParallelEach, but func returns a value that is handed to writeBack(entity, value)
+		// on the calling thread afterwards. Write-backs always happen in view order,
+		// independent of the grain size and the number of workers, and may change any component.
+		template<typename... Components, typename Func, typename WriteBackFunc>
+		void ParallelEachDeferred(Func func, WriteBackFunc writeBack, uint32 grainSize = s_DefaultParallelGrainSize)
+		{
+			static_assert(!(std::is_same_v<Components, TransformComponent> || ...), "Transform components can only be read in parallel");
+
+			using ResultType = std::invoke_result_t<Func, entt::entity, Components&...>;
+
+			auto view = m_Registry.view<Components...>();
+
+			const entt::entity* entities = view.handle() ? view.handle()->data() : nullptr;
+			const uint32 entityCount = view.handle() ? static_cast<uint32>(view.handle()->size()) : 0;
+
+			std::vector<std::optional<ResultType>> results(entityCount);
+
+			ParallelEachChunk(view, grainSize, [&view, &func, &results](const entt::entity* chunkEntities, uint32 begin, uint32 end)
+			{
+				for (uint32 i = begin; i < end; i++)
+				{
+					entt::entity entity = chunkEntities[i];
+					if (view.contains(entity))
+						results[i].emplace(func(entity, view.template get<Components>(entity)...));
+				}
+			});
+
+			for (uint32 i = 0; i < entityCount; i++)
+			{
+				if (results[i])
+					writeBack(entities[i], *results[i]);
+			}
+		}
+
+		static constexpr uint32 s_DefaultParallelGrainSize = 1024;
+
 		ASSET_CLASS_TYPE(Scene)
 	private:
 		void CreateSceneEntity();
@@ -53,12 +151,78 @@ namespace Flux {
 
 		void OnComponentAdded(Entity entity, Component& component);
 
+		void UpdateDirectionalLight();
+
+		// Expects the interpolation alpha of this frame to be set already
+		void RenderFromCamera(Ref<RenderPipeline> pipeline, const SceneCameraData& cameraData);
+
+		// Replaces all entities of the scene, the first GUID becomes the scene entity
+		void CreateEntities(const std::vector<Guid>& guids, uint32 count, std::vector<entt::entity>& outEntities);
+
+		// Bulk constructs components without firing OnComponentAdded for each of them,
+		// OnInit and OnViewportResize are left to the caller
+		template<typename T>
+		void InsertComponents(const std::vector<entt::entity>& entities, std::vector<T>& components)
+		{
+			FLUX_VERIFY(entities.size() == components.size());
+
+			for (size_t i = 0; i < components.size(); i++)
+			{
+				components[i].SetEntity(entities[i], this);
+
+				m_ChangeTracker.Reserve(entities[i]);
+				m_ChangeTracker.MarkChanged(T::GetStaticType(), entities[i]);
+			}
+
+			auto& storage = m_Registry.storage<T>();
+			storage.reserve(storage.size() + components.size());
+
+			m_Registry.on_construct<T>().template disconnect<&Scene::OnComponentAdded<T>>(this);
+			storage.insert(entities.begin(), entities.end(), std::make_move_iterator(components.begin()));
+			m_Registry.on_construct<T>().template connect<&Scene::OnComponentAdded<T>>(this);
+		}
+
+		template<typename View, typename ChunkFunc>
+		void ParallelEachChunk(const View& view, uint32 grainSize, ChunkFunc chunkFunc)
+		{
+			FLUX_VERIFY(grainSize > 0);
+
+			// The leading storage of the view is walked by index, so chunks
+			// never depend on which worker ends up processing them
+			auto handle = view.handle();
+			if (!handle || handle->empty())
+				return;
+
+			const entt::entity* entities = handle->data();
+			const uint32 entityCount = static_cast<uint32>(handle->size());
+
+			if (entityCount <= grainSize)
+			{
+				chunkFunc(entities, 0, entityCount);
+				return;
+			}
+
+			JobCounter counter;
+			JobSystem::Dispatch(counter, entityCount, grainSize, [entities, &chunkFunc](uint32 begin, uint32 end)
+			{
+				chunkFunc(entities, begin, end);
+			});
+			JobSystem::Wait(counter);
+		}
+
 		template<typename T>
 		void OnComponentAdded(entt::registry& registry, entt::entity entity)
 		{
 			OnComponentAdded({ entity, this }, dynamic_cast<Component&>(registry.get<T>(entity)));
 		}
 
+		// Removed components count as changed, so caches of their type notice that they're gone
+		template<typename T>
+		void OnComponentRemoved(entt::registry& registry, entt::entity entity)
+		{
+			m_ChangeTracker.MarkChanged(T::GetStaticType(), entity);
+		}
+
 		template<typename... Component>
 		void RegisterComponentCallbacks(entt::registry& registry)
 		{
@@ -77,81 +241,122 @@ namespace Flux {
 		void RegisterComponentCallbacks(entt::registry& registry)
 		{
 			RegisterComponentCallbacks(AllComponents{}, registry);
-		}
 
-		template<typename... Component>
-		void OnUpdate(entt::entity entity)
-		{
-			([&]()
-			{
-				Component* component = m_Registry.try_get<Component>(entity);
-				if (component)
-					component->OnUpdate();
-			}(), ...);
+			// The directional light is cached by the scene
+			registry.on_destroy<LightComponent>().connect<&Scene::OnComponentRemoved<LightComponent>>(this);
 		}
 
-		template<typename... Component>
-		void OnUpdate(ComponentSet<Component...>, entt::entity entity)
+		template<typename T>
+		void RegisterComponentSystems()
 		{
-			OnUpdate<Component...>(entity);
-		}
+			SceneSystemCreateInfo createInfo;
+			createInfo.ReadMask = T::SystemReadMask;
+			createInfo.WriteMask = Utils::ComponentTypeToMask(T::GetStaticType());
 
-		void OnUpdate(entt::entity entity)
-		{
-			OnUpdate(AllComponents{}, entity);
-		}
+			const char* typeName = Utils::ComponentTypeToString(T::GetStaticType());
 
-		template<typename... Component>
-		void OnRender(entt::entity entity, Ref<RenderPipeline> pipeline)
-		{
-			([&]()
+			// Only component types that override a hook get a system for it
+			if constexpr (!std::is_same_v<decltype(&T::OnUpdate), decltype(&Component::OnUpdate)>)
 			{
-				Component* component = m_Registry.try_get<Component>(entity);
-				if (component)
-					component->OnRender(pipeline);
-			}(), ...);
-		}
+				createInfo.Name = fmt::format("{0}::OnUpdate", typeName);
+				createInfo.Phase = SceneSystemPhase::Update;
+				createInfo.Exclusive = false;
+				createInfo.Function = [](Scene& scene, const SceneSystemContext& context)
+				{
+					scene.ParallelEach<T>([](entt::entity entity, T& component)
+					{
+						component.OnUpdate();
+					});
+				};
+				m_SystemScheduler.AddSystem(createInfo);
+			}
 
-		template<typename... Component>
-		void OnRender(ComponentSet<Component...>, entt::entity entity, Ref<RenderPipeline> pipeline)
-		{
-			OnRender<Component...>(entity, pipeline);
-		}
+			if constexpr (!std::is_same_v<decltype(&T::OnFixedUpdate), decltype(&Component::OnFixedUpdate)>)
+			{
+				createInfo.Name = fmt::format("{0}::OnFixedUpdate", typeName);
+				createInfo.Phase = SceneSystemPhase::FixedUpdate;
+				createInfo.Exclusive = false;
+				createInfo.Function = [](Scene& scene, const SceneSystemContext& context)
+				{
+					scene.ParallelEach<T>([](entt::entity entity, T& component)
+					{
+						component.OnFixedUpdate();
+					});
+				};
+				m_SystemScheduler.AddSystem(createInfo);
+			}
 
-		void OnRender(entt::entity entity, Ref<RenderPipeline> pipeline)
-		{
-			OnRender(AllComponents{}, entity, pipeline);
-		}
+			if constexpr (!std::is_same_v<decltype(&T::OnRender), decltype(&Component::OnRender)>)
+			{
+				createInfo.Name = fmt::format("{0}::OnRender", typeName);
+				createInfo.Phase = SceneSystemPhase::Render;
+				// Render pipelines are not thread-safe
+				createInfo.Exclusive = true;
+				createInfo.Function = [](Scene& scene, const SceneSystemContext& context)
+				{
+					for (auto [entity, component] : scene.m_Registry.view<T>().each())
+						component.OnRender(context.Pipeline);
+				};
+				m_SystemScheduler.AddSystem(createInfo);
+			}
 
-		template<typename... Component>
-		void OnViewportResize(entt::entity entity, uint32 width, uint32 height)
-		{
-			([&]()
+			if constexpr (!std::is_same_v<decltype(&T::OnViewportResize), decltype(&Component::OnViewportResize)>)
 			{
-				Component* component = m_Registry.try_get<Component>(entity);
-				if (component)
-					component->OnViewportResize(width, height);
-			}(), ...);
+				createInfo.Name = fmt::format("{0}::OnViewportResize", typeName);
+				createInfo.Phase = SceneSystemPhase::ViewportResize;
+				createInfo.Exclusive = false;
+				createInfo.Function = [](Scene& scene, const SceneSystemContext& context)
+				{
+					scene.ParallelEach<T>([&context](entt::entity entity, T& component)
+					{
+						component.OnViewportResize(context.ViewportWidth, context.ViewportHeight);
+					});
+				};
+				m_SystemScheduler.AddSystem(createInfo);
+			}
 		}
 
 		template<typename... Component>
-		void OnViewportResize(ComponentSet<Component...>, entt::entity entity, uint32 width, uint32 height)
+		void RegisterComponentSystems(ComponentSet<Component...>)
 		{
-			OnViewportResize<Component...>(entity, width, height);
+			(RegisterComponentSystems<Component>(), ...);
 		}
 
-		void OnViewportResize(entt::entity entity, uint32 width, uint32 height)
+		void RegisterComponentSystems()
 		{
-			OnViewportResize(AllComponents{}, entity, width, height);
+			RegisterComponentSystems(AllComponents{});
 		}
 	private:
 		entt::registry m_Registry;
-		std::unordered_map<Guid, Entity> m_EntityMap;
+		GuidMap<Entity> m_EntityMap;
+
+		SceneSystemScheduler m_SystemScheduler;
+		ComponentChangeTracker m_ChangeTracker;
+
+		// Directional light of the environment, searched for again when a light component changes
+		struct DirectionalLightCache
+		{
+			entt::entity Entity = entt::null;
+			Vector3 Direction = Vector3(0.0f, 0.0f, 1.0f);
+			Vector3 Color = Vector3(1.0f);
+
+			uint64 LightVersion = 0;
+			uint64 TransformVersion = 0;
+		};
+
+		DirectionalLightCache m_DirectionalLight;
 
 		Entity* m_SceneEntity = nullptr;
 
 		uint32 m_ViewportWidth = 0;
 		uint32 m_ViewportHeight = 0;
+
+		// Transform versions at the start and the end of the last fixed update step
+		uint64 m_FixedUpdateTransformVersion = 0;
+		uint64 m_FixedUpdateEndTransformVersion = 0;
+		float m_InterpolationAlpha = 0.0f;
+
+		friend class SceneSerializer;
 	};
 
 }
\ No newline at end of file
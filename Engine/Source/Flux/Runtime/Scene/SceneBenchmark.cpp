@@ -0,0 +1,123 @@
+#include "FluxPCH.h"
+#include "SceneBenchmark.h"
+
+#include "SceneSerializer.h"
+
+namespace Flux {
+
+	SceneBenchmarkResult SceneBenchmark::RunTransformUpdate(uint32 entityCount, uint32 grainSize)
+	{
+		SceneBenchmarkResult result;
+		result.EntityCount = entityCount;
+		result.GrainSize = grainSize;
+
+		uint64 start = Platform::GetNanoTime();
+		Ref<Scene> scene = CreateTransformScene(entityCount);
+		uint64 end = Platform::GetNanoTime();
+		result.CreateTime = float(end - start) * 0.001f * 0.001f;
+
+		auto& registry = scene->GetRegistry();
+
+		const Vector3 offset = Vector3(0.0f, 1.0f, 0.0f);
+
+		start = Platform::GetNanoTime();
+		for (auto [entity, transformComponent] : registry.view<TransformComponent>().each())
+			transformComponent.SetLocalPosition(transformComponent.GetLocalPosition() + offset);
+		end = Platform::GetNanoTime();
+		result.SerialTime = float(end - start) * 0.001f * 0.001f;
+
+		// Transforms can only be read in parallel, the new positions are applied on this thread
+		start = Platform::GetNanoTime();
+		std::vector<Vector3> positions(registry.storage<entt::entity>().size());
+		scene->ParallelEach<const TransformComponent>([&offset, &positions](entt::entity entity, const TransformComponent& transformComponent)
+		{
+			positions[entt::to_entity(entity)] = transformComponent.GetLocalPosition() + offset;
+		}, grainSize);
+		for (auto [entity, transformComponent] : registry.view<TransformComponent>().each())
+			transformComponent.SetLocalPosition(positions[entt::to_entity(entity)]);
+		end = Platform::GetNanoTime();
+		result.ParallelTime = float(end - start) * 0.001f * 0.001f;
+
+		start = Platform::GetNanoTime();
+		scene->ParallelEachDeferred<const TransformComponent>([&offset](entt::entity entity, const TransformComponent& transformComponent)
+		{
+			return transformComponent.GetLocalPosition() + offset;
+		},
+		[&registry](entt::entity entity, const Vector3& position)
+		{
+			registry.get<TransformComponent>(entity).SetLocalPosition(position);
+		}, grainSize);
+		end = Platform::GetNanoTime();
+		result.DeferredTime = float(end - start) * 0.001f * 0.001f;
+
+		FLUX_INFO_CATEGORY("Scene Benchmark", "{0} transforms (grain size {1}, {2} workers)", entityCount, grainSize, JobSystem::GetWorkerCount());
+		FLUX_INFO_CATEGORY("Scene Benchmark", "  Create: {0}ms", result.CreateTime);
+		FLUX_INFO_CATEGORY("Scene Benchmark", "  Serial: {0}ms", result.SerialTime);
+		FLUX_INFO_CATEGORY("Scene Benchmark", "  ParallelEach: {0}ms", result.ParallelTime);
+		FLUX_INFO_CATEGORY("Scene Benchmark", "  ParallelEachDeferred: {0}ms", result.DeferredTime);
+
+		return result;
+	}
+
+	SceneSerializationBenchmarkResult SceneBenchmark::RunSerialization(uint32 entityCount)
+	{
+		SceneSerializationBenchmarkResult result;
+		result.EntityCount = entityCount;
+
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "FluxSceneBenchmark.scene";
+
+		{
+			Ref<Scene> scene = CreateTransformScene(entityCount);
+
+			uint64 start = Platform::GetNanoTime();
+			bool saved = SceneSerializer::Serialize(scene, path);
+			uint64 end = Platform::GetNanoTime();
+			result.SaveTime = float(end - start) * 0.001f * 0.001f;
+
+			FLUX_VERIFY(saved);
+		}
+
+		Ref<Scene> scene = Ref<Scene>::Create();
+
+		uint64 start = Platform::GetNanoTime();
+		bool loaded = SceneSerializer::Deserialize(scene, path);
+		uint64 end = Platform::GetNanoTime();
+		result.LoadTime = float(end - start) * 0.001f * 0.001f;
+
+		FLUX_VERIFY(loaded);
+		std::filesystem::remove(path);
+
+		result.EntitiesPerSecond = result.LoadTime > 0.0f ? float(entityCount) / (result.LoadTime * 0.001f) : 0.0f;
+
+		FLUX_INFO_CATEGORY("Scene Benchmark", "Serialization of {0} entities", entityCount);
+		FLUX_INFO_CATEGORY("Scene Benchmark", "  Save: {0}ms", result.SaveTime);
+		FLUX_INFO_CATEGORY("Scene Benchmark", "  Load: {0}ms ({1} entities/s)", result.LoadTime, uint64(result.EntitiesPerSecond));
+
+		return result;
+	}
+
+	Ref<Scene> SceneBenchmark::CreateTransformScene(uint32 entityCount)
+	{
+		Ref<Scene> scene = Ref<Scene>::Create();
+		auto& registry = scene->GetRegistry();
+
+		registry.storage<IDComponent>().reserve(entityCount);
+		registry.storage<NameComponent>().reserve(entityCount);
+		registry.storage<RelationshipComponent>().reserve(entityCount);
+		registry.storage<TransformComponent>().reserve(entityCount);
+
+		// Entities are not parented to the scene entity, appending
+		// a million children to the same parent is quadratic
+		for (uint32 i = 0; i < entityCount; i++)
+		{
+			entt::entity entity = registry.create();
+			registry.emplace<IDComponent>(entity).SetGUID(Guid::NewGuid());
+			registry.emplace<NameComponent>(entity).SetName(fmt::format("Entity {0}", i));
+			registry.emplace<RelationshipComponent>(entity);
+			registry.emplace<TransformComponent>(entity, Vector3(static_cast<float>(i), 0.0f, 0.0f));
+		}
+
+		return scene;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Scene.h"
+
+namespace Flux {
+
+	struct SceneBenchmarkResult
+	{
+		uint32 EntityCount = 0;
+		uint32 GrainSize = 0;
+
+		float CreateTime = 0.0f;
+		float SerialTime = 0.0f;
+		float ParallelTime = 0.0f;
+		float DeferredTime = 0.0f;
+	};
+
+	struct SceneSerializationBenchmarkResult
+	{
+		uint32 EntityCount = 0;
+
+		float SaveTime = 0.0f;
+		float LoadTime = 0.0f;
+		float EntitiesPerSecond = 0.0f;
+	};
+
+	class SceneBenchmark
+	{
+	public:
+		// Creates a flat scene with entityCount transforms and moves every transform serially,
+		// with positions gathered by Scene::ParallelEach and with Scene::ParallelEachDeferred.
+		static SceneBenchmarkResult RunTransformUpdate(uint32 entityCount = 1000000, uint32 grainSize = Scene::s_DefaultParallelGrainSize);
+
+		// Saves a flat scene with entityCount named transforms to a binary scene file and loads it again
+		static SceneSerializationBenchmarkResult RunSerialization(uint32 entityCount = 1000000);
+	private:
+		static Ref<Scene> CreateTransformScene(uint32 entityCount);
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,852 @@
+#include "FluxPCH.h"
+#include "SceneSerializer.h"
+
+#include "Entity.h"
+
+#include "Flux/Runtime/Utils/FileHelper.h"
+#include "Flux/Runtime/Utils/YAMLHelper.h"
+
+namespace Flux {
+
+	// IDComponent has no column, entity i always has GUID i of the GUID table
+	using SerializedComponents = ComponentSet<
+		NameComponent,
+		RelationshipComponent,
+		TransformComponent,
+		CameraComponent,
+		SubmeshComponent,
+		MeshRendererComponent,
+		LightComponent
+	>;
+
+	static constexpr uint32 s_SceneFileMagic = 0x53584C46; // "FLXS"
+	static constexpr uint32 s_InvalidIndex = ~0u;
+
+	struct SceneFileHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 EntityCount;
+		uint32 GuidCount;
+		uint32 StringCount;
+		uint32 ColumnCount;
+	};
+
+	struct ComponentColumnHeader
+	{
+		uint32 Type;
+		uint32 ComponentCount;
+		uint32 RecordSize;
+	};
+
+	// Math types have user-defined copy constructors, records only contain trivially copyable data
+	struct RecordVector3
+	{
+		float X;
+		float Y;
+		float Z;
+
+		RecordVector3() = default;
+		RecordVector3(const Vector3& v)
+			: X(v.X), Y(v.Y), Z(v.Z) {}
+
+		operator Vector3() const { return Vector3(X, Y, Z); }
+	};
+
+	template<typename T>
+	struct ComponentRecord;
+
+	template<typename T>
+	struct ComponentColumn
+	{
+		using ColumnComponent = T;
+		using RecordType = typename ComponentRecord<T>::Type;
+
+		// Sorted by entity index
+		std::vector<uint32> EntityIndices;
+		std::vector<RecordType> Records;
+	};
+
+	template<typename Set>
+	struct ComponentColumnTuple;
+
+	template<typename... Component>
+	struct ComponentColumnTuple<ComponentSet<Component...>>
+	{
+		using Type = std::tuple<ComponentColumn<Component>...>;
+	};
+
+	// GUID and string tables, shared by the binary and the text form
+	struct SceneTables
+	{
+		std::vector<Guid> Guids;
+		GuidMap<uint32> GuidIndices;
+
+		std::vector<std::string> Strings;
+		std::unordered_map<std::string, uint32> StringIndices;
+
+		uint32 AddGuid(const Guid& guid)
+		{
+			if (!guid)
+				return s_InvalidIndex;
+
+			auto [it, inserted] = GuidIndices.try_emplace(guid, static_cast<uint32>(Guids.size()));
+			if (inserted)
+				Guids.push_back(guid);
+			return it->second;
+		}
+
+		Guid GetGuid(uint32 index) const
+		{
+			return index < Guids.size() ? Guids[index] : Guid();
+		}
+
+		uint32 AddString(const std::string& string)
+		{
+			auto [it, inserted] = StringIndices.try_emplace(string, static_cast<uint32>(Strings.size()));
+			if (inserted)
+				Strings.push_back(string);
+			return it->second;
+		}
+
+		const std::string& GetString(uint32 index) const
+		{
+			static const std::string s_EmptyString;
+			return index < Strings.size() ? Strings[index] : s_EmptyString;
+		}
+	};
+
+#pragma region Records
+	template<>
+	struct ComponentRecord<NameComponent>
+	{
+		struct Type
+		{
+			uint32 NameIndex;
+		};
+
+		static Type Write(const NameComponent& component, SceneTables& data)
+		{
+			return { data.AddString(component.GetName()) };
+		}
+
+		static void Read(const Type& record, const SceneTables& data, NameComponent& component)
+		{
+			component.SetName(data.GetString(record.NameIndex));
+		}
+
+		static void Emit(YAML::Emitter& out, const Type& record, const SceneTables& data)
+		{
+			out << data.GetString(record.NameIndex);
+		}
+
+		static Type Parse(const YAML::Node& node, SceneTables& data)
+		{
+			return { data.AddString(node.as<std::string>()) };
+		}
+	};
+
+	template<>
+	struct ComponentRecord<RelationshipComponent>
+	{
+		struct Type
+		{
+			uint32 Parent;
+			uint32 FirstChild;
+			uint32 Previous;
+			uint32 Next;
+			uint32 ChildCount;
+		};
+
+		static Type Write(const RelationshipComponent& component, SceneTables& data)
+		{
+			Type record;
+			record.Parent = data.AddGuid(component.GetParent());
+			record.FirstChild = data.AddGuid(component.GetFirstChild());
+			record.Previous = data.AddGuid(component.GetPrevious());
+			record.Next = data.AddGuid(component.GetNext());
+			record.ChildCount = component.GetChildCount();
+			return record;
+		}
+
+		static void Read(const Type& record, const SceneTables& data, RelationshipComponent& component)
+		{
+			component.SetParent(data.GetGuid(record.Parent));
+			component.SetFirstChild(data.GetGuid(record.FirstChild));
+			component.SetPrevious(data.GetGuid(record.Previous));
+			component.SetNext(data.GetGuid(record.Next));
+			component.SetChildCount(record.ChildCount);
+		}
+
+		static void Emit(YAML::Emitter& out, const Type& record, const SceneTables& data)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "Parent" << YAML::Value << data.GetGuid(record.Parent);
+			out << YAML::Key << "FirstChild" << YAML::Value << data.GetGuid(record.FirstChild);
+			out << YAML::Key << "Previous" << YAML::Value << data.GetGuid(record.Previous);
+			out << YAML::Key << "Next" << YAML::Value << data.GetGuid(record.Next);
+			out << YAML::Key << "ChildCount" << YAML::Value << record.ChildCount;
+			out << YAML::EndMap;
+		}
+
+		static Type Parse(const YAML::Node& node, SceneTables& data)
+		{
+			Type record;
+			record.Parent = data.AddGuid(node["Parent"].as<Guid>());
+			record.FirstChild = data.AddGuid(node["FirstChild"].as<Guid>());
+			record.Previous = data.AddGuid(node["Previous"].as<Guid>());
+			record.Next = data.AddGuid(node["Next"].as<Guid>());
+			record.ChildCount = node["ChildCount"].as<uint32>();
+			return record;
+		}
+	};
+
+	template<>
+	struct ComponentRecord<TransformComponent>
+	{
+		struct Type
+		{
+			RecordVector3 LocalPosition;
+			RecordVector3 LocalEulerAngles;
+			RecordVector3 LocalScale;
+		};
+
+		static Type Write(const TransformComponent& component, SceneTables& data)
+		{
+			return { component.GetLocalPosition(), component.GetLocalEulerAngles(), component.GetLocalScale() };
+		}
+
+		static void Read(const Type& record, const SceneTables& data, TransformComponent& component)
+		{
+			component = TransformComponent(record.LocalPosition, record.LocalEulerAngles, record.LocalScale);
+		}
+
+		static void Emit(YAML::Emitter& out, const Type& record, const SceneTables& data)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "Position" << YAML::Value << Vector3(record.LocalPosition);
+			out << YAML::Key << "EulerAngles" << YAML::Value << Vector3(record.LocalEulerAngles);
+			out << YAML::Key << "Scale" << YAML::Value << Vector3(record.LocalScale);
+			out << YAML::EndMap;
+		}
+
+		static Type Parse(const YAML::Node& node, SceneTables& data)
+		{
+			return { node["Position"].as<Vector3>(), node["EulerAngles"].as<Vector3>(), node["Scale"].as<Vector3>() };
+		}
+	};
+
+	template<>
+	struct ComponentRecord<CameraComponent>
+	{
+		struct Type
+		{
+			uint32 ProjectionType;
+			float NearClip;
+			float FarClip;
+			float FieldOfView;
+		};
+
+		static Type Write(const CameraComponent& component, SceneTables& data)
+		{
+			return { static_cast<uint32>(component.GetProjectionType()), component.GetNearClip(), component.GetFarClip(), component.GetFieldOfView() };
+		}
+
+		static void Read(const Type& record, const SceneTables& data, CameraComponent& component)
+		{
+			component.SetProjectionType(static_cast<CameraComponent::ProjectionType>(record.ProjectionType));
+			component.SetNearClip(record.NearClip);
+			component.SetFarClip(record.FarClip);
+			component.SetFieldOfView(record.FieldOfView);
+		}
+
+		static void Emit(YAML::Emitter& out, const Type& record, const SceneTables& data)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "ProjectionType" << YAML::Value << record.ProjectionType;
+			out << YAML::Key << "NearClip" << YAML::Value << record.NearClip;
+			out << YAML::Key << "FarClip" << YAML::Value << record.FarClip;
+			out << YAML::Key << "FieldOfView" << YAML::Value << record.FieldOfView;
+			out << YAML::EndMap;
+		}
+
+		static Type Parse(const YAML::Node& node, SceneTables& data)
+		{
+			return { node["ProjectionType"].as<uint32>(), node["NearClip"].as<float>(), node["FarClip"].as<float>(), node["FieldOfView"].as<float>() };
+		}
+	};
+
+	template<>
+	struct ComponentRecord<SubmeshComponent>
+	{
+		struct Type
+		{
+			uint32 MeshAsset;
+			uint32 SubmeshIndex;
+		};
+
+		static Type Write(const SubmeshComponent& component, SceneTables& data)
+		{
+			return { data.AddGuid(component.GetMeshAssetID()), component.GetSubmeshIndex() };
+		}
+
+		static void Read(const Type& record, const SceneTables& data, SubmeshComponent& component)
+		{
+			component.SetMeshAssetID(data.GetGuid(record.MeshAsset));
+			component.SetSubmeshIndex(record.SubmeshIndex);
+		}
+
+		static void Emit(YAML::Emitter& out, const Type& record, const SceneTables& data)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "Mesh" << YAML::Value << data.GetGuid(record.MeshAsset);
+			out << YAML::Key << "SubmeshIndex" << YAML::Value << record.SubmeshIndex;
+			out << YAML::EndMap;
+		}
+
+		static Type Parse(const YAML::Node& node, SceneTables& data)
+		{
+			return { data.AddGuid(node["Mesh"].as<Guid>()), node["SubmeshIndex"].as<uint32>() };
+		}
+	};
+
+	template<>
+	struct ComponentRecord<MeshRendererComponent>
+	{
+		struct Type
+		{
+			uint8 Static;
+		};
+
+		static Type Write(const MeshRendererComponent& component, SceneTables& data)
+		{
+			return { uint8(component.IsStatic() ? 1 : 0) };
+		}
+
+		static void Read(const Type& record, const SceneTables& data, MeshRendererComponent& component)
+		{
+			component.SetStatic(record.Static != 0);
+		}
+
+		static void Emit(YAML::Emitter& out, const Type& record, const SceneTables& data)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "Static" << YAML::Value << (record.Static != 0);
+			out << YAML::EndMap;
+		}
+
+		static Type Parse(const YAML::Node& node, SceneTables& data)
+		{
+			// Scenes written before meshes could be static have an empty map
+			return { uint8(node["Static"] && node["Static"].as<bool>() ? 1 : 0) };
+		}
+	};
+
+	template<>
+	struct ComponentRecord<LightComponent>
+	{
+		struct Type
+		{
+			uint32 LightType;
+			RecordVector3 Color;
+			float Intensity;
+			float Range;
+			float InnerConeAngle;
+			float OuterConeAngle;
+		};
+
+		static Type Write(const LightComponent& component, SceneTables& data)
+		{
+			return {
+				static_cast<uint32>(component.GetLightType()),
+				component.GetColor(),
+				component.GetIntensity(),
+				component.GetRange(),
+				component.GetInnerConeAngle(),
+				component.GetOuterConeAngle()
+			};
+		}
+
+		static void Read(const Type& record, const SceneTables& data, LightComponent& component)
+		{
+			component.SetLightType(static_cast<LightComponent::LightType>(record.LightType));
+			component.SetColor(record.Color);
+			component.SetIntensity(record.Intensity);
+			component.SetRange(record.Range);
+			component.SetInnerConeAngle(record.InnerConeAngle);
+			component.SetOuterConeAngle(record.OuterConeAngle);
+		}
+
+		static void Emit(YAML::Emitter& out, const Type& record, const SceneTables& data)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "LightType" << YAML::Value << record.LightType;
+			out << YAML::Key << "Color" << YAML::Value << Vector3(record.Color);
+			out << YAML::Key << "Intensity" << YAML::Value << record.Intensity;
+			out << YAML::Key << "Range" << YAML::Value << record.Range;
+			out << YAML::Key << "InnerConeAngle" << YAML::Value << record.InnerConeAngle;
+			out << YAML::Key << "OuterConeAngle" << YAML::Value << record.OuterConeAngle;
+			out << YAML::EndMap;
+		}
+
+		static Type Parse(const YAML::Node& node, SceneTables& data)
+		{
+			return {
+				node["LightType"].as<uint32>(),
+				node["Color"].as<Vector3>(),
+				node["Intensity"].as<float>(),
+				node["Range"].as<float>(),
+				node["InnerConeAngle"].as<float>(),
+				node["OuterConeAngle"].as<float>()
+			};
+		}
+	};
+#pragma endregion Records
+
+	struct SceneData : public SceneTables
+	{
+		uint32 EntityCount = 0;
+		typename ComponentColumnTuple<SerializedComponents>::Type Columns;
+	};
+
+	template<typename Func>
+	static void ForEachColumn(SceneData& data, Func func)
+	{
+		std::apply([&func](auto&... column) { (func(column), ...); }, data.Columns);
+	}
+
+	template<typename Func>
+	static void ForEachColumn(const SceneData& data, Func func)
+	{
+		std::apply([&func](const auto&... column) { (func(column), ...); }, data.Columns);
+	}
+
+	template<typename Column>
+	static uint32 FindRecordIndex(const Column& column, uint32 entityIndex)
+	{
+		auto it = std::lower_bound(column.EntityIndices.begin(), column.EntityIndices.end(), entityIndex);
+		if (it == column.EntityIndices.end() || *it != entityIndex)
+			return s_InvalidIndex;
+		return static_cast<uint32>(it - column.EntityIndices.begin());
+	}
+
+	void SceneSerializer::GatherSceneData(Scene& scene, SceneData& data)
+	{
+		auto& registry = scene.GetRegistry();
+
+		// The scene entity is always entity 0
+		entt::entity sceneEntity = scene.GetRootEntity();
+
+		std::vector<entt::entity> entities;
+		entities.reserve(registry.storage<IDComponent>().size());
+		entities.push_back(sceneEntity);
+
+		for (auto entity : registry.view<IDComponent>())
+		{
+			if (entity != sceneEntity)
+				entities.push_back(entity);
+		}
+
+		data.EntityCount = static_cast<uint32>(entities.size());
+		data.Guids.reserve(entities.size());
+		data.GuidIndices.reserve(entities.size());
+
+		// Entity GUIDs go first, so that entity indices are also GUID indices
+		for (auto entity : entities)
+			data.AddGuid(registry.get<IDComponent>(entity).GetGUID());
+
+		FLUX_VERIFY(data.Guids.size() == entities.size(), "Scene contains invalid or duplicate entity GUIDs!");
+
+		ForEachColumn(data, [&](auto& column)
+		{
+			using ColumnType = std::decay_t<decltype(column)>;
+			using ColumnComponent = typename ColumnType::ColumnComponent;
+
+			auto& storage = registry.storage<ColumnComponent>();
+			column.EntityIndices.reserve(storage.size());
+			column.Records.reserve(storage.size());
+
+			for (uint32 entityIndex = 0; entityIndex < data.EntityCount; entityIndex++)
+			{
+				entt::entity entity = entities[entityIndex];
+				if (!storage.contains(entity))
+					continue;
+
+				column.EntityIndices.push_back(entityIndex);
+				column.Records.push_back(ComponentRecord<ColumnComponent>::Write(storage.get(entity), data));
+			}
+		});
+	}
+
+	bool SceneSerializer::ApplySceneData(Scene& scene, const SceneData& data)
+	{
+		if (data.EntityCount == 0 || data.EntityCount > data.Guids.size())
+			return false;
+
+		bool valid = true;
+		ForEachColumn(data, [&](const auto& column)
+		{
+			if (column.EntityIndices.size() != column.Records.size())
+				valid = false;
+
+			// The indices are inserted into the component storage in one go, which needs them sorted and unique
+			for (size_t i = 0; i < column.EntityIndices.size(); i++)
+			{
+				if (column.EntityIndices[i] >= data.EntityCount || (i > 0 && column.EntityIndices[i] <= column.EntityIndices[i - 1]))
+					valid = false;
+			}
+		});
+
+		if (!valid)
+			return false;
+
+		std::vector<entt::entity> entities;
+		scene.CreateEntities(data.Guids, data.EntityCount, entities);
+
+		ForEachColumn(data, [&](const auto& column)
+		{
+			using ColumnType = std::decay_t<decltype(column)>;
+			using ColumnComponent = typename ColumnType::ColumnComponent;
+
+			std::vector<entt::entity> columnEntities(column.EntityIndices.size());
+			std::vector<ColumnComponent> components(column.Records.size());
+
+			for (size_t i = 0; i < components.size(); i++)
+			{
+				columnEntities[i] = entities[column.EntityIndices[i]];
+				ComponentRecord<ColumnComponent>::Read(column.Records[i], data, components[i]);
+			}
+
+			scene.InsertComponents(columnEntities, components);
+		});
+
+		auto& registry = scene.GetRegistry();
+
+		// Recalculate every transform hierarchy once, starting at the topmost transforms
+		for (auto [entity, transformComponent, relationshipComponent] : registry.view<TransformComponent, RelationshipComponent>().each())
+		{
+			Entity parent = scene.GetEntityFromGUID(relationshipComponent.GetParent());
+			if (!parent || !parent.HasComponent<TransformComponent>())
+				transformComponent.OnInit();
+		}
+
+		for (auto [entity, cameraComponent] : registry.view<CameraComponent>().each())
+			cameraComponent.OnViewportResize(scene.m_ViewportWidth, scene.m_ViewportHeight);
+
+		return true;
+	}
+
+	template<typename T>
+	static void WriteData(std::vector<uint8>& out, const T* data, size_t count)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		size_t offset = out.size();
+		out.resize(offset + sizeof(T) * count);
+		if (count > 0)
+			memcpy(out.data() + offset, data, sizeof(T) * count);
+	}
+
+	template<typename T>
+	static void WriteValue(std::vector<uint8>& out, const T& value)
+	{
+		WriteData(out, &value, 1);
+	}
+
+	struct SceneFileReader
+	{
+		const std::vector<uint8>& Data;
+		size_t Offset = 0;
+
+		template<typename T>
+		bool ReadData(T* outData, size_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			if (sizeof(T) * count > Data.size() - Offset)
+				return false;
+
+			if (count > 0)
+				memcpy(outData, Data.data() + Offset, sizeof(T) * count);
+			Offset += sizeof(T) * count;
+			return true;
+		}
+
+		template<typename T>
+		bool ReadValue(T& outValue)
+		{
+			return ReadData(&outValue, 1);
+		}
+
+		// Whether count elements of the given size fit into the rest of the data,
+		// checked before resizing to counts read from the file
+		bool CanRead(size_t elementSize, size_t count) const
+		{
+			return count <= (Data.size() - Offset) / elementSize;
+		}
+
+		bool Skip(size_t size)
+		{
+			if (size > Data.size() - Offset)
+				return false;
+
+			Offset += size;
+			return true;
+		}
+	};
+
+	bool SceneSerializer::Serialize(Ref<Scene> scene, const std::filesystem::path& path)
+	{
+		SceneData data;
+		GatherSceneData(*scene, data);
+
+		std::vector<uint8> binary;
+
+		SceneFileHeader header;
+		header.Magic = s_SceneFileMagic;
+		header.Version = s_Version;
+		header.EntityCount = data.EntityCount;
+		header.GuidCount = static_cast<uint32>(data.Guids.size());
+		header.StringCount = static_cast<uint32>(data.Strings.size());
+		header.ColumnCount = static_cast<uint32>(std::tuple_size_v<decltype(data.Columns)>);
+		WriteValue(binary, header);
+
+		WriteData(binary, data.Guids.data(), data.Guids.size());
+
+		for (auto& string : data.Strings)
+		{
+			WriteValue(binary, static_cast<uint32>(string.size()));
+			WriteData(binary, string.data(), string.size());
+		}
+
+		ForEachColumn(data, [&binary](const auto& column)
+		{
+			using ColumnType = std::decay_t<decltype(column)>;
+			using ColumnComponent = typename ColumnType::ColumnComponent;
+
+			ComponentColumnHeader columnHeader;
+			columnHeader.Type = static_cast<uint32>(ColumnComponent::GetStaticType());
+			columnHeader.ComponentCount = static_cast<uint32>(column.Records.size());
+			columnHeader.RecordSize = sizeof(typename ColumnType::RecordType);
+			WriteValue(binary, columnHeader);
+
+			WriteData(binary, column.EntityIndices.data(), column.EntityIndices.size());
+			WriteData(binary, column.Records.data(), column.Records.size());
+		});
+
+		return FileHelper::SaveBinaryToFileU8(binary, path);
+	}
+
+	bool SceneSerializer::Deserialize(Ref<Scene> scene, const std::filesystem::path& path)
+	{
+		std::vector<uint8> binary;
+		if (!FileHelper::LoadFileToBinaryU8(binary, path))
+			return false;
+
+		SceneFileReader reader{ binary };
+
+		SceneFileHeader header;
+		if (!reader.ReadValue(header) || header.Magic != s_SceneFileMagic)
+		{
+			FLUX_ERROR_CATEGORY("Scene Serializer", "'{0}' is not a scene file", path.string());
+			return false;
+		}
+
+		if (header.Version != s_Version)
+		{
+			FLUX_ERROR_CATEGORY("Scene Serializer", "'{0}' has version {1}, expected version {2}", path.string(), header.Version, s_Version);
+			return false;
+		}
+
+		SceneData data;
+		data.EntityCount = header.EntityCount;
+
+		if (header.EntityCount > header.GuidCount || !reader.CanRead(sizeof(Guid), header.GuidCount))
+			return false;
+
+		std::vector<Guid> guids(header.GuidCount);
+		if (!reader.ReadData(guids.data(), guids.size()))
+			return false;
+
+		// The entity GUIDs come first in the table
+		data.Guids.reserve(header.GuidCount);
+		data.GuidIndices.reserve(data.EntityCount);
+		for (uint32 entityIndex = 0; entityIndex < data.EntityCount; entityIndex++)
+			data.AddGuid(guids[entityIndex]);
+
+		if (data.Guids.size() != data.EntityCount)
+		{
+			FLUX_ERROR_CATEGORY("Scene Serializer", "'{0}' contains invalid or duplicate entity GUIDs", path.string());
+			return false;
+		}
+
+		data.Guids.insert(data.Guids.end(), guids.begin() + data.EntityCount, guids.end());
+
+		// Every string has at least its length
+		if (!reader.CanRead(sizeof(uint32), header.StringCount))
+			return false;
+
+		data.Strings.resize(header.StringCount);
+		for (auto& string : data.Strings)
+		{
+			uint32 length;
+			if (!reader.ReadValue(length) || !reader.CanRead(sizeof(char), length))
+				return false;
+
+			string.resize(length);
+			if (!reader.ReadData(string.data(), length))
+				return false;
+		}
+
+		for (uint32 columnIndex = 0; columnIndex < header.ColumnCount; columnIndex++)
+		{
+			ComponentColumnHeader columnHeader;
+			if (!reader.ReadValue(columnHeader))
+				return false;
+
+			bool found = false;
+			bool valid = true;
+			ForEachColumn(data, [&](auto& column)
+			{
+				using ColumnType = std::decay_t<decltype(column)>;
+				using ColumnComponent = typename ColumnType::ColumnComponent;
+
+				if (columnHeader.Type != static_cast<uint32>(ColumnComponent::GetStaticType()))
+					return;
+
+				found = true;
+				if (columnHeader.RecordSize != sizeof(typename ColumnType::RecordType) ||
+					!reader.CanRead(sizeof(uint32) + columnHeader.RecordSize, columnHeader.ComponentCount))
+				{
+					valid = false;
+					return;
+				}
+
+				column.EntityIndices.resize(columnHeader.ComponentCount);
+				column.Records.resize(columnHeader.ComponentCount);
+				valid = reader.ReadData(column.EntityIndices.data(), column.EntityIndices.size()) &&
+					reader.ReadData(column.Records.data(), column.Records.size());
+			});
+
+			// Columns of unknown component types are skipped
+			if (!found)
+				valid = reader.Skip((sizeof(uint32) + columnHeader.RecordSize) * static_cast<size_t>(columnHeader.ComponentCount));
+
+			if (!valid)
+			{
+				FLUX_ERROR_CATEGORY("Scene Serializer", "'{0}' contains an invalid component column", path.string());
+				return false;
+			}
+		}
+
+		return ApplySceneData(*scene, data);
+	}
+
+	bool SceneSerializer::SerializeText(Ref<Scene> scene, const std::filesystem::path& path)
+	{
+		SceneData data;
+		GatherSceneData(*scene, data);
+
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+		out << YAML::Key << "Version" << YAML::Value << s_Version;
+		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
+
+		for (uint32 entityIndex = 0; entityIndex < data.EntityCount; entityIndex++)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "GUID" << YAML::Value << data.Guids[entityIndex];
+
+			ForEachColumn(data, [&](const auto& column)
+			{
+				using ColumnType = std::decay_t<decltype(column)>;
+				using ColumnComponent = typename ColumnType::ColumnComponent;
+
+				uint32 recordIndex = FindRecordIndex(column, entityIndex);
+				if (recordIndex == s_InvalidIndex)
+					return;
+
+				out << YAML::Key << Utils::ComponentTypeToString(ColumnComponent::GetStaticType()) << YAML::Value;
+				ComponentRecord<ColumnComponent>::Emit(out, column.Records[recordIndex], data);
+			});
+
+			out << YAML::EndMap;
+		}
+
+		out << YAML::EndSeq;
+		out << YAML::EndMap;
+
+		return FileHelper::SaveStringToFile(out.c_str(), path);
+	}
+
+	bool SceneSerializer::DeserializeText(Ref<Scene> scene, const std::filesystem::path& path)
+	{
+		YAML::Node node;
+		try
+		{
+			node = YAML::LoadFile(path.string());
+		}
+		catch (YAML::Exception e)
+		{
+			FLUX_ERROR_CATEGORY("Scene Serializer", "Failed to load '{0}': {1}", path.string(), e.msg);
+			return false;
+		}
+
+		uint32 version = node["Version"].as<uint32>(0);
+		if (version != s_Version)
+		{
+			FLUX_ERROR_CATEGORY("Scene Serializer", "'{0}' has version {1}, expected version {2}", path.string(), version, s_Version);
+			return false;
+		}
+
+		auto entitiesNode = node["Entities"];
+		if (!entitiesNode.IsSequence())
+			return false;
+
+		SceneData data;
+		data.EntityCount = static_cast<uint32>(entitiesNode.size());
+		data.Guids.reserve(data.EntityCount);
+		data.GuidIndices.reserve(data.EntityCount);
+
+		try
+		{
+			// All entity GUIDs have to be in the table before
+			// relationships can refer to entities further down
+			for (auto entityNode : entitiesNode)
+				data.AddGuid(entityNode["GUID"].as<Guid>());
+
+			if (data.Guids.size() != data.EntityCount)
+			{
+				FLUX_ERROR_CATEGORY("Scene Serializer", "'{0}' contains invalid or duplicate entity GUIDs", path.string());
+				return false;
+			}
+
+			uint32 entityIndex = 0;
+			for (auto entityNode : entitiesNode)
+			{
+				ForEachColumn(data, [&](auto& column)
+				{
+					using ColumnType = std::decay_t<decltype(column)>;
+					using ColumnComponent = typename ColumnType::ColumnComponent;
+
+					auto componentNode = entityNode[Utils::ComponentTypeToString(ColumnComponent::GetStaticType())];
+					if (!componentNode)
+						return;
+
+					column.EntityIndices.push_back(entityIndex);
+					column.Records.push_back(ComponentRecord<ColumnComponent>::Parse(componentNode, data));
+				});
+
+				entityIndex++;
+			}
+		}
+		catch (YAML::Exception e)
+		{
+			FLUX_ERROR_CATEGORY("Scene Serializer", "Failed to parse '{0}': {1}", path.string(), e.msg);
+			return false;
+		}
+
+		return ApplySceneData(*scene, data);
+	}
+
+}
\ No newline at end of file
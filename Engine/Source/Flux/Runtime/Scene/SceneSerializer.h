@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Scene.h"
+
+namespace Flux {
+
+	struct SceneData;
+
+	// Binary scene files store a GUID table, a string table and one column per component type,
+	// with the components of that type written as one contiguous array of records.
+	// The text form contains the same data as YAML, one entity per sequence entry.
+	class SceneSerializer
+	{
+	public:
+		static bool Serialize(Ref<Scene> scene, const std::filesystem::path& path);
+		static bool Deserialize(Ref<Scene> scene, const std::filesystem::path& path);
+
+		static bool SerializeText(Ref<Scene> scene, const std::filesystem::path& path);
+		static bool DeserializeText(Ref<Scene> scene, const std::filesystem::path& path);
+
+		static constexpr uint32 s_Version = 2;
+	private:
+		static void GatherSceneData(Scene& scene, SceneData& data);
+		static bool ApplySceneData(Scene& scene, const SceneData& data);
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "FluxPCH.h"
+#include "SceneSystem.h"
+
+#include "Flux/Runtime/Core/JobSystem.h"
+
+namespace Flux {
+
+	void SceneSystemScheduler::AddSystem(const SceneSystemCreateInfo& createInfo)
+	{
+		FLUX_VERIFY(createInfo.Function);
+
+		auto& system = m_Systems.emplace_back();
+		system.Info = createInfo;
+		system.ProfilerName = Profiler::InternName(createInfo.Name);
+
+		m_BatchesDirty = true;
+	}
+
+	void SceneSystemScheduler::Run(SceneSystemPhase phase, Scene& scene, const SceneSystemContext& context)
+	{
+		if (m_BatchesDirty)
+			BuildBatches();
+
+		for (auto& batch : m_Batches[static_cast<size_t>(phase)])
+		{
+			if (batch.size() == 1)
+			{
+				RunSystem(m_Systems[batch[0]], scene, context);
+				continue;
+			}
+
+			JobCounter counter;
+			for (size_t i = 1; i < batch.size(); i++)
+			{
+				SceneSystem* system = &m_Systems[batch[i]];
+				JobSystem::Execute(counter, [this, system, &scene, &context]()
+				{
+					RunSystem(*system, scene, context);
+				});
+			}
+
+			RunSystem(m_Systems[batch[0]], scene, context);
+			JobSystem::Wait(counter);
+		}
+	}
+
+	void SceneSystemScheduler::BuildBatches()
+	{
+		for (auto& batches : m_Batches)
+			batches.clear();
+
+		// A system is placed in the batch after the last earlier system it conflicts with,
+		// which keeps registration order for every pair that touches the same components.
+		for (uint32 systemIndex = 0; systemIndex < static_cast<uint32>(m_Systems.size()); systemIndex++)
+		{
+			auto& system = m_Systems[systemIndex];
+
+			uint32 batchIndex = 0;
+			for (uint32 otherIndex = 0; otherIndex < systemIndex; otherIndex++)
+			{
+				auto& other = m_Systems[otherIndex];
+				if (other.Info.Phase != system.Info.Phase)
+					continue;
+
+				if (HasConflict(system.Info, other.Info))
+					batchIndex = Math::Max(batchIndex, other.BatchIndex + 1);
+			}
+
+			system.BatchIndex = batchIndex;
+
+			auto& batches = m_Batches[static_cast<size_t>(system.Info.Phase)];
+			if (batches.size() <= batchIndex)
+				batches.resize(batchIndex + 1);
+			batches[batchIndex].push_back(systemIndex);
+		}
+
+		m_BatchesDirty = false;
+	}
+
+	void SceneSystemScheduler::RunSystem(SceneSystem& system, Scene& scene, const SceneSystemContext& context)
+	{
+		FLUX_PROFILE_SCOPE(system.ProfilerName);
+
+		uint64 start = Platform::GetNanoTime();
+		system.Info.Function(scene, context);
+		uint64 end = Platform::GetNanoTime();
+
+		system.LastExecutionTime = float(end - start) * 0.001f * 0.001f;
+	}
+
+	bool SceneSystemScheduler::HasConflict(const SceneSystemCreateInfo& a, const SceneSystemCreateInfo& b)
+	{
+		if (a.Exclusive || b.Exclusive)
+			return true;
+
+		if (a.WriteMask & (b.ReadMask | b.WriteMask))
+			return true;
+
+		if (b.WriteMask & a.ReadMask)
+			return true;
+
+		return false;
+	}
+
+}
\ No newline at end of file
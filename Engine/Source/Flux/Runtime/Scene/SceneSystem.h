@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Component.h"
+
+namespace Flux {
+
+	class Scene;
+
+	enum class SceneSystemPhase : uint8
+	{
+		Update = 0,
+		FixedUpdate,
+		Render,
+		ViewportResize,
+
+		Count
+	};
+
+	namespace Utils {
+
+		inline const char* SceneSystemPhaseToString(SceneSystemPhase phase)
+		{
+			switch (phase)
+			{
+			case SceneSystemPhase::Update: return "Update";
+			case SceneSystemPhase::FixedUpdate: return "FixedUpdate";
+			case SceneSystemPhase::Render: return "Render";
+			case SceneSystemPhase::ViewportResize: return "ViewportResize";
+			}
+			FLUX_VERIFY(false, "Unknown scene system phase!");
+			return "";
+		}
+
+	}
+
+	struct SceneSystemContext
+	{
+		Ref<RenderPipeline> Pipeline;
+		uint32 ViewportWidth = 0;
+		uint32 ViewportHeight = 0;
+	};
+
+	using SceneSystemFunction = std::function<void(Scene&, const SceneSystemContext&)>;
+
+	struct SceneSystemCreateInfo
+	{
+		std::string Name = "System";
+		SceneSystemPhase Phase = SceneSystemPhase::Update;
+
+		ComponentMask ReadMask = 0;
+		ComponentMask WriteMask = 0;
+
+		// Exclusive systems run on the calling thread and never alongside other systems
+		bool Exclusive = false;
+
+		SceneSystemFunction Function;
+	};
+
+	struct SceneSystem
+	{
+		SceneSystemCreateInfo Info;
+		// Interned copy of the name for profiler scopes
+		const char* ProfilerName = nullptr;
+		uint32 BatchIndex = 0;
+		float LastExecutionTime = 0.0f;
+	};
+
+	class SceneSystemScheduler
+	{
+	public:
+		void AddSystem(const SceneSystemCreateInfo& createInfo);
+		void Run(SceneSystemPhase phase, Scene& scene, const SceneSystemContext& context);
+
+		const std::vector<SceneSystem>& GetSystems() const { return m_Systems; }
+	private:
+		void BuildBatches();
+		void RunSystem(SceneSystem& system, Scene& scene, const SceneSystemContext& context);
+
+		static bool HasConflict(const SceneSystemCreateInfo& a, const SceneSystemCreateInfo& b);
+	private:
+		std::vector<SceneSystem> m_Systems;
+
+		// System indices grouped into batches of independent systems, per phase
+		std::vector<std::vector<uint32>> m_Batches[static_cast<size_t>(SceneSystemPhase::Count)];
+		bool m_BatchesDirty = true;
+	};
+
+}
\ No newline at end of file
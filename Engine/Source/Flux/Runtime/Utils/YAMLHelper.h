@@ -0,0 +1,192 @@
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+
+namespace YAML {
+
+	template<>
+	struct convert<Flux::Vector2>
+	{
+		static Node encode(const Flux::Vector2& rhs)
+		{
+			Node node;
+			node.push_back(rhs.X);
+			node.push_back(rhs.Y);
+			node.SetStyle(EmitterStyle::Flow);
+			return node;
+		}
+
+		static bool decode(const Node& node, Flux::Vector2& rhs)
+		{
+			if (!node.IsSequence() || node.size() != 2)
+				return false;
+
+			rhs.X = node[0].as<float>();
+			rhs.Y = node[1].as<float>();
+			return true;
+		}
+	};
+
+	inline Emitter& operator<<(Emitter& out, const Flux::Vector2& v)
+	{
+		out << Flow;
+		out << BeginSeq << v.X << v.Y << EndSeq;
+		return out;
+	}
+
+	template<>
+	struct convert<Flux::Vector3>
+	{
+		static Node encode(const Flux::Vector3& rhs)
+		{
+			Node node;
+			node.push_back(rhs.X);
+			node.push_back(rhs.Y);
+			node.push_back(rhs.Z);
+			node.SetStyle(EmitterStyle::Flow);
+			return node;
+		}
+
+		static bool decode(const Node& node, Flux::Vector3& rhs)
+		{
+			if (!node.IsSequence() || node.size() != 3)
+				return false;
+
+			rhs.X = node[0].as<float>();
+			rhs.Y = node[1].as<float>();
+			rhs.Z = node[2].as<float>();
+			return true;
+		}
+	};
+
+	inline Emitter& operator<<(Emitter& out, const Flux::Vector3& v)
+	{
+		out << Flow;
+		out << BeginSeq << v.X << v.Y << v.Z << EndSeq;
+		return out;
+	}
+
+	template<>
+	struct convert<Flux::Vector4>
+	{
+		static Node encode(const Flux::Vector4& rhs)
+		{
+			Node node;
+			node.push_back(rhs.X);
+			node.push_back(rhs.Y);
+			node.push_back(rhs.Z);
+			node.push_back(rhs.W);
+			node.SetStyle(EmitterStyle::Flow);
+			return node;
+		}
+
+		static bool decode(const Node& node, Flux::Vector4& rhs)
+		{
+			if (!node.IsSequence() || node.size() != 4)
+				return false;
+
+			rhs.X = node[0].as<float>();
+			rhs.Y = node[1].as<float>();
+			rhs.Z = node[2].as<float>();
+			rhs.W = node[3].as<float>();
+			return true;
+		}
+	};
+
+	inline Emitter& operator<<(Emitter& out, const Flux::Vector4& v)
+	{
+		out << Flow;
+		out << BeginSeq << v.X << v.Y << v.Z << v.W << EndSeq;
+		return out;
+	}
+
+	template<>
+	struct convert<Flux::Quaternion>
+	{
+		static Node encode(const Flux::Quaternion& rhs)
+		{
+			Node node;
+			node.push_back(rhs.X);
+			node.push_back(rhs.Y);
+			node.push_back(rhs.Z);
+			node.push_back(rhs.W);
+			node.SetStyle(EmitterStyle::Flow);
+			return node;
+		}
+
+		static bool decode(const Node& node, Flux::Quaternion& rhs)
+		{
+			if (!node.IsSequence() || node.size() != 4)
+				return false;
+
+			rhs.X = node[0].as<float>();
+			rhs.Y = node[1].as<float>();
+			rhs.Z = node[2].as<float>();
+			rhs.W = node[3].as<float>();
+			return true;
+		}
+	};
+
+	inline Emitter& operator<<(Emitter& out, const Flux::Quaternion& v)
+	{
+		out << Flow;
+		out << BeginSeq << v.X << v.Y << v.Z << v.W << EndSeq;
+		return out;
+	}
+
+	template<>
+	struct convert<Flux::IntRect>
+	{
+		static Node encode(const Flux::IntRect& rhs)
+		{
+			Node node;
+			node.push_back(rhs.MinX);
+			node.push_back(rhs.MinY);
+			node.push_back(rhs.MaxX);
+			node.push_back(rhs.MaxY);
+			node.SetStyle(EmitterStyle::Flow);
+			return node;
+		}
+
+		static bool decode(const Node& node, Flux::IntRect& rhs)
+		{
+			if (!node.IsSequence() || node.size() != 4)
+				return false;
+
+			rhs.MinX = node[0].as<int32>();
+			rhs.MinY = node[1].as<int32>();
+			rhs.MaxX = node[2].as<int32>();
+			rhs.MaxY = node[3].as<int32>();
+			return true;
+		}
+	};
+
+	inline Emitter& operator<<(Emitter& out, const Flux::IntRect& v)
+	{
+		out << Flow;
+		out << BeginSeq << v.MinX << v.MinY << v.MaxX << v.MaxY << EndSeq;
+		return out;
+	}
+
+	template<>
+	struct convert<Flux::Guid>
+	{
+		static Node encode(const Flux::Guid& rhs)
+		{
+			return Node(rhs.ToString());
+		}
+
+		static bool decode(const Node& node, Flux::Guid& rhs)
+		{
+			Flux::Guid::Parse(node.as<std::string>(), rhs);
+			return true;
+		}
+	};
+
+	inline Emitter& operator<<(Emitter& out, const Flux::Guid& v)
+	{
+		out << v.ToString();
+		return out;
+	}
+
+}
\ No newline at end of file
@@ -25,10 +25,15 @@
 #include <initializer_list>
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <functional>
 #include <fstream>
 #include <filesystem>
 #include <mutex>
+#include <thread>
+#include <optional>
+#include <atomic>
+#include <bit>
 
 #include "Flux/Runtime/Core/Core.h"
\ No newline at end of file
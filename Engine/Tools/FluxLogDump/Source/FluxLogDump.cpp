@@ -0,0 +1,542 @@
+// Decodes binary logs (Logs/Latest.flog) written by the engine with LoggerCreateInfo::BinaryLog
+
+#include "Flux/Runtime/Core/Logging/BinaryLogFormat.h"
+
+#include <spdlog/fmt/fmt.h>
+#ifdef SPDLOG_FMT_EXTERNAL
+	#include <fmt/args.h>
+#else
+	#include <spdlog/fmt/bundled/args.h>
+#endif
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Flux {
+
+	struct LogDumpOptions
+	{
+		std::string InputPath;
+		std::string OutputPath;
+		bool JSON = false;
+
+		std::vector<std::string> Categories;
+		std::vector<std::string> Threads;
+
+		// Seconds since the start of the log
+		std::optional<double> From;
+		std::optional<double> To;
+
+		uint8 MinVerbosity = 0;
+	};
+
+	struct LogDumpSite
+	{
+		std::string Category;
+		std::string Format;
+		std::vector<LogArgumentType> ArgumentTypes;
+	};
+
+	namespace Utils {
+
+		static void PrintUsage()
+		{
+			std::cerr <<
+				"Usage: fluxlogdump <file.flog> [options]\n"
+				"  --json               Write one JSON object per message\n"
+				"  --output <file>      Write to a file instead of stdout\n"
+				"  --category <name>    Only messages of this category, can be repeated\n"
+				"  --thread <id|name>   Only messages of this thread, can be repeated\n"
+				"  --from <seconds>     Only messages logged after this time, relative to the start of the log\n"
+				"  --to <seconds>       Only messages logged before this time, relative to the start of the log\n"
+				"  --verbosity <name>   Minimum verbosity (Trace, Debug, Info, Warning, Error, Critical)\n";
+		}
+
+		static std::optional<uint8> ParseVerbosity(std::string_view name)
+		{
+			for (uint8 i = 0; i < std::size(s_BinaryLogVerbosityNames); i++)
+			{
+				std::string_view verbosityName = s_BinaryLogVerbosityNames[i];
+				if (verbosityName.size() != name.size())
+					continue;
+
+				bool equal = true;
+				for (size_t j = 0; j < name.size(); j++)
+					equal &= std::tolower(static_cast<unsigned char>(name[j])) == std::tolower(static_cast<unsigned char>(verbosityName[j]));
+
+				if (equal)
+					return i;
+			}
+			return {};
+		}
+
+		static bool ParseArguments(int argc, char** argv, LogDumpOptions& options)
+		{
+			for (int i = 1; i < argc; i++)
+			{
+				std::string_view argument = argv[i];
+
+				auto nextValue = [&]() -> const char*
+				{
+					if (i + 1 >= argc)
+					{
+						std::cerr << fmt::format("Missing value for '{0}'\n", argument);
+						return nullptr;
+					}
+					return argv[++i];
+				};
+
+				if (argument == "--json")
+				{
+					options.JSON = true;
+				}
+				else if (argument == "--output" || argument == "--category" || argument == "--thread" || argument == "--from" || argument == "--to" || argument == "--verbosity")
+				{
+					const char* value = nextValue();
+					if (!value)
+						return false;
+
+					if (argument == "--output")
+						options.OutputPath = value;
+					else if (argument == "--category")
+						options.Categories.push_back(value);
+					else if (argument == "--thread")
+						options.Threads.push_back(value);
+					else if (argument == "--from")
+						options.From = std::atof(value);
+					else if (argument == "--to")
+						options.To = std::atof(value);
+					else if (auto verbosity = ParseVerbosity(value))
+						options.MinVerbosity = *verbosity;
+					else
+					{
+						std::cerr << fmt::format("Unknown verbosity '{0}'\n", value);
+						return false;
+					}
+				}
+				else if (argument == "--help" || argument == "-h")
+				{
+					return false;
+				}
+				else if (!argument.empty() && argument[0] != '-' && options.InputPath.empty())
+				{
+					options.InputPath = argument;
+				}
+				else
+				{
+					std::cerr << fmt::format("Unknown argument '{0}'\n", argument);
+					return false;
+				}
+			}
+
+			return !options.InputPath.empty();
+		}
+
+		static std::string EscapeJSONString(std::string_view string)
+		{
+			std::string result;
+			result.reserve(string.size());
+
+			for (char c : string)
+			{
+				switch (c)
+				{
+				case '"':  result += "\\\""; break;
+				case '\\': result += "\\\\"; break;
+				case '\n': result += "\\n"; break;
+				case '\r': result += "\\r"; break;
+				case '\t': result += "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+						result += fmt::format("\\u{0:04x}", static_cast<uint32>(c));
+					else
+						result += c;
+					break;
+				}
+			}
+
+			return result;
+		}
+
+		// Same as [%T] in the text log, with milliseconds
+		static std::string FormatLocalTime(int64 time)
+		{
+			std::time_t seconds = static_cast<std::time_t>(time / 1000000000);
+			int64 milliseconds = (time / 1000000) % 1000;
+
+			std::tm localTime = {};
+#ifdef _WIN32
+			localtime_s(&localTime, &seconds);
+#else
+			localtime_r(&seconds, &localTime);
+#endif
+
+			return fmt::format("{0:02}:{1:02}:{2:02}.{3:03}", localTime.tm_hour, localTime.tm_min, localTime.tm_sec, milliseconds);
+		}
+
+		template<typename T>
+		static T ReadValue(const uint8*& data)
+		{
+			T value;
+			memcpy(&value, data, sizeof(T));
+			data += sizeof(T);
+			return value;
+		}
+
+		// Returns false if the arguments don't match the types of the site
+		static bool PushArguments(const LogDumpSite& site, const uint8* data, const uint8* end, fmt::dynamic_format_arg_store<fmt::format_context>& store)
+		{
+			static constexpr uint32 s_ArgumentSizes[] = { 1, 1, 1, 2, 4, 8, 1, 2, 4, 8, 4, 8, 8 };
+
+			for (LogArgumentType type : site.ArgumentTypes)
+			{
+				if (type == LogArgumentType::String || type == LogArgumentType::Custom)
+				{
+					if (static_cast<uint64>(end - data) < sizeof(uint32))
+						return false;
+
+					uint32 size = ReadValue<uint32>(data);
+					if (static_cast<uint64>(end - data) < size)
+						return false;
+
+					store.push_back(fmt::string_view(reinterpret_cast<const char*>(data), size));
+					data += size;
+					continue;
+				}
+
+				if (static_cast<uint8>(type) >= std::size(s_ArgumentSizes) || static_cast<uint64>(end - data) < s_ArgumentSizes[static_cast<uint8>(type)])
+					return false;
+
+				switch (type)
+				{
+				case LogArgumentType::Bool:    store.push_back(ReadValue<uint8>(data) != 0); break;
+				case LogArgumentType::Char:    store.push_back(ReadValue<char>(data)); break;
+				case LogArgumentType::Int8:    store.push_back(ReadValue<int8>(data)); break;
+				case LogArgumentType::Int16:   store.push_back(ReadValue<int16>(data)); break;
+				case LogArgumentType::Int32:   store.push_back(ReadValue<int32>(data)); break;
+				case LogArgumentType::Int64:   store.push_back(ReadValue<int64>(data)); break;
+				case LogArgumentType::UInt8:   store.push_back(ReadValue<uint8>(data)); break;
+				case LogArgumentType::UInt16:  store.push_back(ReadValue<uint16>(data)); break;
+				case LogArgumentType::UInt32:  store.push_back(ReadValue<uint32>(data)); break;
+				case LogArgumentType::UInt64:  store.push_back(ReadValue<uint64>(data)); break;
+				case LogArgumentType::Float:   store.push_back(ReadValue<float>(data)); break;
+				case LogArgumentType::Double:  store.push_back(ReadValue<double>(data)); break;
+				case LogArgumentType::Pointer: store.push_back(reinterpret_cast<const void*>(static_cast<uintptr>(ReadValue<uint64>(data)))); break;
+				default: return false;
+				}
+			}
+
+			return data == end;
+		}
+
+	}
+
+	class LogDump
+	{
+	public:
+		LogDump(const LogDumpOptions& options, std::ostream& output)
+			: m_Options(options), m_Output(output)
+		{
+		}
+
+		bool Run()
+		{
+			std::ifstream stream(m_Options.InputPath, std::ios::in | std::ios::binary);
+			if (!stream)
+			{
+				std::cerr << fmt::format("Failed to open '{0}'\n", m_Options.InputPath);
+				return false;
+			}
+
+			stream.seekg(0, std::ios::end);
+			m_FileSize = static_cast<uint64>(stream.tellg());
+			stream.seekg(0, std::ios::beg);
+
+			BinaryLogHeader header;
+			if (!Read(stream, &header, sizeof(BinaryLogHeader)) || header.Magic != s_BinaryLogMagic)
+			{
+				std::cerr << fmt::format("'{0}' is not a binary log\n", m_Options.InputPath);
+				return false;
+			}
+
+			if (header.Version != s_BinaryLogVersion)
+			{
+				std::cerr << fmt::format("Unsupported binary log version {0} (expected {1})\n", header.Version, s_BinaryLogVersion);
+				return false;
+			}
+
+			m_StartTime = header.StartTime;
+
+			uint8 type;
+			while (Read(stream, &type, sizeof(uint8)))
+			{
+				bool result = false;
+				switch (static_cast<BinaryLogEntryType>(type))
+				{
+				case BinaryLogEntryType::Site:            result = ReadSite(stream); break;
+				case BinaryLogEntryType::Thread:          result = ReadThread(stream); break;
+				case BinaryLogEntryType::Message:         result = ReadMessage(stream); break;
+				case BinaryLogEntryType::DroppedMessages: result = ReadDroppedMessages(stream); break;
+				default:
+					std::cerr << fmt::format("Unknown entry type {0}, stopping\n", type);
+					return false;
+				}
+
+				// The engine may have been killed while writing
+				if (!result)
+				{
+					std::cerr << "The log is truncated\n";
+					break;
+				}
+			}
+
+			std::cerr << fmt::format("{0} of {1} messages written\n", m_WrittenMessages, m_TotalMessages);
+			return true;
+		}
+	private:
+		static bool Read(std::istream& stream, void* data, size_t size)
+		{
+			return size == 0 || static_cast<bool>(stream.read(static_cast<char*>(data), size));
+		}
+
+		// Sizes read from the log are checked against the rest of the file before anything is resized,
+		// a larger size is treated like a truncated log
+		bool CanRead(std::istream& stream, uint64 size) const
+		{
+			std::streamoff position = stream.tellg();
+			return position >= 0 && size <= m_FileSize - static_cast<uint64>(position);
+		}
+
+		bool ReadString(std::istream& stream, std::string& string, size_t size)
+		{
+			if (!CanRead(stream, size))
+				return false;
+
+			string.resize(size);
+			return Read(stream, string.data(), size);
+		}
+
+		bool ReadSite(std::istream& stream)
+		{
+			BinaryLogSite entry;
+			if (!Read(stream, &entry, sizeof(BinaryLogSite)))
+				return false;
+
+			if (!CanRead(stream, entry.ArgumentCount * sizeof(LogArgumentType)))
+				return false;
+
+			LogDumpSite& site = m_Sites[entry.SiteID];
+			site.ArgumentTypes.resize(entry.ArgumentCount);
+
+			return ReadString(stream, site.Category, entry.CategorySize)
+				&& ReadString(stream, site.Format, entry.FormatSize)
+				&& Read(stream, site.ArgumentTypes.data(), entry.ArgumentCount);
+		}
+
+		bool ReadThread(std::istream& stream)
+		{
+			BinaryLogThread entry;
+			if (!Read(stream, &entry, sizeof(BinaryLogThread)))
+				return false;
+
+			return ReadString(stream, m_Threads[entry.ThreadID], entry.NameSize);
+		}
+
+		bool ReadMessage(std::istream& stream)
+		{
+			BinaryLogMessage entry;
+			if (!Read(stream, &entry, sizeof(BinaryLogMessage)))
+				return false;
+
+			if (!CanRead(stream, entry.ArgumentsSize))
+				return false;
+
+			m_Arguments.resize(entry.ArgumentsSize);
+			if (!Read(stream, m_Arguments.data(), entry.ArgumentsSize))
+				return false;
+
+			m_TotalMessages++;
+
+			auto siteIt = m_Sites.find(entry.SiteID);
+			if (siteIt == m_Sites.end())
+			{
+				std::cerr << fmt::format("Message references unknown site {0}\n", entry.SiteID);
+				return true;
+			}
+
+			const LogDumpSite& site = siteIt->second;
+			std::string_view threadName = GetThreadName(entry.ThreadID);
+
+			if (!IsIncluded(entry.Time, entry.Verbosity, site.Category, entry.ThreadID, threadName))
+				return true;
+
+			m_Text.clear();
+			fmt::dynamic_format_arg_store<fmt::format_context> store;
+			if (Utils::PushArguments(site, m_Arguments.data(), m_Arguments.data() + m_Arguments.size(), store))
+			{
+				try
+				{
+					fmt::vformat_to(std::back_inserter(m_Text), site.Format, store);
+				}
+				catch (const fmt::format_error& error)
+				{
+					m_Text.clear();
+					fmt::format_to(std::back_inserter(m_Text), "Failed to format '{0}': {1}", site.Format, error.what());
+				}
+			}
+			else
+			{
+				fmt::format_to(std::back_inserter(m_Text), "Failed to decode the arguments of '{0}'", site.Format);
+			}
+
+			WriteMessage(entry.Time, entry.Verbosity, site.Category, entry.ThreadID, threadName, std::string_view(m_Text.data(), m_Text.size()));
+			return true;
+		}
+
+		bool ReadDroppedMessages(std::istream& stream)
+		{
+			BinaryLogDroppedMessages entry;
+			if (!Read(stream, &entry, sizeof(BinaryLogDroppedMessages)))
+				return false;
+
+			m_TotalMessages++;
+
+			// Dropped messages are not attributed to a thread or category, only the time range applies
+			if (!IsInTimeRange(entry.Time) || !m_Options.Categories.empty() || !m_Options.Threads.empty())
+				return true;
+
+			WriteMessage(entry.Time, 3, "Logger", 0, "Logger Thread", fmt::format("{0} messages were dropped", entry.Count));
+			return true;
+		}
+
+		std::string_view GetThreadName(uint32 threadID) const
+		{
+			auto it = m_Threads.find(threadID);
+			return it != m_Threads.end() ? std::string_view(it->second) : std::string_view();
+		}
+
+		bool IsInTimeRange(int64 time) const
+		{
+			double seconds = double(time - m_StartTime) * 0.001 * 0.001 * 0.001;
+			if (m_Options.From && seconds < *m_Options.From)
+				return false;
+			if (m_Options.To && seconds > *m_Options.To)
+				return false;
+			return true;
+		}
+
+		bool IsIncluded(int64 time, uint8 verbosity, std::string_view category, uint32 threadID, std::string_view threadName) const
+		{
+			if (verbosity < m_Options.MinVerbosity || !IsInTimeRange(time))
+				return false;
+
+			if (!m_Options.Categories.empty())
+			{
+				bool found = false;
+				for (auto& filter : m_Options.Categories)
+					found |= filter == category;
+
+				if (!found)
+					return false;
+			}
+
+			if (!m_Options.Threads.empty())
+			{
+				std::string threadIDString = std::to_string(threadID);
+
+				bool found = false;
+				for (auto& filter : m_Options.Threads)
+					found |= filter == threadName || filter == threadIDString;
+
+				if (!found)
+					return false;
+			}
+
+			return true;
+		}
+
+		void WriteMessage(int64 time, uint8 verbosity, std::string_view category, uint32 threadID, std::string_view threadName, std::string_view text)
+		{
+			const char* verbosityName = verbosity < std::size(s_BinaryLogVerbosityNames) ? s_BinaryLogVerbosityNames[verbosity] : "Unknown";
+
+			m_Line.clear();
+			if (m_Options.JSON)
+			{
+				fmt::format_to(std::back_inserter(m_Line), "{{\"time\":{0:.6f},\"timestamp\":{1},\"verbosity\":\"{2}\",\"category\":\"{3}\",\"threadID\":{4},\"thread\":\"{5}\",\"message\":\"{6}\"}}\n",
+					double(time - m_StartTime) * 0.001 * 0.001 * 0.001,
+					time,
+					verbosityName,
+					Utils::EscapeJSONString(category),
+					threadID,
+					Utils::EscapeJSONString(threadName),
+					Utils::EscapeJSONString(text)
+				);
+			}
+			else
+			{
+				fmt::format_to(std::back_inserter(m_Line), "[{0}] [{1}] [{2}] ", Utils::FormatLocalTime(time), threadName.empty() ? std::to_string(threadID) : std::string(threadName), verbosityName);
+				if (!category.empty())
+					fmt::format_to(std::back_inserter(m_Line), "[{0}] ", category);
+				fmt::format_to(std::back_inserter(m_Line), "{0}\n", text);
+			}
+
+			m_Output.write(m_Line.data(), m_Line.size());
+			m_WrittenMessages++;
+		}
+	private:
+		const LogDumpOptions& m_Options;
+		std::ostream& m_Output;
+
+		int64 m_StartTime = 0;
+		uint64 m_FileSize = 0;
+
+		std::unordered_map<uint32, LogDumpSite> m_Sites;
+		std::unordered_map<uint32, std::string> m_Threads;
+
+		std::vector<uint8> m_Arguments;
+		fmt::memory_buffer m_Text;
+		fmt::memory_buffer m_Line;
+
+		uint64 m_TotalMessages = 0;
+		uint64 m_WrittenMessages = 0;
+	};
+
+}
+
+int main(int argc, char** argv)
+{
+	using namespace Flux;
+
+	LogDumpOptions options;
+	if (!Utils::ParseArguments(argc, argv, options))
+	{
+		Utils::PrintUsage();
+		return 1;
+	}
+
+	std::ofstream file;
+	if (!options.OutputPath.empty())
+	{
+		file.open(options.OutputPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			std::cerr << fmt::format("Failed to open '{0}'\n", options.OutputPath);
+			return 1;
+		}
+	}
+
+	std::ostream& output = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+	std::ios::sync_with_stdio(false);
+
+	LogDump dump(options, output);
+	return dump.Run() ? 0 : 1;
+}
\ No newline at end of file
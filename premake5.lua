@@ -9,6 +9,12 @@ workspace "FluxEngine"
 
 VulkanSDK = os.getenv("VULKAN_SDK")
 
+newoption
+{
+    trigger = "math-debug",
+    description = "Count math function calls in Release builds"
+}
+
 project "FluxEngine"
     language "C++"
     cppdialect "C++latest"
@@ -65,6 +71,7 @@ project "FluxEngine"
             "opengl32.lib",
             "Gdi32.lib",
             "glu32.lib",
+            "Dbghelp.lib",
 
             "d3d11.lib",
             "d3d12.lib",
@@ -140,6 +147,9 @@ project "FluxEngine"
             }
         end
 
+    filter { "configurations:Release", "options:math-debug" }
+        defines "FLUX_MATH_DEBUG_ENABLED"
+
     filter "configurations:Shipping"
         kind "WindowedApp"
         defines { "FLUX_BUILD_SHIPPING", "NDEBUG" }
@@ -170,6 +180,42 @@ project "FluxEngine"
             }
         end
 
+project "FluxLogDump"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++latest"
+    location "Engine/Tools/FluxLogDump"
+    staticruntime "Off"
+    targetname "fluxlogdump"
+
+    files
+    {
+        "Engine/Tools/FluxLogDump/Source/**.cpp",
+        "Engine/Tools/FluxLogDump/Source/**.h"
+    }
+
+    includedirs
+    {
+        "Engine/Source",
+        "Engine/Libraries/spdlog/include"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "configurations:Debug"
+        runtime "Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        runtime "Release"
+        optimize "On"
+
+    filter "configurations:Shipping"
+        runtime "Release"
+        optimize "On"
+        symbols "Off"
+
 group "Libraries"
     include "Engine/Libraries/glad"
     include "Engine/Libraries/ImGui"